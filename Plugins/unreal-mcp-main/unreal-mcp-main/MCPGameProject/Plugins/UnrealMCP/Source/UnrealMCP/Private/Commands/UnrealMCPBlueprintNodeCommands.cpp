@@ -1,5 +1,8 @@
 #include "Commands/UnrealMCPBlueprintNodeCommands.h"
 #include "Commands/UnrealMCPCommonUtils.h"
+#include "MCPBlueprintCompileQueue.h"
+#include "MCPCommandRegistry.h"
+#include "MCPLog.h"
 #include "Engine/Blueprint.h"
 #include "Engine/BlueprintGeneratedClass.h"
 #include "EdGraph/EdGraph.h"
@@ -17,49 +20,64 @@
 #include "Kismet/GameplayStatics.h"
 #include "EdGraphSchema_K2.h"
 
-// Declare the log category
-DEFINE_LOG_CATEGORY_STATIC(LogUnrealMCP, Log, All);
-
 FUnrealMCPBlueprintNodeCommands::FUnrealMCPBlueprintNodeCommands()
 {
 }
 
-TSharedPtr<FJsonObject> FUnrealMCPBlueprintNodeCommands::HandleCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params)
+void FUnrealMCPBlueprintNodeCommands::RegisterCommands(FMCPCommandRegistry& Registry, FName Owner)
 {
-    if (CommandType == TEXT("connect_blueprint_nodes"))
-    {
-        return HandleConnectBlueprintNodes(Params);
-    }
-    else if (CommandType == TEXT("add_blueprint_get_self_component_reference"))
-    {
-        return HandleAddBlueprintGetSelfComponentReference(Params);
-    }
-    else if (CommandType == TEXT("add_blueprint_event_node"))
-    {
-        return HandleAddBlueprintEvent(Params);
-    }
-    else if (CommandType == TEXT("add_blueprint_function_node"))
-    {
-        return HandleAddBlueprintFunctionCall(Params);
-    }
-    else if (CommandType == TEXT("add_blueprint_variable"))
-    {
-        return HandleAddBlueprintVariable(Params);
-    }
-    else if (CommandType == TEXT("add_blueprint_input_action_node"))
-    {
-        return HandleAddBlueprintInputActionNode(Params);
-    }
-    else if (CommandType == TEXT("add_blueprint_self_reference"))
-    {
-        return HandleAddBlueprintSelfReference(Params);
-    }
-    else if (CommandType == TEXT("find_blueprint_nodes"))
-    {
-        return HandleFindBlueprintNodes(Params);
-    }
-    
-    return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Unknown blueprint node command: %s"), *CommandType));
+    Registry.Register(Owner, FMCPCommandInfo(TEXT("connect_blueprint_nodes"), TEXT("Connect two pins in a Blueprint event graph"),
+        FMCPCommandHandler::CreateRaw(this, &FUnrealMCPBlueprintNodeCommands::HandleConnectBlueprintNodes))
+        .Param(TEXT("blueprint_name"), TEXT("string"), true)
+        .Param(TEXT("source_node_id"), TEXT("string"), true)
+        .Param(TEXT("target_node_id"), TEXT("string"), true)
+        .Param(TEXT("source_pin"), TEXT("string"), true)
+        .Param(TEXT("target_pin"), TEXT("string"), true));
+
+    Registry.Register(Owner, FMCPCommandInfo(TEXT("add_blueprint_get_self_component_reference"), TEXT("Add a node that reads one of the Blueprint's own components"),
+        FMCPCommandHandler::CreateRaw(this, &FUnrealMCPBlueprintNodeCommands::HandleAddBlueprintGetSelfComponentReference))
+        .Param(TEXT("blueprint_name"), TEXT("string"), true)
+        .Param(TEXT("component_name"), TEXT("string"), true)
+        .Param(TEXT("node_position"), TEXT("vector")));
+
+    Registry.Register(Owner, FMCPCommandInfo(TEXT("add_blueprint_event_node"), TEXT("Add an event node to a Blueprint"),
+        FMCPCommandHandler::CreateRaw(this, &FUnrealMCPBlueprintNodeCommands::HandleAddBlueprintEvent))
+        .Param(TEXT("blueprint_name"), TEXT("string"), true)
+        .Param(TEXT("event_name"), TEXT("string"), true)
+        .Param(TEXT("node_position"), TEXT("vector")));
+
+    Registry.Register(Owner, FMCPCommandInfo(TEXT("add_blueprint_function_node"), TEXT("Add a function call node to a Blueprint"),
+        FMCPCommandHandler::CreateRaw(this, &FUnrealMCPBlueprintNodeCommands::HandleAddBlueprintFunctionCall))
+        .Param(TEXT("blueprint_name"), TEXT("string"), true)
+        .Param(TEXT("function_name"), TEXT("string"), true)
+        .Param(TEXT("target"), TEXT("string"))
+        .Param(TEXT("params"), TEXT("object"))
+        .Param(TEXT("node_position"), TEXT("vector")));
+
+    Registry.Register(Owner, FMCPCommandInfo(TEXT("add_blueprint_variable"), TEXT("Add a member variable to a Blueprint"),
+        FMCPCommandHandler::CreateRaw(this, &FUnrealMCPBlueprintNodeCommands::HandleAddBlueprintVariable))
+        .Param(TEXT("blueprint_name"), TEXT("string"), true)
+        .Param(TEXT("variable_name"), TEXT("string"), true)
+        .Param(TEXT("variable_type"), TEXT("string"), true)
+        .Param(TEXT("is_exposed"), TEXT("boolean")));
+
+    Registry.Register(Owner, FMCPCommandInfo(TEXT("add_blueprint_input_action_node"), TEXT("Add an input action event node to a Blueprint"),
+        FMCPCommandHandler::CreateRaw(this, &FUnrealMCPBlueprintNodeCommands::HandleAddBlueprintInputActionNode))
+        .Param(TEXT("blueprint_name"), TEXT("string"), true)
+        .Param(TEXT("action_name"), TEXT("string"), true)
+        .Param(TEXT("node_position"), TEXT("vector")));
+
+    Registry.Register(Owner, FMCPCommandInfo(TEXT("add_blueprint_self_reference"), TEXT("Add a self reference node to a Blueprint"),
+        FMCPCommandHandler::CreateRaw(this, &FUnrealMCPBlueprintNodeCommands::HandleAddBlueprintSelfReference))
+        .Param(TEXT("blueprint_name"), TEXT("string"), true)
+        .Param(TEXT("node_position"), TEXT("vector")));
+
+    Registry.Register(Owner, FMCPCommandInfo(TEXT("find_blueprint_nodes"), TEXT("Find nodes in a Blueprint event graph"),
+        FMCPCommandHandler::CreateRaw(this, &FUnrealMCPBlueprintNodeCommands::HandleFindBlueprintNodes))
+        .Param(TEXT("blueprint_name"), TEXT("string"), true)
+        .Param(TEXT("node_type"), TEXT("string"), true)
+        .Param(TEXT("event_name"), TEXT("string"))
+        .ReadOnly());
 }
 
 TSharedPtr<FJsonObject> FUnrealMCPBlueprintNodeCommands::HandleConnectBlueprintNodes(const TSharedPtr<FJsonObject>& Params)
@@ -134,6 +152,7 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintNodeCommands::HandleConnectBlueprintN
     {
         // Mark the blueprint as modified
         FBlueprintEditorUtils::MarkBlueprintAsModified(Blueprint);
+        FMCPBlueprintCompileQueue::Get().MarkDirty(Blueprint);
 
         TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
         ResultObj->SetStringField(TEXT("source_node_id"), SourceNodeId);
@@ -208,6 +227,7 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintNodeCommands::HandleAddBlueprintGetSe
     
     // Mark the blueprint as modified
     FBlueprintEditorUtils::MarkBlueprintAsModified(Blueprint);
+    FMCPBlueprintCompileQueue::Get().MarkDirty(Blueprint);
 
     TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
     ResultObj->SetStringField(TEXT("node_id"), GetComponentNode->NodeGuid.ToString());
@@ -259,6 +279,7 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintNodeCommands::HandleAddBlueprintEvent
 
     // Mark the blueprint as modified
     FBlueprintEditorUtils::MarkBlueprintAsModified(Blueprint);
+    FMCPBlueprintCompileQueue::Get().MarkDirty(Blueprint);
 
     TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
     ResultObj->SetStringField(TEXT("node_id"), EventNode->NodeGuid.ToString());
@@ -310,7 +331,7 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintNodeCommands::HandleAddBlueprintFunct
     UK2Node_CallFunction* FunctionNode = nullptr;
     
     // Add extensive logging for debugging
-    UE_LOG(LogTemp, Display, TEXT("Looking for function '%s' in target '%s'"), 
+    UE_LOG(LogUnrealMCP, Display, TEXT("Looking for function '%s' in target '%s'"), 
            *FunctionName, Target.IsEmpty() ? TEXT("Blueprint") : *Target);
     
     // Check if we have a target class specified
@@ -321,7 +342,7 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintNodeCommands::HandleAddBlueprintFunct
         
         // First try without a prefix
         TargetClass = FindObject<UClass>(ANY_PACKAGE, *Target);
-        UE_LOG(LogTemp, Display, TEXT("Tried to find class '%s': %s"), 
+        UE_LOG(LogUnrealMCP, Display, TEXT("Tried to find class '%s': %s"), 
                *Target, TargetClass ? TEXT("Found") : TEXT("Not found"));
         
         // If not found, try with U prefix (common convention for UE classes)
@@ -329,7 +350,7 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintNodeCommands::HandleAddBlueprintFunct
         {
             FString TargetWithPrefix = FString(TEXT("U")) + Target;
             TargetClass = FindObject<UClass>(ANY_PACKAGE, *TargetWithPrefix);
-            UE_LOG(LogTemp, Display, TEXT("Tried to find class '%s': %s"), 
+            UE_LOG(LogUnrealMCP, Display, TEXT("Tried to find class '%s': %s"), 
                    *TargetWithPrefix, TargetClass ? TEXT("Found") : TEXT("Not found"));
         }
         
@@ -346,7 +367,7 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintNodeCommands::HandleAddBlueprintFunct
                 TargetClass = FindObject<UClass>(ANY_PACKAGE, *ClassName);
                 if (TargetClass)
                 {
-                    UE_LOG(LogTemp, Display, TEXT("Found class using alternative name '%s'"), *ClassName);
+                    UE_LOG(LogUnrealMCP, Display, TEXT("Found class using alternative name '%s'"), *ClassName);
                     break;
                 }
             }
@@ -361,7 +382,7 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintNodeCommands::HandleAddBlueprintFunct
             {
                 // Try loading it from its known package
                 TargetClass = LoadObject<UClass>(nullptr, TEXT("/Script/Engine.GameplayStatics"));
-                UE_LOG(LogTemp, Display, TEXT("Explicitly loading GameplayStatics: %s"), 
+                UE_LOG(LogUnrealMCP, Display, TEXT("Explicitly loading GameplayStatics: %s"), 
                        TargetClass ? TEXT("Success") : TEXT("Failed"));
             }
         }
@@ -369,7 +390,7 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintNodeCommands::HandleAddBlueprintFunct
         // If we found a target class, look for the function there
         if (TargetClass)
         {
-            UE_LOG(LogTemp, Display, TEXT("Looking for function '%s' in class '%s'"), 
+            UE_LOG(LogUnrealMCP, Display, TEXT("Looking for function '%s' in class '%s'"), 
                    *FunctionName, *TargetClass->GetName());
                    
             // First try exact name
@@ -379,7 +400,7 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintNodeCommands::HandleAddBlueprintFunct
             UClass* CurrentClass = TargetClass;
             while (!Function && CurrentClass)
             {
-                UE_LOG(LogTemp, Display, TEXT("Searching in class: %s"), *CurrentClass->GetName());
+                UE_LOG(LogUnrealMCP, Display, TEXT("Searching in class: %s"), *CurrentClass->GetName());
                 
                 // Try exact match
                 Function = CurrentClass->FindFunctionByName(*FunctionName);
@@ -390,11 +411,11 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintNodeCommands::HandleAddBlueprintFunct
                     for (TFieldIterator<UFunction> FuncIt(CurrentClass); FuncIt; ++FuncIt)
                     {
                         UFunction* AvailableFunc = *FuncIt;
-                        UE_LOG(LogTemp, Display, TEXT("  - Available function: %s"), *AvailableFunc->GetName());
+                        UE_LOG(LogUnrealMCP, Display, TEXT("  - Available function: %s"), *AvailableFunc->GetName());
                         
                         if (AvailableFunc->GetName().Equals(FunctionName, ESearchCase::IgnoreCase))
                         {
-                            UE_LOG(LogTemp, Display, TEXT("  - Found case-insensitive match: %s"), *AvailableFunc->GetName());
+                            UE_LOG(LogUnrealMCP, Display, TEXT("  - Found case-insensitive match: %s"), *AvailableFunc->GetName());
                             Function = AvailableFunc;
                             break;
                         }
@@ -411,7 +432,7 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintNodeCommands::HandleAddBlueprintFunct
                 if (TargetClass->GetName() == TEXT("GameplayStatics") && 
                     (FunctionName == TEXT("GetActorOfClass") || FunctionName.Equals(TEXT("GetActorOfClass"), ESearchCase::IgnoreCase)))
                 {
-                    UE_LOG(LogTemp, Display, TEXT("Using special case handling for GameplayStatics::GetActorOfClass"));
+                    UE_LOG(LogUnrealMCP, Display, TEXT("Using special case handling for GameplayStatics::GetActorOfClass"));
                     
                     // Create the function node directly
                     FunctionNode = NewObject<UK2Node_CallFunction>(EventGraph);
@@ -430,12 +451,12 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintNodeCommands::HandleAddBlueprintFunct
                         FunctionNode->PostPlacedNewNode();
                         FunctionNode->AllocateDefaultPins();
                         
-                        UE_LOG(LogTemp, Display, TEXT("Created GetActorOfClass node directly"));
+                        UE_LOG(LogUnrealMCP, Display, TEXT("Created GetActorOfClass node directly"));
                         
                         // List all pins
                         for (UEdGraphPin* Pin : FunctionNode->Pins)
                         {
-                            UE_LOG(LogTemp, Display, TEXT("  - Pin: %s, Direction: %d, Category: %s"), 
+                            UE_LOG(LogUnrealMCP, Display, TEXT("  - Pin: %s, Direction: %d, Category: %s"), 
                                    *Pin->PinName.ToString(), (int32)Pin->Direction, *Pin->PinType.PinCategory.ToString());
                         }
                     }
@@ -447,7 +468,7 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintNodeCommands::HandleAddBlueprintFunct
     // If we still haven't found the function, try in the blueprint's class
     if (!Function && !FunctionNode)
     {
-        UE_LOG(LogTemp, Display, TEXT("Trying to find function in blueprint class"));
+        UE_LOG(LogUnrealMCP, Display, TEXT("Trying to find function in blueprint class"));
         Function = Blueprint->GeneratedClass->FindFunctionByName(*FunctionName);
     }
     
@@ -478,12 +499,12 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintNodeCommands::HandleAddBlueprintFunct
                 UEdGraphPin* ParamPin = FUnrealMCPCommonUtils::FindPin(FunctionNode, ParamName, EGPD_Input);
                 if (ParamPin)
                 {
-                    UE_LOG(LogTemp, Display, TEXT("Found parameter pin '%s' of category '%s'"), 
+                    UE_LOG(LogUnrealMCP, Display, TEXT("Found parameter pin '%s' of category '%s'"), 
                            *ParamName, *ParamPin->PinType.PinCategory.ToString());
-                    UE_LOG(LogTemp, Display, TEXT("  Current default value: '%s'"), *ParamPin->DefaultValue);
+                    UE_LOG(LogUnrealMCP, Display, TEXT("  Current default value: '%s'"), *ParamPin->DefaultValue);
                     if (ParamPin->PinType.PinSubCategoryObject.IsValid())
                     {
-                        UE_LOG(LogTemp, Display, TEXT("  Pin subcategory: '%s'"), 
+                        UE_LOG(LogUnrealMCP, Display, TEXT("  Pin subcategory: '%s'"), 
                                *ParamPin->PinType.PinSubCategoryObject->GetName());
                     }
                     
@@ -491,7 +512,7 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintNodeCommands::HandleAddBlueprintFunct
                     if (ParamValue->Type == EJson::String)
                     {
                         FString StringVal = ParamValue->AsString();
-                        UE_LOG(LogTemp, Display, TEXT("  Setting string parameter '%s' to: '%s'"), 
+                        UE_LOG(LogUnrealMCP, Display, TEXT("  Setting string parameter '%s' to: '%s'"), 
                                *ParamName, *StringVal);
                         
                         // Handle class reference parameters (e.g., ActorClass in GetActorOfClass)
@@ -547,7 +568,7 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintNodeCommands::HandleAddBlueprintFunct
                             // Ensure we're using an integer value (no decimal)
                             int32 IntValue = FMath::RoundToInt(ParamValue->AsNumber());
                             ParamPin->DefaultValue = FString::FromInt(IntValue);
-                            UE_LOG(LogTemp, Display, TEXT("  Set integer parameter '%s' to: %d (string: '%s')"), 
+                            UE_LOG(LogUnrealMCP, Display, TEXT("  Set integer parameter '%s' to: %d (string: '%s')"), 
                                    *ParamName, IntValue, *ParamPin->DefaultValue);
                         }
                         else if (ParamPin->PinType.PinCategory == UEdGraphSchema_K2::PC_Float)
@@ -555,14 +576,14 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintNodeCommands::HandleAddBlueprintFunct
                             // For other numeric types
                             float FloatValue = ParamValue->AsNumber();
                             ParamPin->DefaultValue = FString::SanitizeFloat(FloatValue);
-                            UE_LOG(LogTemp, Display, TEXT("  Set float parameter '%s' to: %f (string: '%s')"), 
+                            UE_LOG(LogUnrealMCP, Display, TEXT("  Set float parameter '%s' to: %f (string: '%s')"), 
                                    *ParamName, FloatValue, *ParamPin->DefaultValue);
                         }
                         else if (ParamPin->PinType.PinCategory == UEdGraphSchema_K2::PC_Boolean)
                         {
                             bool BoolValue = ParamValue->AsBool();
                             ParamPin->DefaultValue = BoolValue ? TEXT("true") : TEXT("false");
-                            UE_LOG(LogTemp, Display, TEXT("  Set boolean parameter '%s' to: %s"), 
+                            UE_LOG(LogUnrealMCP, Display, TEXT("  Set boolean parameter '%s' to: %s"), 
                                    *ParamName, *ParamPin->DefaultValue);
                         }
                         else if (ParamPin->PinType.PinCategory == UEdGraphSchema_K2::PC_Struct && ParamPin->PinType.PinSubCategoryObject == TBaseStructure<FVector>::Get())
@@ -582,14 +603,14 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintNodeCommands::HandleAddBlueprintFunct
                                     FString VectorString = FString::Printf(TEXT("(X=%f,Y=%f,Z=%f)"), X, Y, Z);
                                     ParamPin->DefaultValue = VectorString;
                                     
-                                    UE_LOG(LogTemp, Display, TEXT("  Set vector parameter '%s' to: %s"), 
+                                    UE_LOG(LogUnrealMCP, Display, TEXT("  Set vector parameter '%s' to: %s"), 
                                            *ParamName, *VectorString);
-                                    UE_LOG(LogTemp, Display, TEXT("  Final pin value: '%s'"), 
+                                    UE_LOG(LogUnrealMCP, Display, TEXT("  Final pin value: '%s'"), 
                                            *ParamPin->DefaultValue);
                                 }
                                 else
                                 {
-                                    UE_LOG(LogTemp, Warning, TEXT("Array parameter type not fully supported yet"));
+                                    UE_LOG(LogUnrealMCP, Warning, TEXT("Array parameter type not fully supported yet"));
                                 }
                             }
                         }
@@ -602,7 +623,7 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintNodeCommands::HandleAddBlueprintFunct
                             // Ensure we're using an integer value (no decimal)
                             int32 IntValue = FMath::RoundToInt(ParamValue->AsNumber());
                             ParamPin->DefaultValue = FString::FromInt(IntValue);
-                            UE_LOG(LogTemp, Display, TEXT("  Set integer parameter '%s' to: %d (string: '%s')"), 
+                            UE_LOG(LogUnrealMCP, Display, TEXT("  Set integer parameter '%s' to: %d (string: '%s')"), 
                                    *ParamName, IntValue, *ParamPin->DefaultValue);
                         }
                         else
@@ -610,7 +631,7 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintNodeCommands::HandleAddBlueprintFunct
                             // For other numeric types
                             float FloatValue = ParamValue->AsNumber();
                             ParamPin->DefaultValue = FString::SanitizeFloat(FloatValue);
-                            UE_LOG(LogTemp, Display, TEXT("  Set float parameter '%s' to: %f (string: '%s')"), 
+                            UE_LOG(LogUnrealMCP, Display, TEXT("  Set float parameter '%s' to: %f (string: '%s')"), 
                                    *ParamName, FloatValue, *ParamPin->DefaultValue);
                         }
                     }
@@ -618,12 +639,12 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintNodeCommands::HandleAddBlueprintFunct
                     {
                         bool BoolValue = ParamValue->AsBool();
                         ParamPin->DefaultValue = BoolValue ? TEXT("true") : TEXT("false");
-                        UE_LOG(LogTemp, Display, TEXT("  Set boolean parameter '%s' to: %s"), 
+                        UE_LOG(LogUnrealMCP, Display, TEXT("  Set boolean parameter '%s' to: %s"), 
                                *ParamName, *ParamPin->DefaultValue);
                     }
                     else if (ParamValue->Type == EJson::Array)
                     {
-                        UE_LOG(LogTemp, Display, TEXT("  Processing array parameter '%s'"), *ParamName);
+                        UE_LOG(LogUnrealMCP, Display, TEXT("  Processing array parameter '%s'"), *ParamName);
                         // Handle array parameters - like Vector parameters
                         const TArray<TSharedPtr<FJsonValue>>* ArrayValue;
                         if (ParamValue->TryGetArray(ArrayValue))
@@ -641,14 +662,14 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintNodeCommands::HandleAddBlueprintFunct
                                 FString VectorString = FString::Printf(TEXT("(X=%f,Y=%f,Z=%f)"), X, Y, Z);
                                 ParamPin->DefaultValue = VectorString;
                                 
-                                UE_LOG(LogTemp, Display, TEXT("  Set vector parameter '%s' to: %s"), 
+                                UE_LOG(LogUnrealMCP, Display, TEXT("  Set vector parameter '%s' to: %s"), 
                                        *ParamName, *VectorString);
-                                UE_LOG(LogTemp, Display, TEXT("  Final pin value: '%s'"), 
+                                UE_LOG(LogUnrealMCP, Display, TEXT("  Final pin value: '%s'"), 
                                        *ParamPin->DefaultValue);
                             }
                             else
                             {
-                                UE_LOG(LogTemp, Warning, TEXT("Array parameter type not fully supported yet"));
+                                UE_LOG(LogUnrealMCP, Warning, TEXT("Array parameter type not fully supported yet"));
                             }
                         }
                     }
@@ -656,7 +677,7 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintNodeCommands::HandleAddBlueprintFunct
                 }
                 else
                 {
-                    UE_LOG(LogTemp, Warning, TEXT("Parameter pin '%s' not found"), *ParamName);
+                    UE_LOG(LogUnrealMCP, Warning, TEXT("Parameter pin '%s' not found"), *ParamName);
                 }
             }
         }
@@ -664,6 +685,7 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintNodeCommands::HandleAddBlueprintFunct
 
     // Mark the blueprint as modified
     FBlueprintEditorUtils::MarkBlueprintAsModified(Blueprint);
+    FMCPBlueprintCompileQueue::Get().MarkDirty(Blueprint);
 
     TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
     ResultObj->SetStringField(TEXT("node_id"), FunctionNode->NodeGuid.ToString());
@@ -760,6 +782,7 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintNodeCommands::HandleAddBlueprintVaria
 
     // Mark the blueprint as modified
     FBlueprintEditorUtils::MarkBlueprintAsModified(Blueprint);
+    FMCPBlueprintCompileQueue::Get().MarkDirty(Blueprint);
 
     TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
     ResultObj->SetStringField(TEXT("variable_name"), VariableName);
@@ -812,6 +835,7 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintNodeCommands::HandleAddBlueprintInput
 
     // Mark the blueprint as modified
     FBlueprintEditorUtils::MarkBlueprintAsModified(Blueprint);
+    FMCPBlueprintCompileQueue::Get().MarkDirty(Blueprint);
 
     TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
     ResultObj->SetStringField(TEXT("node_id"), InputActionNode->NodeGuid.ToString());
@@ -857,6 +881,7 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintNodeCommands::HandleAddBlueprintSelfR
 
     // Mark the blueprint as modified
     FBlueprintEditorUtils::MarkBlueprintAsModified(Blueprint);
+    FMCPBlueprintCompileQueue::Get().MarkDirty(Blueprint);
 
     TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
     ResultObj->SetStringField(TEXT("node_id"), SelfNode->NodeGuid.ToString());
@@ -910,7 +935,7 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintNodeCommands::HandleFindBlueprintNode
             UK2Node_Event* EventNode = Cast<UK2Node_Event>(Node);
             if (EventNode && EventNode->EventReference.GetMemberName() == FName(*EventName))
             {
-                UE_LOG(LogTemp, Display, TEXT("Found event node with name %s: %s"), *EventName, *EventNode->NodeGuid.ToString());
+                UE_LOG(LogUnrealMCP, Display, TEXT("Found event node with name %s: %s"), *EventName, *EventNode->NodeGuid.ToString());
                 NodeGuidArray.Add(MakeShared<FJsonValueString>(EventNode->NodeGuid.ToString()));
             }
         }
@@ -25,6 +25,9 @@
 #include "BlueprintActionDatabase.h"
 #include "Dom/JsonObject.h"
 #include "Dom/JsonValue.h"
+#include "MCPBlueprintCache.h"
+#include "MCPLog.h"
+#include "MCPResultWriter.h"
 
 // JSON Utilities
 TSharedPtr<FJsonObject> FUnrealMCPCommonUtils::CreateErrorResponse(const FString& Message)
@@ -153,8 +156,7 @@ UBlueprint* FUnrealMCPCommonUtils::FindBlueprint(const FString& BlueprintName)
 
 UBlueprint* FUnrealMCPCommonUtils::FindBlueprintByName(const FString& BlueprintName)
 {
-    FString AssetPath = TEXT("/Game/Blueprints/") + BlueprintName;
-    return LoadObject<UBlueprint>(nullptr, *AssetPath);
+    return FMCPBlueprintCache::Get().FindBlueprint(BlueprintName);
 }
 
 UEdGraph* FUnrealMCPCommonUtils::FindOrCreateEventGraph(UBlueprint* Blueprint)
@@ -199,7 +201,7 @@ UK2Node_Event* FUnrealMCPCommonUtils::CreateEventNode(UEdGraph* Graph, const FSt
         UK2Node_Event* EventNode = Cast<UK2Node_Event>(Node);
         if (EventNode && EventNode->EventReference.GetMemberName() == FName(*EventName))
         {
-            UE_LOG(LogTemp, Display, TEXT("Using existing event node with name %s (ID: %s)"), 
+            UE_LOG(LogUnrealMCP, Display, TEXT("Using existing event node with name %s (ID: %s)"), 
                 *EventName, *EventNode->NodeGuid.ToString());
             return EventNode;
         }
@@ -221,12 +223,12 @@ UK2Node_Event* FUnrealMCPCommonUtils::CreateEventNode(UEdGraph* Graph, const FSt
         Graph->AddNode(EventNode, true);
         EventNode->PostPlacedNewNode();
         EventNode->AllocateDefaultPins();
-        UE_LOG(LogTemp, Display, TEXT("Created new event node with name %s (ID: %s)"), 
+        UE_LOG(LogUnrealMCP, Display, TEXT("Created new event node with name %s (ID: %s)"), 
             *EventName, *EventNode->NodeGuid.ToString());
     }
     else
     {
-        UE_LOG(LogTemp, Error, TEXT("Failed to find function for event name: %s"), *EventName);
+        UE_LOG(LogUnrealMCP, Error, TEXT("Failed to find function for event name: %s"), *EventName);
     }
     
     return EventNode;
@@ -370,12 +372,12 @@ UEdGraphPin* FUnrealMCPCommonUtils::FindPin(UEdGraphNode* Node, const FString& P
     }
     
     // Log all pins for debugging
-    UE_LOG(LogTemp, Display, TEXT("FindPin: Looking for pin '%s' (Direction: %d) in node '%s'"), 
+    UE_LOG(LogUnrealMCP, Display, TEXT("FindPin: Looking for pin '%s' (Direction: %d) in node '%s'"), 
            *PinName, (int32)Direction, *Node->GetName());
     
     for (UEdGraphPin* Pin : Node->Pins)
     {
-        UE_LOG(LogTemp, Display, TEXT("  - Available pin: '%s', Direction: %d, Category: %s"), 
+        UE_LOG(LogUnrealMCP, Display, TEXT("  - Available pin: '%s', Direction: %d, Category: %s"), 
                *Pin->PinName.ToString(), (int32)Pin->Direction, *Pin->PinType.PinCategory.ToString());
     }
     
@@ -384,7 +386,7 @@ UEdGraphPin* FUnrealMCPCommonUtils::FindPin(UEdGraphNode* Node, const FString& P
     {
         if (Pin->PinName.ToString() == PinName && (Direction == EGPD_MAX || Pin->Direction == Direction))
         {
-            UE_LOG(LogTemp, Display, TEXT("  - Found exact matching pin: '%s'"), *Pin->PinName.ToString());
+            UE_LOG(LogUnrealMCP, Display, TEXT("  - Found exact matching pin: '%s'"), *Pin->PinName.ToString());
             return Pin;
         }
     }
@@ -395,7 +397,7 @@ UEdGraphPin* FUnrealMCPCommonUtils::FindPin(UEdGraphNode* Node, const FString& P
         if (Pin->PinName.ToString().Equals(PinName, ESearchCase::IgnoreCase) && 
             (Direction == EGPD_MAX || Pin->Direction == Direction))
         {
-            UE_LOG(LogTemp, Display, TEXT("  - Found case-insensitive matching pin: '%s'"), *Pin->PinName.ToString());
+            UE_LOG(LogUnrealMCP, Display, TEXT("  - Found case-insensitive matching pin: '%s'"), *Pin->PinName.ToString());
             return Pin;
         }
     }
@@ -407,13 +409,13 @@ UEdGraphPin* FUnrealMCPCommonUtils::FindPin(UEdGraphNode* Node, const FString& P
         {
             if (Pin->Direction == EGPD_Output && Pin->PinType.PinCategory != UEdGraphSchema_K2::PC_Exec)
             {
-                UE_LOG(LogTemp, Display, TEXT("  - Found fallback data output pin: '%s'"), *Pin->PinName.ToString());
+                UE_LOG(LogUnrealMCP, Display, TEXT("  - Found fallback data output pin: '%s'"), *Pin->PinName.ToString());
                 return Pin;
             }
         }
     }
     
-    UE_LOG(LogTemp, Warning, TEXT("  - No matching pin found for '%s'"), *PinName);
+    UE_LOG(LogUnrealMCP, Warning, TEXT("  - No matching pin found for '%s'"), *PinName);
     return nullptr;
 }
 
@@ -425,32 +427,17 @@ TSharedPtr<FJsonValue> FUnrealMCPCommonUtils::ActorToJson(AActor* Actor)
         return MakeShared<FJsonValueNull>();
     }
     
-    TSharedPtr<FJsonObject> ActorObject = MakeShared<FJsonObject>();
-    ActorObject->SetStringField(TEXT("name"), Actor->GetName());
-    ActorObject->SetStringField(TEXT("class"), Actor->GetClass()->GetName());
-    
-    FVector Location = Actor->GetActorLocation();
-    TArray<TSharedPtr<FJsonValue>> LocationArray;
-    LocationArray.Add(MakeShared<FJsonValueNumber>(Location.X));
-    LocationArray.Add(MakeShared<FJsonValueNumber>(Location.Y));
-    LocationArray.Add(MakeShared<FJsonValueNumber>(Location.Z));
-    ActorObject->SetArrayField(TEXT("location"), LocationArray);
-    
-    FRotator Rotation = Actor->GetActorRotation();
-    TArray<TSharedPtr<FJsonValue>> RotationArray;
-    RotationArray.Add(MakeShared<FJsonValueNumber>(Rotation.Pitch));
-    RotationArray.Add(MakeShared<FJsonValueNumber>(Rotation.Yaw));
-    RotationArray.Add(MakeShared<FJsonValueNumber>(Rotation.Roll));
-    ActorObject->SetArrayField(TEXT("rotation"), RotationArray);
-    
-    FVector Scale = Actor->GetActorScale3D();
-    TArray<TSharedPtr<FJsonValue>> ScaleArray;
-    ScaleArray.Add(MakeShared<FJsonValueNumber>(Scale.X));
-    ScaleArray.Add(MakeShared<FJsonValueNumber>(Scale.Y));
-    ScaleArray.Add(MakeShared<FJsonValueNumber>(Scale.Z));
-    ActorObject->SetArrayField(TEXT("scale"), ScaleArray);
-    
-    return MakeShared<FJsonValueObject>(ActorObject);
+    return MakeShared<FJsonValueObject>(ActorToJsonObject(Actor));
+}
+
+static void SetVectorField(const TSharedPtr<FJsonObject>& Object, const TCHAR* FieldName, double X, double Y, double Z)
+{
+    TArray<TSharedPtr<FJsonValue>> Array;
+    Array.Reserve(3);
+    Array.Add(MakeShared<FJsonValueNumber>(X));
+    Array.Add(MakeShared<FJsonValueNumber>(Y));
+    Array.Add(MakeShared<FJsonValueNumber>(Z));
+    Object->SetArrayField(FieldName, Array);
 }
 
 TSharedPtr<FJsonObject> FUnrealMCPCommonUtils::ActorToJsonObject(AActor* Actor, bool bDetailed)
@@ -464,30 +451,41 @@ TSharedPtr<FJsonObject> FUnrealMCPCommonUtils::ActorToJsonObject(AActor* Actor,
     ActorObject->SetStringField(TEXT("name"), Actor->GetName());
     ActorObject->SetStringField(TEXT("class"), Actor->GetClass()->GetName());
     
-    FVector Location = Actor->GetActorLocation();
-    TArray<TSharedPtr<FJsonValue>> LocationArray;
-    LocationArray.Add(MakeShared<FJsonValueNumber>(Location.X));
-    LocationArray.Add(MakeShared<FJsonValueNumber>(Location.Y));
-    LocationArray.Add(MakeShared<FJsonValueNumber>(Location.Z));
-    ActorObject->SetArrayField(TEXT("location"), LocationArray);
-    
-    FRotator Rotation = Actor->GetActorRotation();
-    TArray<TSharedPtr<FJsonValue>> RotationArray;
-    RotationArray.Add(MakeShared<FJsonValueNumber>(Rotation.Pitch));
-    RotationArray.Add(MakeShared<FJsonValueNumber>(Rotation.Yaw));
-    RotationArray.Add(MakeShared<FJsonValueNumber>(Rotation.Roll));
-    ActorObject->SetArrayField(TEXT("rotation"), RotationArray);
-    
-    FVector Scale = Actor->GetActorScale3D();
-    TArray<TSharedPtr<FJsonValue>> ScaleArray;
-    ScaleArray.Add(MakeShared<FJsonValueNumber>(Scale.X));
-    ScaleArray.Add(MakeShared<FJsonValueNumber>(Scale.Y));
-    ScaleArray.Add(MakeShared<FJsonValueNumber>(Scale.Z));
-    ActorObject->SetArrayField(TEXT("scale"), ScaleArray);
+    const FVector Location = Actor->GetActorLocation();
+    SetVectorField(ActorObject, TEXT("location"), Location.X, Location.Y, Location.Z);
+    
+    const FRotator Rotation = Actor->GetActorRotation();
+    SetVectorField(ActorObject, TEXT("rotation"), Rotation.Pitch, Rotation.Yaw, Rotation.Roll);
+    
+    const FVector Scale = Actor->GetActorScale3D();
+    SetVectorField(ActorObject, TEXT("scale"), Scale.X, Scale.Y, Scale.Z);
     
     return ActorObject;
 }
 
+void FUnrealMCPCommonUtils::WriteActor(FMCPResultWriter& Writer, AActor* Actor)
+{
+    if (!Actor)
+    {
+        Writer.WriteNull();
+        return;
+    }
+    
+    Writer.BeginObject(5);
+    Writer.WriteStringField(TEXT("name"), Actor->GetName());
+    Writer.WriteStringField(TEXT("class"), Actor->GetClass()->GetName());
+    
+    const FVector Location = Actor->GetActorLocation();
+    Writer.WriteVectorField(TEXT("location"), Location.X, Location.Y, Location.Z);
+    
+    const FRotator Rotation = Actor->GetActorRotation();
+    Writer.WriteVectorField(TEXT("rotation"), Rotation.Pitch, Rotation.Yaw, Rotation.Roll);
+    
+    const FVector Scale = Actor->GetActorScale3D();
+    Writer.WriteVectorField(TEXT("scale"), Scale.X, Scale.Y, Scale.Z);
+    Writer.EndObject();
+}
+
 UK2Node_Event* FUnrealMCPCommonUtils::FindExistingEventNode(UEdGraph* Graph, const FString& EventName)
 {
     if (!Graph)
@@ -501,7 +499,7 @@ UK2Node_Event* FUnrealMCPCommonUtils::FindExistingEventNode(UEdGraph* Graph, con
         UK2Node_Event* EventNode = Cast<UK2Node_Event>(Node);
         if (EventNode && EventNode->EventReference.GetMemberName() == FName(*EventName))
         {
-            UE_LOG(LogTemp, Display, TEXT("Found existing event node with name: %s"), *EventName);
+            UE_LOG(LogUnrealMCP, Display, TEXT("Found existing event node with name: %s"), *EventName);
             return EventNode;
         }
     }
@@ -567,7 +565,7 @@ bool FUnrealMCPCommonUtils::SetObjectProperty(UObject* Object, const FString& Pr
                 uint8 ByteValue = static_cast<uint8>(Value->AsNumber());
                 ByteProp->SetPropertyValue(PropertyAddr, ByteValue);
                 
-                UE_LOG(LogTemp, Display, TEXT("Setting enum property %s to numeric value: %d"), 
+                UE_LOG(LogUnrealMCP, Display, TEXT("Setting enum property %s to numeric value: %d"), 
                       *PropertyName, ByteValue);
                 return true;
             }
@@ -582,7 +580,7 @@ bool FUnrealMCPCommonUtils::SetObjectProperty(UObject* Object, const FString& Pr
                     uint8 ByteValue = FCString::Atoi(*EnumValueName);
                     ByteProp->SetPropertyValue(PropertyAddr, ByteValue);
                     
-                    UE_LOG(LogTemp, Display, TEXT("Setting enum property %s to numeric string value: %s -> %d"), 
+                    UE_LOG(LogUnrealMCP, Display, TEXT("Setting enum property %s to numeric string value: %s -> %d"), 
                           *PropertyName, *EnumValueName, ByteValue);
                     return true;
                 }
@@ -604,17 +602,17 @@ bool FUnrealMCPCommonUtils::SetObjectProperty(UObject* Object, const FString& Pr
                 {
                     ByteProp->SetPropertyValue(PropertyAddr, static_cast<uint8>(EnumValue));
                     
-                    UE_LOG(LogTemp, Display, TEXT("Setting enum property %s to name value: %s -> %lld"), 
+                    UE_LOG(LogUnrealMCP, Display, TEXT("Setting enum property %s to name value: %s -> %lld"), 
                           *PropertyName, *EnumValueName, EnumValue);
                     return true;
                 }
                 else
                 {
                     // Log all possible enum values for debugging
-                    UE_LOG(LogTemp, Warning, TEXT("Could not find enum value for '%s'. Available options:"), *EnumValueName);
+                    UE_LOG(LogUnrealMCP, Warning, TEXT("Could not find enum value for '%s'. Available options:"), *EnumValueName);
                     for (int32 i = 0; i < EnumDef->NumEnums(); i++)
                     {
-                        UE_LOG(LogTemp, Warning, TEXT("  - %s (value: %d)"), 
+                        UE_LOG(LogUnrealMCP, Warning, TEXT("  - %s (value: %d)"), 
                                *EnumDef->GetNameStringByIndex(i), EnumDef->GetValueByIndex(i));
                     }
                     
@@ -645,7 +643,7 @@ bool FUnrealMCPCommonUtils::SetObjectProperty(UObject* Object, const FString& Pr
                 int64 EnumValue = static_cast<int64>(Value->AsNumber());
                 UnderlyingNumericProp->SetIntPropertyValue(PropertyAddr, EnumValue);
                 
-                UE_LOG(LogTemp, Display, TEXT("Setting enum property %s to numeric value: %lld"), 
+                UE_LOG(LogUnrealMCP, Display, TEXT("Setting enum property %s to numeric value: %lld"), 
                       *PropertyName, EnumValue);
                 return true;
             }
@@ -660,7 +658,7 @@ bool FUnrealMCPCommonUtils::SetObjectProperty(UObject* Object, const FString& Pr
                     int64 EnumValue = FCString::Atoi64(*EnumValueName);
                     UnderlyingNumericProp->SetIntPropertyValue(PropertyAddr, EnumValue);
                     
-                    UE_LOG(LogTemp, Display, TEXT("Setting enum property %s to numeric string value: %s -> %lld"), 
+                    UE_LOG(LogUnrealMCP, Display, TEXT("Setting enum property %s to numeric string value: %s -> %lld"), 
                           *PropertyName, *EnumValueName, EnumValue);
                     return true;
                 }
@@ -682,17 +680,17 @@ bool FUnrealMCPCommonUtils::SetObjectProperty(UObject* Object, const FString& Pr
                 {
                     UnderlyingNumericProp->SetIntPropertyValue(PropertyAddr, EnumValue);
                     
-                    UE_LOG(LogTemp, Display, TEXT("Setting enum property %s to name value: %s -> %lld"), 
+                    UE_LOG(LogUnrealMCP, Display, TEXT("Setting enum property %s to name value: %s -> %lld"), 
                           *PropertyName, *EnumValueName, EnumValue);
                     return true;
                 }
                 else
                 {
                     // Log all possible enum values for debugging
-                    UE_LOG(LogTemp, Warning, TEXT("Could not find enum value for '%s'. Available options:"), *EnumValueName);
+                    UE_LOG(LogUnrealMCP, Warning, TEXT("Could not find enum value for '%s'. Available options:"), *EnumValueName);
                     for (int32 i = 0; i < EnumDef->NumEnums(); i++)
                     {
-                        UE_LOG(LogTemp, Warning, TEXT("  - %s (value: %d)"), 
+                        UE_LOG(LogUnrealMCP, Warning, TEXT("  - %s (value: %d)"), 
                                *EnumDef->GetNameStringByIndex(i), EnumDef->GetValueByIndex(i));
                     }
                     
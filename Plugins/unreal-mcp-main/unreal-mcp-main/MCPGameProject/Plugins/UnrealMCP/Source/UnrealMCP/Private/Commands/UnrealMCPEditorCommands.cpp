@@ -1,10 +1,13 @@
 #include "Commands/UnrealMCPEditorCommands.h"
+#include "Algo/Find.h"
+#include "Async/Async.h"
 #include "Camera/CameraActor.h"
 #include "Commands/UnrealMCPCommonUtils.h"
 #include "Components/StaticMeshComponent.h"
 #include "Editor.h"
 #include "EditorSubsystem.h"
 #include "EditorViewportClient.h"
+#include "EngineUtils.h"
 #include "Engine/Blueprint.h"
 #include "Engine/BlueprintGeneratedClass.h"
 #include "Engine/DirectionalLight.h"
@@ -15,81 +18,403 @@
 #include "Engine/StaticMeshActor.h"
 #include "GameFramework/Actor.h"
 #include "HighResScreenshot.h"
-#include "ImageUtils.h"
-#include "Kismet/GameplayStatics.h"
 #include "Landscape.h"
 #include "LandscapeEditorUtils.h"
 #include "LandscapeInfo.h"
 #include "LandscapeProxy.h"
 #include "LevelEditorViewport.h"
-#include "Misc/FileHelper.h"
+#include "MCPCommandRegistry.h"
+#include "MCPHeightmapSource.h"
+#include "MCPLog.h"
+#include "MCPResultWriter.h"
+#include "MCPScreenshotCapture.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopedSlowTask.h"
 #include "Subsystems/EditorActorSubsystem.h"
 
-FUnrealMCPEditorCommands::FUnrealMCPEditorCommands() {}
+FUnrealMCPEditorCommands::FUnrealMCPEditorCommands() { ActorIndex.Start(); }
 
-TSharedPtr<FJsonObject>
-FUnrealMCPEditorCommands::HandleCommand(const FString &CommandType,
-                                        const TSharedPtr<FJsonObject> &Params) {
+void FUnrealMCPEditorCommands::RegisterCommands(FMCPCommandRegistry &Registry,
+                                                FName Owner) {
   // Actor manipulation commands
-  if (CommandType == TEXT("get_actors_in_level")) {
-    return HandleGetActorsInLevel(Params);
-  } else if (CommandType == TEXT("find_actors_by_name")) {
-    return HandleFindActorsByName(Params);
-  } else if (CommandType == TEXT("spawn_actor") ||
-             CommandType == TEXT("create_actor")) {
-    if (CommandType == TEXT("create_actor")) {
-      UE_LOG(LogTemp, Warning,
-             TEXT("'create_actor' command is deprecated and will be removed in "
-                  "a future version. Please use 'spawn_actor' instead."));
+  Registry.Register(
+      Owner, FMCPCommandInfo(TEXT("get_actors_in_level"),
+                             TEXT("List actors in the current level, with optional filters and paging"),
+                             FMCPStreamingCommandHandler::CreateRaw(
+                                 this, &FUnrealMCPEditorCommands::HandleGetActorsInLevel))
+                 .Param(TEXT("class"), TEXT("string"))
+                 .Param(TEXT("name"), TEXT("string"))
+                 .Param(TEXT("tag"), TEXT("string"))
+                 .Param(TEXT("bounds"), TEXT("object"))
+                 .Param(TEXT("fields"), TEXT("array"))
+                 .Param(TEXT("limit"), TEXT("number"))
+                 .Param(TEXT("cursor"), TEXT("string"))
+                 .ReadOnly());
+  Registry.Register(
+      Owner, FMCPCommandInfo(TEXT("find_actors_by_name"),
+                             TEXT("Find actors whose name or label matches a pattern"),
+                             FMCPCommandHandler::CreateRaw(
+                                 this, &FUnrealMCPEditorCommands::HandleFindActorsByName))
+                 .Param(TEXT("pattern"), TEXT("string"), true)
+                 .Param(TEXT("match"), TEXT("string"))
+                 .ReadOnly());
+  Registry.Register(
+      Owner, FMCPCommandInfo(TEXT("spawn_actor"),
+                             TEXT("Spawn a basic actor in the level"),
+                             FMCPCommandHandler::CreateRaw(
+                                 this, &FUnrealMCPEditorCommands::HandleSpawnActor))
+                 .Param(TEXT("type"), TEXT("string"), true)
+                 .Param(TEXT("name"), TEXT("string"), true)
+                 .Param(TEXT("location"), TEXT("vector"))
+                 .Param(TEXT("rotation"), TEXT("vector"))
+                 .Param(TEXT("scale"), TEXT("vector")));
+  Registry.Register(
+      Owner, FMCPCommandInfo(TEXT("create_actor"),
+                             TEXT("Deprecated alias of spawn_actor"),
+                             FMCPCommandHandler::CreateLambda(
+                                 [this](const TSharedPtr<FJsonObject> &Params) {
+                                   UE_LOG(LogUnrealMCP, Warning,
+                                          TEXT("'create_actor' command is deprecated and will be removed in "
+                                               "a future version. Please use 'spawn_actor' instead."));
+                                   return HandleSpawnActor(Params);
+                                 }))
+                 .Param(TEXT("type"), TEXT("string"), true)
+                 .Param(TEXT("name"), TEXT("string"), true)
+                 .Param(TEXT("location"), TEXT("vector"))
+                 .Param(TEXT("rotation"), TEXT("vector"))
+                 .Param(TEXT("scale"), TEXT("vector")));
+  Registry.Register(
+      Owner, FMCPCommandInfo(TEXT("delete_actor"), TEXT("Delete an actor by name"),
+                             FMCPCommandHandler::CreateRaw(
+                                 this, &FUnrealMCPEditorCommands::HandleDeleteActor))
+                 .Param(TEXT("name"), TEXT("string"), true));
+  Registry.Register(
+      Owner, FMCPCommandInfo(TEXT("set_actor_transform"),
+                             TEXT("Set the location, rotation or scale of an actor"),
+                             FMCPCommandHandler::CreateRaw(
+                                 this, &FUnrealMCPEditorCommands::HandleSetActorTransform))
+                 .Param(TEXT("name"), TEXT("string"), true)
+                 .Param(TEXT("location"), TEXT("vector"))
+                 .Param(TEXT("rotation"), TEXT("vector"))
+                 .Param(TEXT("scale"), TEXT("vector")));
+  Registry.Register(
+      Owner, FMCPCommandInfo(TEXT("get_actor_properties"),
+                             TEXT("Get the properties of an actor"),
+                             FMCPStreamingCommandHandler::CreateRaw(
+                                 this, &FUnrealMCPEditorCommands::HandleGetActorProperties))
+                 .Param(TEXT("name"), TEXT("string"), true)
+                 .ReadOnly());
+  Registry.Register(
+      Owner, FMCPCommandInfo(TEXT("set_actor_property"),
+                             TEXT("Set a property on an actor"),
+                             FMCPCommandHandler::CreateRaw(
+                                 this, &FUnrealMCPEditorCommands::HandleSetActorProperty))
+                 .Param(TEXT("name"), TEXT("string"), true)
+                 .Param(TEXT("property_name"), TEXT("string"), true)
+                 .Param(TEXT("property_value"), TEXT("any"), true));
+
+  // Blueprint actor spawning
+  Registry.Register(
+      Owner, FMCPCommandInfo(TEXT("spawn_blueprint_actor"),
+                             TEXT("Spawn an actor from a Blueprint"),
+                             FMCPCommandHandler::CreateRaw(
+                                 this, &FUnrealMCPEditorCommands::HandleSpawnBlueprintActor))
+                 .Param(TEXT("blueprint_name"), TEXT("string"), true)
+                 .Param(TEXT("actor_name"), TEXT("string"), true)
+                 .Param(TEXT("location"), TEXT("vector"))
+                 .Param(TEXT("rotation"), TEXT("vector"))
+                 .Param(TEXT("scale"), TEXT("vector")));
+
+  // Editor viewport commands
+  Registry.Register(
+      Owner, FMCPCommandInfo(TEXT("focus_viewport"),
+                             TEXT("Focus the viewport on an actor or location"),
+                             FMCPCommandHandler::CreateRaw(
+                                 this, &FUnrealMCPEditorCommands::HandleFocusViewport))
+                 .Param(TEXT("target"), TEXT("string"))
+                 .Param(TEXT("location"), TEXT("vector"))
+                 .Param(TEXT("distance"), TEXT("number"))
+                 .Param(TEXT("orientation"), TEXT("vector")));
+  Registry.Register(
+      Owner, FMCPCommandInfo(TEXT("take_screenshot"),
+                             TEXT("Capture the active viewport to a file or inline as base64"),
+                             FMCPAsyncCommandHandler::CreateRaw(
+                                 this, &FUnrealMCPEditorCommands::HandleTakeScreenshot))
+                 .Param(TEXT("filepath"), TEXT("string"))
+                 .Param(TEXT("inline"), TEXT("boolean"))
+                 .Param(TEXT("format"), TEXT("string"))
+                 .Param(TEXT("quality"), TEXT("number"))
+                 .ReadOnly());
+
+  // Landscape commands
+  Registry.Register(
+      Owner, FMCPCommandInfo(TEXT("create_landscape"),
+                             TEXT("Create a landscape, flat or from noise or a heightmap file"),
+                             FMCPAsyncCommandHandler::CreateRaw(
+                                 this, &FUnrealMCPEditorCommands::HandleCreateLandscape))
+                 .Param(TEXT("section_size"), TEXT("number"))
+                 .Param(TEXT("sections_per_component"), TEXT("number"))
+                 .Param(TEXT("components_x"), TEXT("number"))
+                 .Param(TEXT("components_y"), TEXT("number"))
+                 .Param(TEXT("location"), TEXT("vector"))
+                 .Param(TEXT("rotation"), TEXT("vector"))
+                 .Param(TEXT("scale"), TEXT("vector"))
+                 .Param(TEXT("heightmap"), TEXT("object")));
+
+  // Level commands
+  Registry.Register(
+      Owner, FMCPCommandInfo(TEXT("get_current_level_name"),
+                             TEXT("Get the name of the current level"),
+                             FMCPCommandHandler::CreateRaw(
+                                 this, &FUnrealMCPEditorCommands::HandleGetCurrentLevelName))
+                 .ReadOnly());
+
+  // Scripting commands
+  Registry.Register(
+      Owner, FMCPCommandInfo(TEXT("run_python"), TEXT("Run a Python script in the editor"),
+                             FMCPCommandHandler::CreateRaw(
+                                 this, &FUnrealMCPEditorCommands::HandleRunPython))
+                 .Param(TEXT("script_path"), TEXT("string")));
+}
+
+// Fields get_actors_in_level can return for each actor
+enum EActorListField : uint32 {
+  ALF_Name = 1 << 0,
+  ALF_Label = 1 << 1,
+  ALF_Class = 1 << 2,
+  ALF_Location = 1 << 3,
+  ALF_Rotation = 1 << 4,
+  ALF_Scale = 1 << 5,
+  ALF_Tags = 1 << 6,
+  ALF_Folder = 1 << 7,
+
+  // Same fields the command returned before projection was supported
+  ALF_Default = ALF_Name | ALF_Class | ALF_Location | ALF_Rotation | ALF_Scale,
+};
+
+// Largest page get_actors_in_level will return
+static const int32 MaxActorListPageSize = 10000;
+
+static bool ParseActorListFields(const TSharedPtr<FJsonObject> &Params,
+                                 uint32 &OutFields, FString &OutError) {
+  const TArray<TSharedPtr<FJsonValue>> *FieldArray = nullptr;
+  if (!Params->TryGetArrayField(TEXT("fields"), FieldArray)) {
+    OutFields = ALF_Default;
+    return true;
+  }
+
+  static const TMap<FString, uint32> FieldNames = {
+      {TEXT("name"), ALF_Name},         {TEXT("label"), ALF_Label},
+      {TEXT("class"), ALF_Class},       {TEXT("location"), ALF_Location},
+      {TEXT("rotation"), ALF_Rotation}, {TEXT("scale"), ALF_Scale},
+      {TEXT("tags"), ALF_Tags},         {TEXT("folder"), ALF_Folder},
+  };
+
+  OutFields = 0;
+  for (const TSharedPtr<FJsonValue> &FieldValue : *FieldArray) {
+    const FString FieldName = FieldValue->AsString();
+    const uint32 *Field = FieldNames.Find(FieldName);
+    if (!Field) {
+      OutError = FString::Printf(TEXT("Unknown field '%s'"), *FieldName);
+      return false;
     }
-    return HandleSpawnActor(Params);
-  } else if (CommandType == TEXT("delete_actor")) {
-    return HandleDeleteActor(Params);
-  } else if (CommandType == TEXT("set_actor_transform")) {
-    return HandleSetActorTransform(Params);
-  } else if (CommandType == TEXT("get_actor_properties")) {
-    return HandleGetActorProperties(Params);
-  } else if (CommandType == TEXT("set_actor_property")) {
-    return HandleSetActorProperty(Params);
+    OutFields |= *Field;
   }
-  // Blueprint actor spawning
-  else if (CommandType == TEXT("spawn_blueprint_actor")) {
-    return HandleSpawnBlueprintActor(Params);
+
+  return true;
+}
+
+static void WriteProjectedActor(FMCPResultWriter &Writer, AActor *Actor,
+                                uint32 Fields) {
+  Writer.BeginObject(FMath::CountBits(Fields));
+
+  if (Fields & ALF_Name) {
+    Writer.WriteStringField(TEXT("name"), Actor->GetName());
   }
-  // Editor viewport commands
-  else if (CommandType == TEXT("focus_viewport")) {
-    return HandleFocusViewport(Params);
-  } else if (CommandType == TEXT("take_screenshot")) {
-    return HandleTakeScreenshot(Params);
-  } else if (CommandType == TEXT("create_landscape")) {
-    return HandleCreateLandscape(Params);
-  } else if (CommandType == TEXT("get_current_level_name")) {
-    return HandleGetCurrentLevelName(Params);
-  } else if (CommandType == TEXT("run_python")) {
-    return HandleRunPython(Params);
+  if (Fields & ALF_Label) {
+    Writer.WriteStringField(TEXT("label"), Actor->GetActorLabel());
+  }
+  if (Fields & ALF_Class) {
+    Writer.WriteStringField(TEXT("class"), Actor->GetClass()->GetName());
+  }
+  if (Fields & ALF_Location) {
+    const FVector Location = Actor->GetActorLocation();
+    Writer.WriteVectorField(TEXT("location"), Location.X, Location.Y,
+                            Location.Z);
+  }
+  if (Fields & ALF_Rotation) {
+    const FRotator Rotation = Actor->GetActorRotation();
+    Writer.WriteVectorField(TEXT("rotation"), Rotation.Pitch, Rotation.Yaw,
+                            Rotation.Roll);
+  }
+  if (Fields & ALF_Scale) {
+    const FVector Scale = Actor->GetActorScale3D();
+    Writer.WriteVectorField(TEXT("scale"), Scale.X, Scale.Y, Scale.Z);
+  }
+  if (Fields & ALF_Tags) {
+    Writer.WriteKey(TEXT("tags"));
+    Writer.BeginArray(Actor->Tags.Num());
+    for (const FName &Tag : Actor->Tags) {
+      Writer.WriteString(Tag.ToString());
+    }
+    Writer.EndArray();
+  }
+  if (Fields & ALF_Folder) {
+    Writer.WriteStringField(TEXT("folder"), Actor->GetFolderPath().ToString());
   }
 
-  return FUnrealMCPCommonUtils::CreateErrorResponse(
-      FString::Printf(TEXT("Unknown editor command: %s"), *CommandType));
+  Writer.EndObject();
+}
+
+// Pages are ordered by name, with the object id breaking ties between levels.
+// The cursor is the sort key of the last actor returned, so it stays valid
+// when actors are added or removed between pages.
+static FString MakeActorListCursor(const AActor *Actor) {
+  return FString::Printf(TEXT("%s|%u"), *Actor->GetName(),
+                         Actor->GetUniqueID());
+}
+
+static bool ActorListLess(const FName &NameA, uint32 IdA, const FName &NameB,
+                          uint32 IdB) {
+  const int32 NameOrder = NameA.Compare(NameB);
+  return NameOrder != 0 ? NameOrder < 0 : IdA < IdB;
 }
 
 TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleGetActorsInLevel(
-    const TSharedPtr<FJsonObject> &Params) {
-  TArray<AActor *> AllActors;
-  UGameplayStatics::GetAllActorsOfClass(GWorld, AActor::StaticClass(),
-                                        AllActors);
-
-  TArray<TSharedPtr<FJsonValue>> ActorArray;
-  for (AActor *Actor : AllActors) {
-    if (Actor) {
-      ActorArray.Add(FUnrealMCPCommonUtils::ActorToJson(Actor));
+    const TSharedPtr<FJsonObject> &Params, FMCPResultWriter &Writer) {
+  UWorld *World = GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
+  if (!World) {
+    return FUnrealMCPCommonUtils::CreateErrorResponse(
+        TEXT("Failed to get editor world"));
+  }
+
+  // Class filter. The actor iterator only visits actors of the class, so this
+  // is the cheapest filter and is applied first.
+  UClass *ActorClass = AActor::StaticClass();
+  FString ClassName;
+  if (Params->TryGetStringField(TEXT("class"), ClassName) &&
+      !ClassName.IsEmpty()) {
+    ActorClass = FindFirstObject<UClass>(*ClassName,
+                                         EFindFirstObjectOptions::NativeFirst);
+    if (!ActorClass) {
+      ActorClass = FindFirstObject<UClass>(
+          *(ClassName + TEXT("_C")), EFindFirstObjectOptions::None);
+    }
+    if (!ActorClass || !ActorClass->IsChildOf(AActor::StaticClass())) {
+      return FUnrealMCPCommonUtils::CreateErrorResponse(
+          FString::Printf(TEXT("Unknown actor class: %s"), *ClassName));
     }
   }
 
-  TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
-  ResultObj->SetArrayField(TEXT("actors"), ActorArray);
+  // Name glob, matched against both the object name and the editor label
+  FString NamePattern;
+  Params->TryGetStringField(TEXT("name"), NamePattern);
 
-  return ResultObj;
+  FString TagString;
+  Params->TryGetStringField(TEXT("tag"), TagString);
+  const FName Tag = TagString.IsEmpty() ? NAME_None : FName(*TagString);
+
+  FBox Bounds(ForceInit);
+  const TSharedPtr<FJsonObject> *BoundsObject = nullptr;
+  if (Params->TryGetObjectField(TEXT("bounds"), BoundsObject)) {
+    Bounds = FBox(
+        FUnrealMCPCommonUtils::GetVectorFromJson(*BoundsObject, TEXT("min")),
+        FUnrealMCPCommonUtils::GetVectorFromJson(*BoundsObject, TEXT("max")));
+  }
+
+  uint32 Fields = 0;
+  FString FieldError;
+  if (!ParseActorListFields(Params, Fields, FieldError)) {
+    return FUnrealMCPCommonUtils::CreateErrorResponse(FieldError);
+  }
+
+  // No limit returns everything, as before pagination existed
+  int32 Limit = 0;
+  Params->TryGetNumberField(TEXT("limit"), Limit);
+  Limit = Limit > 0 ? FMath::Min(Limit, MaxActorListPageSize) : MAX_int32;
+
+  // Collect the matches first. Writing the result is the expensive part, so
+  // it's only done for the actors on the requested page.
+  TArray<AActor *> Matches;
+  for (TActorIterator<AActor> It(World, ActorClass); It; ++It) {
+    AActor *Actor = *It;
+    if (!IsValid(Actor)) {
+      continue;
+    }
+    if (Tag != NAME_None && !Actor->ActorHasTag(Tag)) {
+      continue;
+    }
+    if (Bounds.IsValid && !Bounds.IsInsideOrOn(Actor->GetActorLocation())) {
+      continue;
+    }
+    if (!NamePattern.IsEmpty() &&
+        !Actor->GetName().MatchesWildcard(NamePattern) &&
+        !Actor->GetActorLabel().MatchesWildcard(NamePattern)) {
+      continue;
+    }
+    Matches.Add(Actor);
+  }
+
+  Matches.Sort([](const AActor &A, const AActor &B) {
+    return ActorListLess(A.GetFName(), A.GetUniqueID(), B.GetFName(),
+                         B.GetUniqueID());
+  });
+
+  // Resume after the cursor
+  int32 StartIndex = 0;
+  FString Cursor;
+  if (Params->TryGetStringField(TEXT("cursor"), Cursor) && !Cursor.IsEmpty()) {
+    FString CursorName;
+    FString CursorId;
+    if (!Cursor.Split(TEXT("|"), &CursorName, &CursorId,
+                      ESearchCase::CaseSensitive, ESearchDir::FromEnd)) {
+      return FUnrealMCPCommonUtils::CreateErrorResponse(
+          TEXT("Invalid cursor"));
+    }
+
+    const FName CursorFName(*CursorName);
+    const uint32 CursorUniqueId =
+        (uint32)FCString::Strtoui64(*CursorId, nullptr, 10);
+
+    // Binary search for the first actor sorting after the cursor
+    int32 Low = 0;
+    int32 High = Matches.Num();
+    while (Low < High) {
+      const int32 Mid = Low + (High - Low) / 2;
+      if (ActorListLess(CursorFName, CursorUniqueId, Matches[Mid]->GetFName(),
+                        Matches[Mid]->GetUniqueID())) {
+        High = Mid;
+      } else {
+        Low = Mid + 1;
+      }
+    }
+    StartIndex = Low;
+  }
+
+  const int32 EndIndex =
+      (int32)FMath::Min<int64>((int64)StartIndex + Limit, Matches.Num());
+
+  // Written straight to the response, so the page never exists as a JSON tree
+  const int32 Count = FMath::Max(EndIndex - StartIndex, 0);
+  const bool bHasNextPage = EndIndex < Matches.Num() && EndIndex > StartIndex;
+
+  Writer.BeginObject(bHasNextPage ? 4 : 3);
+  Writer.WriteKey(TEXT("actors"));
+  Writer.BeginArray(Count);
+  for (int32 Index = StartIndex; Index < EndIndex; ++Index) {
+    WriteProjectedActor(Writer, Matches[Index], Fields);
+  }
+  Writer.EndArray();
+  Writer.WriteNumberField(TEXT("count"), Count);
+  Writer.WriteNumberField(TEXT("total"), Matches.Num());
+
+  if (bHasNextPage) {
+    Writer.WriteStringField(TEXT("next_cursor"),
+                            MakeActorListCursor(Matches[EndIndex - 1]));
+  }
+  Writer.EndObject();
+
+  return nullptr;
 }
 
 TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleFindActorsByName(
@@ -100,15 +425,23 @@ TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleFindActorsByName(
         TEXT("Missing 'pattern' parameter"));
   }
 
-  TArray<AActor *> AllActors;
-  UGameplayStatics::GetAllActorsOfClass(GWorld, AActor::StaticClass(),
-                                        AllActors);
+  EMCPActorMatch Match = EMCPActorMatch::Contains;
+  FString MatchMode;
+  if (Params->TryGetStringField(TEXT("match"), MatchMode)) {
+    if (MatchMode == TEXT("exact")) {
+      Match = EMCPActorMatch::Exact;
+    } else if (MatchMode == TEXT("prefix")) {
+      Match = EMCPActorMatch::Prefix;
+    } else if (MatchMode != TEXT("contains")) {
+      return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(
+          TEXT("Unknown match mode '%s', expected exact, prefix or contains"),
+          *MatchMode));
+    }
+  }
 
   TArray<TSharedPtr<FJsonValue>> MatchingActors;
-  for (AActor *Actor : AllActors) {
-    if (Actor && Actor->GetName().Contains(Pattern)) {
-      MatchingActors.Add(FUnrealMCPCommonUtils::ActorToJson(Actor));
-    }
+  for (AActor *Actor : ActorIndex.Search(Pattern, Match)) {
+    MatchingActors.Add(FUnrealMCPCommonUtils::ActorToJson(Actor));
   }
 
   TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
@@ -160,14 +493,11 @@ TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleSpawnActor(
   }
 
   // Check if an actor with this name already exists
-  TArray<AActor *> AllActors;
-  UGameplayStatics::GetAllActorsOfClass(World, AActor::StaticClass(),
-                                        AllActors);
-  for (AActor *Actor : AllActors) {
-    if (Actor && Actor->GetName() == ActorName) {
-      return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(
-          TEXT("Actor with name '%s' already exists"), *ActorName));
-    }
+  const FName ExistingName(*ActorName, FNAME_Find);
+  AActor *ExistingActor = ActorIndex.FindActor(ActorName);
+  if (ExistingActor && ExistingActor->GetFName() == ExistingName) {
+    return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(
+        TEXT("Actor with name '%s' already exists"), *ActorName));
   }
 
   FActorSpawnParameters SpawnParams;
@@ -215,27 +545,22 @@ TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleDeleteActor(
         TEXT("Missing 'name' parameter"));
   }
 
-  TArray<AActor *> AllActors;
-  UGameplayStatics::GetAllActorsOfClass(GWorld, AActor::StaticClass(),
-                                        AllActors);
-
-  for (AActor *Actor : AllActors) {
-    if (Actor && Actor->GetName() == ActorName) {
-      // Store actor info before deletion for the response
-      TSharedPtr<FJsonObject> ActorInfo =
-          FUnrealMCPCommonUtils::ActorToJsonObject(Actor);
+  AActor *Actor = ActorIndex.FindActor(ActorName);
+  if (!Actor) {
+    return FUnrealMCPCommonUtils::CreateErrorResponse(
+        FString::Printf(TEXT("Actor not found: %s"), *ActorName));
+  }
 
-      // Delete the actor
-      Actor->Destroy();
+  // Store actor info before deletion for the response
+  TSharedPtr<FJsonObject> ActorInfo =
+      FUnrealMCPCommonUtils::ActorToJsonObject(Actor);
 
-      TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
-      ResultObj->SetObjectField(TEXT("deleted_actor"), ActorInfo);
-      return ResultObj;
-    }
-  }
+  // Delete the actor
+  Actor->Destroy();
 
-  return FUnrealMCPCommonUtils::CreateErrorResponse(
-      FString::Printf(TEXT("Actor not found: %s"), *ActorName));
+  TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
+  ResultObj->SetObjectField(TEXT("deleted_actor"), ActorInfo);
+  return ResultObj;
 }
 
 TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleSetActorTransform(
@@ -248,17 +573,7 @@ TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleSetActorTransform(
   }
 
   // Find the actor
-  AActor *TargetActor = nullptr;
-  TArray<AActor *> AllActors;
-  UGameplayStatics::GetAllActorsOfClass(GWorld, AActor::StaticClass(),
-                                        AllActors);
-
-  for (AActor *Actor : AllActors) {
-    if (Actor && Actor->GetName() == ActorName) {
-      TargetActor = Actor;
-      break;
-    }
-  }
+  AActor *TargetActor = ActorIndex.FindActor(ActorName);
 
   if (!TargetActor) {
     return FUnrealMCPCommonUtils::CreateErrorResponse(
@@ -289,7 +604,7 @@ TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleSetActorTransform(
 }
 
 TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleGetActorProperties(
-    const TSharedPtr<FJsonObject> &Params) {
+    const TSharedPtr<FJsonObject> &Params, FMCPResultWriter &Writer) {
   // Get actor name
   FString ActorName;
   if (!Params->TryGetStringField(TEXT("name"), ActorName)) {
@@ -298,25 +613,15 @@ TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleGetActorProperties(
   }
 
   // Find the actor
-  AActor *TargetActor = nullptr;
-  TArray<AActor *> AllActors;
-  UGameplayStatics::GetAllActorsOfClass(GWorld, AActor::StaticClass(),
-                                        AllActors);
-
-  for (AActor *Actor : AllActors) {
-    if (Actor && Actor->GetName() == ActorName) {
-      TargetActor = Actor;
-      break;
-    }
-  }
+  AActor *TargetActor = ActorIndex.FindActor(ActorName);
 
   if (!TargetActor) {
     return FUnrealMCPCommonUtils::CreateErrorResponse(
         FString::Printf(TEXT("Actor not found: %s"), *ActorName));
   }
 
-  // Always return detailed properties for this command
-  return FUnrealMCPCommonUtils::ActorToJsonObject(TargetActor, true);
+  FUnrealMCPCommonUtils::WriteActor(Writer, TargetActor);
+  return nullptr;
 }
 
 TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleSetActorProperty(
@@ -329,17 +634,7 @@ TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleSetActorProperty(
   }
 
   // Find the actor
-  AActor *TargetActor = nullptr;
-  TArray<AActor *> AllActors;
-  UGameplayStatics::GetAllActorsOfClass(GWorld, AActor::StaticClass(),
-                                        AllActors);
-
-  for (AActor *Actor : AllActors) {
-    if (Actor && Actor->GetName() == ActorName) {
-      TargetActor = Actor;
-      break;
-    }
-  }
+  AActor *TargetActor = ActorIndex.FindActor(ActorName);
 
   if (!TargetActor) {
     return FUnrealMCPCommonUtils::CreateErrorResponse(
@@ -403,17 +698,7 @@ TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleSpawnBlueprintActor(
         TEXT("Blueprint name is empty"));
   }
 
-  FString Root = TEXT("/Game/Blueprints/");
-  FString AssetPath = Root + BlueprintName;
-
-  if (!FPackageName::DoesPackageExist(AssetPath)) {
-    return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(
-        TEXT(
-            "Blueprint '%s' not found – it must reside under /Game/Blueprints"),
-        *BlueprintName));
-  }
-
-  UBlueprint *Blueprint = LoadObject<UBlueprint>(nullptr, *AssetPath);
+  UBlueprint *Blueprint = FUnrealMCPCommonUtils::FindBlueprint(BlueprintName);
   if (!Blueprint) {
     return FUnrealMCPCommonUtils::CreateErrorResponse(
         FString::Printf(TEXT("Blueprint not found: %s"), *BlueprintName));
@@ -503,17 +788,7 @@ TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleFocusViewport(
   // If we have a target actor, focus on it
   if (HasTargetActor) {
     // Find the actor
-    AActor *TargetActor = nullptr;
-    TArray<AActor *> AllActors;
-    UGameplayStatics::GetAllActorsOfClass(GWorld, AActor::StaticClass(),
-                                          AllActors);
-
-    for (AActor *Actor : AllActors) {
-      if (Actor && Actor->GetName() == TargetActorName) {
-        TargetActor = Actor;
-        break;
-      }
-    }
+    AActor *TargetActor = ActorIndex.FindActor(TargetActorName);
 
     if (!TargetActor) {
       return FUnrealMCPCommonUtils::CreateErrorResponse(
@@ -545,47 +820,58 @@ TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleFocusViewport(
   return ResultObj;
 }
 
-TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleTakeScreenshot(
-    const TSharedPtr<FJsonObject> &Params) {
-  // Get file path parameter
-  FString FilePath;
-  if (!Params->TryGetStringField(TEXT("filepath"), FilePath)) {
-    return FUnrealMCPCommonUtils::CreateErrorResponse(
-        TEXT("Missing 'filepath' parameter"));
+void FUnrealMCPEditorCommands::HandleTakeScreenshot(
+    const TSharedPtr<FJsonObject> &Params, FMCPCommandCompletion OnComplete) {
+  FMCPScreenshotRequest Request;
+  Params->TryGetStringField(TEXT("filepath"), Request.FilePath);
+  Params->TryGetBoolField(TEXT("inline"), Request.bInline);
+  if (Request.FilePath.IsEmpty() && !Request.bInline) {
+    OnComplete(FUnrealMCPCommonUtils::CreateErrorResponse(
+        TEXT("Either 'filepath' or 'inline' must be provided")));
+    return;
+  }
+
+  // An explicit format wins, then the file extension, then PNG
+  FString FormatName;
+  if (Params->TryGetStringField(TEXT("format"), FormatName)) {
+    if (!FMCPScreenshotCapture::ParseFormat(FormatName, Request.Format)) {
+      OnComplete(FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(
+          TEXT("Unknown format '%s', expected png, jpg or bmp"), *FormatName)));
+      return;
+    }
+  } else if (!Request.FilePath.IsEmpty()) {
+    FMCPScreenshotCapture::ParseFormat(FPaths::GetExtension(Request.FilePath),
+                                       Request.Format);
+  }
+
+  int32 Quality = 0;
+  if (Params->TryGetNumberField(TEXT("quality"), Quality)) {
+    Request.Quality = FMath::Clamp(Quality, 1, 100);
   }
 
   // Ensure the file path has a proper extension
-  if (!FilePath.EndsWith(TEXT(".png"))) {
-    FilePath += TEXT(".png");
+  EMCPScreenshotFormat PathFormat;
+  if (!Request.FilePath.IsEmpty() &&
+      (!FMCPScreenshotCapture::ParseFormat(
+           FPaths::GetExtension(Request.FilePath), PathFormat) ||
+       PathFormat != Request.Format)) {
+    Request.FilePath += TEXT(".");
+    Request.FilePath += FMCPScreenshotCapture::GetExtension(Request.Format);
   }
 
   // Get the active viewport
-  if (GEditor && GEditor->GetActiveViewport()) {
-    FViewport *Viewport = GEditor->GetActiveViewport();
-    TArray<FColor> Bitmap;
-    FIntRect ViewportRect(0, 0, Viewport->GetSizeXY().X,
-                          Viewport->GetSizeXY().Y);
-
-    if (Viewport->ReadPixels(Bitmap, FReadSurfaceDataFlags(), ViewportRect)) {
-      TArray<uint8> CompressedBitmap;
-      FImageUtils::CompressImageArray(Viewport->GetSizeXY().X,
-                                      Viewport->GetSizeXY().Y, Bitmap,
-                                      CompressedBitmap);
-
-      if (FFileHelper::SaveArrayToFile(CompressedBitmap, *FilePath)) {
-        TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
-        ResultObj->SetStringField(TEXT("filepath"), FilePath);
-        return ResultObj;
-      }
-    }
+  if (!GEditor || !GEditor->GetActiveViewport()) {
+    OnComplete(FUnrealMCPCommonUtils::CreateErrorResponse(
+        TEXT("Failed to get active viewport")));
+    return;
   }
 
-  return FUnrealMCPCommonUtils::CreateErrorResponse(
-      TEXT("Failed to take screenshot"));
+  FMCPScreenshotCapture::Capture(GEditor->GetActiveViewport(), Request,
+                                 MoveTemp(OnComplete));
 }
 
-TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleCreateLandscape(
-    const TSharedPtr<FJsonObject> &Params) {
+void FUnrealMCPEditorCommands::HandleCreateLandscape(
+    const TSharedPtr<FJsonObject> &Params, FMCPCommandCompletion OnComplete) {
   // Default parameters based on user request (8km x 8km)
   int32 SectionSize = 63;
   int32 SectionsPerComponent = 1;
@@ -611,10 +897,34 @@ TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleCreateLandscape(
   if (Params->HasField(TEXT("scale")))
     Scale = FUnrealMCPCommonUtils::GetVectorFromJson(Params, TEXT("scale"));
 
+  // The sizes the landscape editor offers; anything else fails inside Import
+  static const int32 ValidSectionSizes[] = {7, 15, 31, 63, 127, 255};
+  if (!Algo::Find(ValidSectionSizes, SectionSize) ||
+      (SectionsPerComponent != 1 && SectionsPerComponent != 2) ||
+      ComponentsX < 1 || ComponentsY < 1) {
+    OnComplete(FUnrealMCPCommonUtils::CreateErrorResponse(TEXT(
+        "Invalid landscape size: section_size must be 7, 15, 31, 63, 127 or "
+        "255, sections_per_component 1 or 2, and components_x and "
+        "components_y at least 1")));
+    return;
+  }
+
+  FMCPHeightmapSource Source;
+  const TSharedPtr<FJsonObject> *HeightmapJson = nullptr;
+  Params->TryGetObjectField(TEXT("heightmap"), HeightmapJson);
+  FString Error;
+  if (!FMCPHeightmapGenerator::ParseSource(
+          HeightmapJson ? *HeightmapJson : TSharedPtr<FJsonObject>(), Source,
+          Error)) {
+    OnComplete(FUnrealMCPCommonUtils::CreateErrorResponse(Error));
+    return;
+  }
+
   UWorld *World = GEditor->GetEditorWorldContext().World();
   if (!World) {
-    return FUnrealMCPCommonUtils::CreateErrorResponse(
-        TEXT("Failed to get editor world"));
+    OnComplete(FUnrealMCPCommonUtils::CreateErrorResponse(
+        TEXT("Failed to get editor world")));
+    return;
   }
 
   int32 QuadsPerSection = SectionSize;
@@ -622,34 +932,83 @@ TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleCreateLandscape(
   int32 SizeX = ComponentsX * QuadsPerComponent + 1;
   int32 SizeY = ComponentsY * QuadsPerComponent + 1;
 
-  TArray<uint16> HeightData;
-  HeightData.Init(32768, SizeX * SizeY);
+  // Build the heightmap in the background, one component region per task,
+  // then come back to the game thread to create the landscape from it
+  TWeakObjectPtr<UWorld> WeakWorld(World);
+  AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [=, OnComplete = MoveTemp(OnComplete)]() mutable {
+    const double GenerateStartTime = FPlatformTime::Seconds();
+    TArray<uint16> HeightData;
+    FString GenerateError;
+    if (!FMCPHeightmapGenerator::Generate(Source, SizeX, SizeY,
+                                         QuadsPerComponent, HeightData,
+                                         GenerateError)) {
+      OnComplete(FUnrealMCPCommonUtils::CreateErrorResponse(GenerateError));
+      return;
+    }
+    const double GenerateMilliseconds =
+        (FPlatformTime::Seconds() - GenerateStartTime) * 1000.0;
+
+    FMCPGameThreadQueue::Enqueue([=, HeightData = MoveTemp(HeightData),
+                                  OnComplete = MoveTemp(OnComplete)]() mutable {
+      UWorld *TargetWorld = WeakWorld.Get();
+      if (!TargetWorld) {
+        OnComplete(FUnrealMCPCommonUtils::CreateErrorResponse(
+            TEXT("The editor world changed while the heightmap was built")));
+        return;
+      }
 
-  TMap<FGuid, TArray<uint16>> HeightmapDataPerLayers;
-  HeightmapDataPerLayers.Add(FGuid(), HeightData);
+      const double ImportStartTime = FPlatformTime::Seconds();
+      FScopedSlowTask SlowTask(
+          1.0f, NSLOCTEXT("UnrealMCP", "ImportingLandscape",
+                          "Importing landscape"));
+      SlowTask.MakeDialog();
+
+      // Hand the heights over rather than copying them
+      TMap<FGuid, TArray<uint16>> HeightmapDataPerLayers;
+      HeightmapDataPerLayers.Add(FGuid(), MoveTemp(HeightData));
+
+      TMap<FGuid, TArray<FLandscapeImportLayerInfo>> ImportLayerInfosPerLayers;
+      ImportLayerInfosPerLayers.Add(FGuid(),
+                                    TArray<FLandscapeImportLayerInfo>());
+
+      ALandscape *Landscape = TargetWorld->SpawnActor<ALandscape>(
+          ALandscape::StaticClass(), Location, Rotation);
+      if (!Landscape) {
+        OnComplete(FUnrealMCPCommonUtils::CreateErrorResponse(
+            TEXT("Failed to spawn Landscape actor")));
+        return;
+      }
 
-  TMap<FGuid, TArray<FLandscapeImportLayerInfo>> ImportLayerInfosPerLayers;
-  ImportLayerInfosPerLayers.Add(FGuid(), TArray<FLandscapeImportLayerInfo>());
+      Landscape->SetActorScale3D(Scale);
+      Landscape->Import(FGuid::NewGuid(), 0, 0, SizeX - 1, SizeY - 1,
+                        SectionsPerComponent, SectionSize,
+                        HeightmapDataPerLayers, nullptr,
+                        ImportLayerInfosPerLayers,
+                        ELandscapeImportAlphamapType::Additive);
 
-  ALandscape *Landscape = World->SpawnActor<ALandscape>(
-      ALandscape::StaticClass(), Location, Rotation);
-  if (!Landscape) {
-    return FUnrealMCPCommonUtils::CreateErrorResponse(
-        TEXT("Failed to spawn Landscape actor"));
-  }
-
-  Landscape->SetActorScale3D(Scale);
-  Landscape->Import(FGuid::NewGuid(), 0, 0, SizeX - 1, SizeY - 1,
-                    SectionsPerComponent, SectionSize, HeightmapDataPerLayers,
-                    nullptr, ImportLayerInfosPerLayers,
-                    ELandscapeImportAlphamapType::Additive);
+      Landscape->CreateLandscapeInfo();
+      SlowTask.EnterProgressFrame(1.0f);
 
-  Landscape->CreateLandscapeInfo();
+      const double ImportMilliseconds =
+          (FPlatformTime::Seconds() - ImportStartTime) * 1000.0;
+      UE_LOG(LogUnrealMCP, Display,
+             TEXT("UnrealMCPEditorCommands: Created %dx%d landscape %s, "
+                  "heightmap %.1f ms, import %.1f ms"),
+             SizeX, SizeY, *Landscape->GetName(), GenerateMilliseconds,
+             ImportMilliseconds);
 
-  TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
-  ResultObj->SetBoolField(TEXT("success"), true);
-  ResultObj->SetStringField(TEXT("name"), Landscape->GetName());
-  return ResultObj;
+      TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
+      ResultObj->SetBoolField(TEXT("success"), true);
+      ResultObj->SetStringField(TEXT("name"), Landscape->GetName());
+      ResultObj->SetStringField(TEXT("heightmap"),
+                                FMCPHeightmapGenerator::GetTypeName(Source.Type));
+      ResultObj->SetNumberField(TEXT("size_x"), SizeX);
+      ResultObj->SetNumberField(TEXT("size_y"), SizeY);
+      ResultObj->SetNumberField(TEXT("generate_ms"), GenerateMilliseconds);
+      ResultObj->SetNumberField(TEXT("import_ms"), ImportMilliseconds);
+      OnComplete(ResultObj);
+    });
+  });
 }
 
 TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleGetCurrentLevelName(
@@ -1,19 +1,22 @@
 #include "Commands/UnrealMCPProjectCommands.h"
 #include "Commands/UnrealMCPCommonUtils.h"
+#include "MCPCommandRegistry.h"
 #include "GameFramework/InputSettings.h"
 
 FUnrealMCPProjectCommands::FUnrealMCPProjectCommands()
 {
 }
 
-TSharedPtr<FJsonObject> FUnrealMCPProjectCommands::HandleCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params)
+void FUnrealMCPProjectCommands::RegisterCommands(FMCPCommandRegistry& Registry, FName Owner)
 {
-    if (CommandType == TEXT("create_input_mapping"))
-    {
-        return HandleCreateInputMapping(Params);
-    }
-    
-    return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Unknown project command: %s"), *CommandType));
+    Registry.Register(Owner, FMCPCommandInfo(TEXT("create_input_mapping"), TEXT("Add a legacy input action mapping"),
+        FMCPCommandHandler::CreateRaw(this, &FUnrealMCPProjectCommands::HandleCreateInputMapping))
+        .Param(TEXT("action_name"), TEXT("string"), true)
+        .Param(TEXT("key"), TEXT("string"), true)
+        .Param(TEXT("shift"), TEXT("boolean"))
+        .Param(TEXT("ctrl"), TEXT("boolean"))
+        .Param(TEXT("alt"), TEXT("boolean"))
+        .Param(TEXT("cmd"), TEXT("boolean")));
 }
 
 TSharedPtr<FJsonObject> FUnrealMCPProjectCommands::HandleCreateInputMapping(const TSharedPtr<FJsonObject>& Params)
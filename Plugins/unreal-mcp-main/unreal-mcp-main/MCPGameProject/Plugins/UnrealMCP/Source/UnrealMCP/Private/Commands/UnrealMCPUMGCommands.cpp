@@ -1,5 +1,7 @@
 #include "Commands/UnrealMCPUMGCommands.h"
 #include "Commands/UnrealMCPCommonUtils.h"
+#include "MCPBlueprintCompileQueue.h"
+#include "MCPCommandRegistry.h"
 #include "Editor.h"
 #include "EditorAssetLibrary.h"
 #include "AssetRegistry/AssetRegistryModule.h"
@@ -30,34 +32,42 @@ FUnrealMCPUMGCommands::FUnrealMCPUMGCommands()
 {
 }
 
-TSharedPtr<FJsonObject> FUnrealMCPUMGCommands::HandleCommand(const FString& CommandName, const TSharedPtr<FJsonObject>& Params)
+void FUnrealMCPUMGCommands::RegisterCommands(FMCPCommandRegistry& Registry, FName Owner)
 {
-	if (CommandName == TEXT("create_umg_widget_blueprint"))
-	{
-		return HandleCreateUMGWidgetBlueprint(Params);
-	}
-	else if (CommandName == TEXT("add_text_block_to_widget"))
-	{
-		return HandleAddTextBlockToWidget(Params);
-	}
-	else if (CommandName == TEXT("add_widget_to_viewport"))
-	{
-		return HandleAddWidgetToViewport(Params);
-	}
-	else if (CommandName == TEXT("add_button_to_widget"))
-	{
-		return HandleAddButtonToWidget(Params);
-	}
-	else if (CommandName == TEXT("bind_widget_event"))
-	{
-		return HandleBindWidgetEvent(Params);
-	}
-	else if (CommandName == TEXT("set_text_block_binding"))
-	{
-		return HandleSetTextBlockBinding(Params);
-	}
-
-	return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Unknown UMG command: %s"), *CommandName));
+	Registry.Register(Owner, FMCPCommandInfo(TEXT("create_umg_widget_blueprint"), TEXT("Create a UMG Widget Blueprint"),
+		FMCPCommandHandler::CreateRaw(this, &FUnrealMCPUMGCommands::HandleCreateUMGWidgetBlueprint))
+		.Param(TEXT("name"), TEXT("string"), true));
+
+	Registry.Register(Owner, FMCPCommandInfo(TEXT("add_text_block_to_widget"), TEXT("Add a Text Block to a Widget Blueprint"),
+		FMCPCommandHandler::CreateRaw(this, &FUnrealMCPUMGCommands::HandleAddTextBlockToWidget))
+		.Param(TEXT("blueprint_name"), TEXT("string"), true)
+		.Param(TEXT("widget_name"), TEXT("string"), true)
+		.Param(TEXT("text"), TEXT("string"))
+		.Param(TEXT("position"), TEXT("array")));
+
+	Registry.Register(Owner, FMCPCommandInfo(TEXT("add_widget_to_viewport"), TEXT("Add a Widget Blueprint instance to the game viewport"),
+		FMCPCommandHandler::CreateRaw(this, &FUnrealMCPUMGCommands::HandleAddWidgetToViewport))
+		.Param(TEXT("blueprint_name"), TEXT("string"), true)
+		.Param(TEXT("z_order"), TEXT("number")));
+
+	Registry.Register(Owner, FMCPCommandInfo(TEXT("add_button_to_widget"), TEXT("Add a Button to a Widget Blueprint"),
+		FMCPCommandHandler::CreateRaw(this, &FUnrealMCPUMGCommands::HandleAddButtonToWidget))
+		.Param(TEXT("blueprint_name"), TEXT("string"), true)
+		.Param(TEXT("widget_name"), TEXT("string"), true)
+		.Param(TEXT("text"), TEXT("string"), true)
+		.Param(TEXT("position"), TEXT("array")));
+
+	Registry.Register(Owner, FMCPCommandInfo(TEXT("bind_widget_event"), TEXT("Bind a widget event to a new event graph node"),
+		FMCPCommandHandler::CreateRaw(this, &FUnrealMCPUMGCommands::HandleBindWidgetEvent))
+		.Param(TEXT("blueprint_name"), TEXT("string"), true)
+		.Param(TEXT("widget_name"), TEXT("string"), true)
+		.Param(TEXT("event_name"), TEXT("string"), true));
+
+	Registry.Register(Owner, FMCPCommandInfo(TEXT("set_text_block_binding"), TEXT("Bind a Text Block to a new getter function"),
+		FMCPCommandHandler::CreateRaw(this, &FUnrealMCPUMGCommands::HandleSetTextBlockBinding))
+		.Param(TEXT("blueprint_name"), TEXT("string"), true)
+		.Param(TEXT("widget_name"), TEXT("string"), true)
+		.Param(TEXT("binding_name"), TEXT("string"), true));
 }
 
 TSharedPtr<FJsonObject> FUnrealMCPUMGCommands::HandleCreateUMGWidgetBlueprint(const TSharedPtr<FJsonObject>& Params)
@@ -117,7 +127,7 @@ TSharedPtr<FJsonObject> FUnrealMCPUMGCommands::HandleCreateUMGWidgetBlueprint(co
 	FAssetRegistryModule::AssetCreated(WidgetBlueprint);
 
 	// Compile the blueprint
-	FKismetEditorUtilities::CompileBlueprint(WidgetBlueprint);
+	FMCPBlueprintCompileQueue::Get().RequestCompile(WidgetBlueprint);
 
 	// Create success response
 	TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
@@ -186,7 +196,7 @@ TSharedPtr<FJsonObject> FUnrealMCPUMGCommands::HandleAddTextBlockToWidget(const
 
 	// Mark the package dirty and compile
 	WidgetBlueprint->MarkPackageDirty();
-	FKismetEditorUtilities::CompileBlueprint(WidgetBlueprint);
+	FMCPBlueprintCompileQueue::Get().RequestCompile(WidgetBlueprint);
 
 	// Create success response
 	TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
@@ -310,9 +320,8 @@ TSharedPtr<FJsonObject> FUnrealMCPUMGCommands::HandleAddButtonToWidget(const TSh
 		}
 	}
 
-	// Save the Widget Blueprint
-	FKismetEditorUtilities::CompileBlueprint(WidgetBlueprint);
-	UEditorAssetLibrary::SaveAsset(BlueprintPath, false);
+	// Compile and save the Widget Blueprint, both held until the edit session ends if one is open
+	FMCPBlueprintCompileQueue::Get().RequestCompileAndSave(WidgetBlueprint);
 
 	Response->SetBoolField(TEXT("success"), true);
 	Response->SetStringField(TEXT("widget_name"), WidgetName);
@@ -432,9 +441,8 @@ TSharedPtr<FJsonObject> FUnrealMCPUMGCommands::HandleBindWidgetEvent(const TShar
 		return Response;
 	}
 
-	// Save the Widget Blueprint
-	FKismetEditorUtilities::CompileBlueprint(WidgetBlueprint);
-	UEditorAssetLibrary::SaveAsset(BlueprintPath, false);
+	// Compile and save the Widget Blueprint, both held until the edit session ends if one is open
+	FMCPBlueprintCompileQueue::Get().RequestCompileAndSave(WidgetBlueprint);
 
 	Response->SetBoolField(TEXT("success"), true);
 	Response->SetStringField(TEXT("event_name"), EventName);
@@ -534,9 +542,8 @@ TSharedPtr<FJsonObject> FUnrealMCPUMGCommands::HandleSetTextBlockBinding(const T
 		}
 	}
 
-	// Save the Widget Blueprint
-	FKismetEditorUtilities::CompileBlueprint(WidgetBlueprint);
-	UEditorAssetLibrary::SaveAsset(BlueprintPath, false);
+	// Compile and save the Widget Blueprint, both held until the edit session ends if one is open
+	FMCPBlueprintCompileQueue::Get().RequestCompileAndSave(WidgetBlueprint);
 
 	Response->SetBoolField(TEXT("success"), true);
 	Response->SetStringField(TEXT("binding_name"), BindingName);
@@ -0,0 +1,380 @@
+#include "MCPActorIndex.h"
+#include "Editor.h"
+#include "Engine/Engine.h"
+#include "EngineUtils.h"
+#include "GameFramework/Actor.h"
+#include "MCPLog.h"
+#include "Misc/CoreDelegates.h"
+
+static bool MatchesPattern(const FString& Key, const FString& Pattern, EMCPActorMatch Match)
+{
+    switch (Match)
+    {
+    case EMCPActorMatch::Exact:
+        return Key.Equals(Pattern, ESearchCase::IgnoreCase);
+    case EMCPActorMatch::Prefix:
+        return Key.StartsWith(Pattern, ESearchCase::IgnoreCase);
+    default:
+        return Key.Contains(Pattern, ESearchCase::IgnoreCase);
+    }
+}
+
+FMCPActorIndex::FMCPActorIndex()
+    : NumDeadKeys(0)
+    , NextGeneration(0)
+    , bNeedsRebuild(true)
+    , bKeysNeedSort(false)
+{
+}
+
+FMCPActorIndex::~FMCPActorIndex()
+{
+    Stop();
+}
+
+void FMCPActorIndex::Start()
+{
+    if (GEngine && !ActorAddedHandle.IsValid())
+    {
+        ActorAddedHandle = GEngine->OnLevelActorAdded().AddRaw(this, &FMCPActorIndex::OnActorAdded);
+        ActorDeletedHandle = GEngine->OnLevelActorDeleted().AddRaw(this, &FMCPActorIndex::OnActorDeleted);
+        ActorListChangedHandle = GEngine->OnLevelActorListChanged().AddRaw(this, &FMCPActorIndex::OnActorListChanged);
+        ActorLabelChangedHandle = FCoreDelegates::OnActorLabelChanged.AddRaw(this, &FMCPActorIndex::OnActorLabelChanged);
+    }
+
+    bNeedsRebuild = true;
+}
+
+void FMCPActorIndex::Stop()
+{
+    if (GEngine && ActorAddedHandle.IsValid())
+    {
+        GEngine->OnLevelActorAdded().Remove(ActorAddedHandle);
+        GEngine->OnLevelActorDeleted().Remove(ActorDeletedHandle);
+        GEngine->OnLevelActorListChanged().Remove(ActorListChangedHandle);
+    }
+    FCoreDelegates::OnActorLabelChanged.Remove(ActorLabelChangedHandle);
+
+    ActorAddedHandle.Reset();
+    ActorDeletedHandle.Reset();
+    ActorListChangedHandle.Reset();
+    ActorLabelChangedHandle.Reset();
+
+    Entries.Reset();
+    ByName.Reset();
+    ByLabel.Reset();
+    SortedKeys.Reset();
+    NumDeadKeys = 0;
+    IndexedWorld.Reset();
+    bNeedsRebuild = true;
+}
+
+AActor* FMCPActorIndex::FindActor(const FString& NameOrLabel)
+{
+    if (NameOrLabel.IsEmpty() || !Refresh())
+    {
+        return nullptr;
+    }
+
+    // A name missing from the name table can't belong to any actor, so don't add it
+    const FName Name(*NameOrLabel, FNAME_Find);
+    if (!Name.IsNone())
+    {
+        TArray<const AActor*> Candidates;
+        ByName.MultiFind(Name, Candidates);
+        for (const AActor* Key : Candidates)
+        {
+            AActor* Actor = Resolve(Key);
+            if (Actor && Actor->GetFName() == Name)
+            {
+                return Actor;
+            }
+        }
+    }
+
+    TArray<const AActor*> Candidates;
+    ByLabel.MultiFind(NameOrLabel, Candidates);
+    for (const AActor* Key : Candidates)
+    {
+        AActor* Actor = Resolve(Key);
+        if (Actor && Actor->GetActorLabel().Equals(NameOrLabel, ESearchCase::IgnoreCase))
+        {
+            return Actor;
+        }
+    }
+
+    return nullptr;
+}
+
+TArray<AActor*> FMCPActorIndex::Search(const FString& Pattern, EMCPActorMatch Match)
+{
+    TArray<AActor*> Result;
+    if (!Refresh())
+    {
+        return Result;
+    }
+
+    // Collect candidate keys first; resolving can re-key entries and reshuffle the lists
+    TArray<const AActor*> Candidates;
+    if (Match == EMCPActorMatch::Exact)
+    {
+        const FName Name(*Pattern, FNAME_Find);
+        if (!Name.IsNone())
+        {
+            ByName.MultiFind(Name, Candidates);
+        }
+        ByLabel.MultiFind(Pattern, Candidates);
+    }
+    else if (Match == EMCPActorMatch::Prefix)
+    {
+        CompactKeysIfNeeded();
+        SortKeysIfNeeded();
+
+        // Every key starting with Pattern sorts at or after it, in one contiguous run
+        int32 First = 0;
+        int32 Last = SortedKeys.Num();
+        while (First < Last)
+        {
+            const int32 Middle = First + (Last - First) / 2;
+            if (SortedKeys[Middle].Key.Compare(Pattern, ESearchCase::IgnoreCase) < 0)
+            {
+                First = Middle + 1;
+            }
+            else
+            {
+                Last = Middle;
+            }
+        }
+
+        for (int32 Index = First; Index < SortedKeys.Num() && SortedKeys[Index].Key.StartsWith(Pattern, ESearchCase::IgnoreCase); ++Index)
+        {
+            if (IsLive(SortedKeys[Index]))
+            {
+                Candidates.Add(SortedKeys[Index].Actor);
+            }
+        }
+    }
+    else
+    {
+        // No index helps with substrings, but scanning packed strings beats visiting every actor
+        CompactKeysIfNeeded();
+        for (const FSortedKey& SortedKey : SortedKeys)
+        {
+            if (SortedKey.Key.Contains(Pattern, ESearchCase::IgnoreCase) && IsLive(SortedKey))
+            {
+                Candidates.Add(SortedKey.Actor);
+            }
+        }
+    }
+
+    TSet<const AActor*> Seen;
+    Seen.Reserve(Candidates.Num());
+    for (const AActor* Key : Candidates)
+    {
+        bool bAlreadySeen = false;
+        Seen.Add(Key, &bAlreadySeen);
+        if (bAlreadySeen)
+        {
+            continue;
+        }
+
+        AActor* Actor = Resolve(Key);
+        if (Actor && (MatchesPattern(Actor->GetName(), Pattern, Match) || MatchesPattern(Actor->GetActorLabel(), Pattern, Match)))
+        {
+            Result.Add(Actor);
+        }
+    }
+
+    Result.Sort([](const AActor& A, const AActor& B)
+    {
+        return A.GetFName().LexicalLess(B.GetFName());
+    });
+
+    return Result;
+}
+
+int32 FMCPActorIndex::Num()
+{
+    Refresh();
+    return Entries.Num();
+}
+
+UWorld* FMCPActorIndex::Refresh()
+{
+    check(IsInGameThread());
+
+    UWorld* World = GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
+    if (!World)
+    {
+        return nullptr;
+    }
+
+    if (bNeedsRebuild || IndexedWorld.Get() != World)
+    {
+        Rebuild(World);
+    }
+
+    return World;
+}
+
+void FMCPActorIndex::Rebuild(UWorld* World)
+{
+    Entries.Reset();
+    ByName.Reset();
+    ByLabel.Reset();
+    SortedKeys.Reset();
+    NumDeadKeys = 0;
+
+    IndexedWorld = World;
+    bNeedsRebuild = false;
+
+    for (TActorIterator<AActor> It(World); It; ++It)
+    {
+        AddActor(*It);
+    }
+
+    UE_LOG(LogUnrealMCP, Verbose, TEXT("MCPActorIndex: Indexed %d actors in %s"), Entries.Num(), *World->GetName());
+}
+
+void FMCPActorIndex::AddActor(AActor* Actor)
+{
+    if (!IsValid(Actor) || Entries.Contains(Actor))
+    {
+        return;
+    }
+
+    FIndexedActor& Entry = Entries.Add(Actor);
+    Entry.Actor = Actor;
+    Entry.Name = Actor->GetFName();
+    Entry.Label = Actor->GetActorLabel();
+    Entry.Generation = NextGeneration++;
+
+    const FString NameString = Entry.Name.ToString();
+    ByName.Add(Entry.Name, Actor);
+    SortedKeys.Add({NameString, Actor, Entry.Generation});
+
+    // Most labels are just the name; only index the ones that differ
+    if (!Entry.Label.IsEmpty())
+    {
+        ByLabel.Add(Entry.Label, Actor);
+        if (!Entry.Label.Equals(NameString, ESearchCase::IgnoreCase))
+        {
+            SortedKeys.Add({Entry.Label, Actor, Entry.Generation});
+        }
+    }
+
+    bKeysNeedSort = true;
+}
+
+void FMCPActorIndex::RemoveActor(const AActor* Actor)
+{
+    FIndexedActor Entry;
+    if (!Entries.RemoveAndCopyValue(Actor, Entry))
+    {
+        return;
+    }
+
+    ByName.RemoveSingle(Entry.Name, Actor);
+    if (!Entry.Label.IsEmpty())
+    {
+        ByLabel.RemoveSingle(Entry.Label, Actor);
+    }
+
+    // Leave the sorted keys behind, dead, and drop them in bulk later; searching the list per removal made bulk deletes quadratic
+    const bool bLabelKeyed = !Entry.Label.IsEmpty() && !Entry.Label.Equals(Entry.Name.ToString(), ESearchCase::IgnoreCase);
+    NumDeadKeys += bLabelKeyed ? 2 : 1;
+}
+
+void FMCPActorIndex::CompactKeysIfNeeded()
+{
+    if (NumDeadKeys == 0 || NumDeadKeys * 4 < SortedKeys.Num())
+    {
+        return;
+    }
+
+    // Removing keeps the remaining keys in order, so no re-sort is needed
+    SortedKeys.RemoveAll([this](const FSortedKey& SortedKey)
+    {
+        return !IsLive(SortedKey);
+    });
+    NumDeadKeys = 0;
+}
+
+bool FMCPActorIndex::IsLive(const FSortedKey& SortedKey) const
+{
+    const FIndexedActor* Entry = Entries.Find(SortedKey.Actor);
+    return Entry && Entry->Generation == SortedKey.Generation;
+}
+
+void FMCPActorIndex::SortKeysIfNeeded()
+{
+    if (!bKeysNeedSort)
+    {
+        return;
+    }
+
+    SortedKeys.Sort([](const FSortedKey& A, const FSortedKey& B)
+    {
+        return A.Key.Compare(B.Key, ESearchCase::IgnoreCase) < 0;
+    });
+    bKeysNeedSort = false;
+}
+
+AActor* FMCPActorIndex::Resolve(const AActor* Key)
+{
+    const FIndexedActor* Entry = Entries.Find(Key);
+    if (!Entry)
+    {
+        return nullptr;
+    }
+
+    AActor* Actor = Entry->Actor.Get();
+    if (!IsValid(Actor) || Actor->GetWorld() != IndexedWorld.Get())
+    {
+        RemoveActor(Key);
+        return nullptr;
+    }
+
+    // Renamed without an event reaching us; index it under its current name and label
+    if (Actor->GetFName() != Entry->Name || !Actor->GetActorLabel().Equals(Entry->Label, ESearchCase::CaseSensitive))
+    {
+        RemoveActor(Key);
+        AddActor(Actor);
+    }
+
+    return Actor;
+}
+
+void FMCPActorIndex::OnActorAdded(AActor* Actor)
+{
+    if (!bNeedsRebuild && Actor && IndexedWorld.IsValid() && Actor->GetWorld() == IndexedWorld.Get())
+    {
+        AddActor(Actor);
+    }
+}
+
+void FMCPActorIndex::OnActorDeleted(AActor* Actor)
+{
+    if (!bNeedsRebuild)
+    {
+        RemoveActor(Actor);
+    }
+}
+
+void FMCPActorIndex::OnActorLabelChanged(AActor* Actor)
+{
+    if (bNeedsRebuild)
+    {
+        return;
+    }
+
+    // The editor may rename the object to follow the label, so re-key both
+    RemoveActor(Actor);
+    OnActorAdded(Actor);
+}
+
+void FMCPActorIndex::OnActorListChanged()
+{
+    // Level loads, undo and bulk edits land here without saying which actors changed
+    bNeedsRebuild = true;
+}
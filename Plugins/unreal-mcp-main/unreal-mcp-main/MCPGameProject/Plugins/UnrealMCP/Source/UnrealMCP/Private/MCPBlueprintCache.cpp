@@ -0,0 +1,268 @@
+#include "MCPBlueprintCache.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Editor.h"
+#include "Engine/Blueprint.h"
+#include "MCPLog.h"
+#include "Misc/PackageName.h"
+
+// Blueprints kept loaded between commands
+const int32 MCPBLUEPRINTCACHE_MAX_RESIDENT = 32;
+
+// Where blueprints were looked up before the cache existed; still preferred when names clash
+static const TCHAR* MCPBlueprintCacheLegacyRoot = TEXT("/Game/Blueprints/");
+
+FMCPBlueprintCache& FMCPBlueprintCache::Get()
+{
+    static FMCPBlueprintCache Cache;
+    return Cache;
+}
+
+FMCPBlueprintCache::FMCPBlueprintCache()
+    : bNeedsRebuild(true)
+{
+}
+
+void FMCPBlueprintCache::Start()
+{
+    if (!AssetAddedHandle.IsValid())
+    {
+        IAssetRegistry& AssetRegistry = FAssetRegistryModule::GetRegistry();
+        AssetAddedHandle = AssetRegistry.OnAssetAdded().AddRaw(this, &FMCPBlueprintCache::OnAssetAdded);
+        AssetRemovedHandle = AssetRegistry.OnAssetRemoved().AddRaw(this, &FMCPBlueprintCache::OnAssetRemoved);
+        AssetRenamedHandle = AssetRegistry.OnAssetRenamed().AddRaw(this, &FMCPBlueprintCache::OnAssetRenamed);
+        AssetsPreDeleteHandle = FEditorDelegates::OnAssetsPreDelete.AddRaw(this, &FMCPBlueprintCache::OnAssetsPreDelete);
+    }
+
+    bNeedsRebuild = true;
+}
+
+void FMCPBlueprintCache::Stop()
+{
+    if (AssetAddedHandle.IsValid())
+    {
+        // The registry may already be gone during editor shutdown
+        if (IAssetRegistry* AssetRegistry = IAssetRegistry::Get())
+        {
+            AssetRegistry->OnAssetAdded().Remove(AssetAddedHandle);
+            AssetRegistry->OnAssetRemoved().Remove(AssetRemovedHandle);
+            AssetRegistry->OnAssetRenamed().Remove(AssetRenamedHandle);
+        }
+        FEditorDelegates::OnAssetsPreDelete.Remove(AssetsPreDeleteHandle);
+    }
+
+    AssetAddedHandle.Reset();
+    AssetRemovedHandle.Reset();
+    AssetRenamedHandle.Reset();
+    AssetsPreDeleteHandle.Reset();
+
+    PathsByName.Reset();
+    Resident.Reset();
+    bNeedsRebuild = true;
+}
+
+UBlueprint* FMCPBlueprintCache::FindBlueprint(const FString& BlueprintName)
+{
+    check(IsInGameThread());
+
+    const FSoftObjectPath Path = ResolvePath(BlueprintName);
+    if (!Path.IsValid())
+    {
+        // The registry is still scanning, so a miss doesn't mean much yet
+        if (IAssetRegistry::GetChecked().IsLoadingAssets())
+        {
+            UBlueprint* Blueprint = LoadObject<UBlueprint>(nullptr, *(FString(MCPBlueprintCacheLegacyRoot) + BlueprintName));
+            if (Blueprint)
+            {
+                Touch(Blueprint);
+            }
+            return Blueprint;
+        }
+        return nullptr;
+    }
+
+    // Already in memory: a hash lookup with no package resolution
+    UBlueprint* Blueprint = Cast<UBlueprint>(Path.ResolveObject());
+    if (!Blueprint)
+    {
+        Blueprint = Cast<UBlueprint>(Path.TryLoad());
+    }
+
+    if (Blueprint)
+    {
+        Touch(Blueprint);
+    }
+
+    return Blueprint;
+}
+
+FSoftObjectPath FMCPBlueprintCache::ResolvePath(const FString& BlueprintName)
+{
+    if (BlueprintName.IsEmpty())
+    {
+        return FSoftObjectPath();
+    }
+
+    // Full path; "/Game/Props/BP_Door" is shorthand for "/Game/Props/BP_Door.BP_Door"
+    if (BlueprintName.StartsWith(TEXT("/")))
+    {
+        FString ObjectPath = BlueprintName;
+        if (!ObjectPath.Contains(TEXT(".")))
+        {
+            ObjectPath += TEXT(".") + FPackageName::GetShortName(ObjectPath);
+        }
+        return FSoftObjectPath(ObjectPath);
+    }
+
+    // Relative paths have always meant relative to /Game/Blueprints
+    if (BlueprintName.Contains(TEXT("/")))
+    {
+        return ResolvePath(MCPBlueprintCacheLegacyRoot + BlueprintName);
+    }
+
+    Refresh();
+
+    // A name missing from the name table can't belong to any asset
+    const FName AssetName(*BlueprintName, FNAME_Find);
+    const TArray<FSoftObjectPath, TInlineAllocator<1>>* Paths = AssetName.IsNone() ? nullptr : PathsByName.Find(AssetName);
+    if (!Paths || Paths->Num() == 0)
+    {
+        return FSoftObjectPath();
+    }
+
+    if (Paths->Num() > 1)
+    {
+        for (const FSoftObjectPath& Path : *Paths)
+        {
+            if (Path.GetLongPackageName().StartsWith(MCPBlueprintCacheLegacyRoot))
+            {
+                return Path;
+            }
+        }
+
+        UE_LOG(LogUnrealMCP, Warning, TEXT("MCPBlueprintCache: %d blueprints are named '%s', using %s. Pass a full path to pick another"),
+            Paths->Num(), *BlueprintName, *(*Paths)[0].ToString());
+    }
+
+    return (*Paths)[0];
+}
+
+void FMCPBlueprintCache::Refresh()
+{
+    if (!bNeedsRebuild)
+    {
+        return;
+    }
+
+    PathsByName.Reset();
+    bNeedsRebuild = false;
+
+    // Widget and animation blueprints are blueprints too, so include subclasses
+    TArray<FAssetData> Assets;
+    IAssetRegistry::GetChecked().GetAssetsByClass(UBlueprint::StaticClass()->GetClassPathName(), Assets, true);
+
+    PathsByName.Reserve(Assets.Num());
+    for (const FAssetData& AssetData : Assets)
+    {
+        PathsByName.FindOrAdd(AssetData.AssetName).AddUnique(AssetData.GetSoftObjectPath());
+    }
+
+    UE_LOG(LogUnrealMCP, Verbose, TEXT("MCPBlueprintCache: Indexed %d blueprints"), Assets.Num());
+}
+
+void FMCPBlueprintCache::AddAsset(const FAssetData& AssetData)
+{
+    if (AssetData.IsInstanceOf(UBlueprint::StaticClass()))
+    {
+        PathsByName.FindOrAdd(AssetData.AssetName).AddUnique(AssetData.GetSoftObjectPath());
+    }
+}
+
+void FMCPBlueprintCache::RemovePath(FName AssetName, const FSoftObjectPath& Path)
+{
+    if (TArray<FSoftObjectPath, TInlineAllocator<1>>* Paths = PathsByName.Find(AssetName))
+    {
+        Paths->Remove(Path);
+        if (Paths->Num() == 0)
+        {
+            PathsByName.Remove(AssetName);
+        }
+    }
+}
+
+void FMCPBlueprintCache::Touch(UBlueprint* Blueprint)
+{
+    // Small list, so a linear search is cheaper than keeping a map in step
+    const int32 Index = Resident.IndexOfByPredicate([Blueprint](const TStrongObjectPtr<UBlueprint>& Entry)
+    {
+        return Entry.Get() == Blueprint;
+    });
+
+    if (Index != INDEX_NONE)
+    {
+        if (Index == Resident.Num() - 1)
+        {
+            return;
+        }
+
+        TStrongObjectPtr<UBlueprint> Entry = MoveTemp(Resident[Index]);
+        Resident.RemoveAt(Index, 1, EAllowShrinking::No);
+        Resident.Add(MoveTemp(Entry));
+        return;
+    }
+
+    if (Resident.Num() >= MCPBLUEPRINTCACHE_MAX_RESIDENT)
+    {
+        Resident.RemoveAt(0, 1, EAllowShrinking::No);
+    }
+    Resident.Emplace(Blueprint);
+}
+
+void FMCPBlueprintCache::Evict(const FSoftObjectPath& Path)
+{
+    Resident.RemoveAll([&Path](const TStrongObjectPtr<UBlueprint>& Entry)
+    {
+        return !Entry.IsValid() || FSoftObjectPath(Entry.Get()) == Path;
+    });
+}
+
+void FMCPBlueprintCache::OnAssetAdded(const FAssetData& AssetData)
+{
+    if (!bNeedsRebuild)
+    {
+        AddAsset(AssetData);
+    }
+}
+
+void FMCPBlueprintCache::OnAssetRemoved(const FAssetData& AssetData)
+{
+    const FSoftObjectPath Path = AssetData.GetSoftObjectPath();
+    Evict(Path);
+
+    if (!bNeedsRebuild)
+    {
+        RemovePath(AssetData.AssetName, Path);
+    }
+}
+
+void FMCPBlueprintCache::OnAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath)
+{
+    if (bNeedsRebuild)
+    {
+        return;
+    }
+
+    // The loaded object moves with the rename, so anything resident stays valid
+    const FSoftObjectPath OldPath(OldObjectPath);
+    RemovePath(FName(*OldPath.GetAssetName()), OldPath);
+    AddAsset(AssetData);
+}
+
+void FMCPBlueprintCache::OnAssetsPreDelete(const TArray<UObject*>& Objects)
+{
+    // Our references would otherwise show up as "in use" in the delete dialog
+    Resident.RemoveAll([&Objects](const TStrongObjectPtr<UBlueprint>& Entry)
+    {
+        return !Entry.IsValid() || Objects.Contains(Entry.Get());
+    });
+}
@@ -0,0 +1,310 @@
+#include "MCPBlueprintCompileQueue.h"
+#include "Dom/JsonValue.h"
+#include "EditorAssetLibrary.h"
+#include "Engine/Blueprint.h"
+#include "HAL/PlatformTime.h"
+#include "Kismet2/BlueprintEditorUtils.h"
+#include "Kismet2/CompilerResultsLog.h"
+#include "Kismet2/KismetEditorUtilities.h"
+#include "MCPLog.h"
+
+// Depth-first walk that appends a blueprint after every pending blueprint it depends on.
+// A blueprint already visited is skipped, which also breaks dependency cycles.
+static void AddInDependencyOrder(UBlueprint* Blueprint, const TSet<UBlueprint*>& Pending, TSet<UBlueprint*>& Visited, TArray<UBlueprint*>& OutOrder)
+{
+    bool bAlreadyVisited = false;
+    Visited.Add(Blueprint, &bAlreadyVisited);
+    if (bAlreadyVisited)
+    {
+        return;
+    }
+
+    // A child's generated class is built on its parent's, so the parent goes first
+    if (UBlueprint* ParentBlueprint = UBlueprint::GetBlueprintFromClass(Blueprint->ParentClass))
+    {
+        if (Pending.Contains(ParentBlueprint))
+        {
+            AddInDependencyOrder(ParentBlueprint, Pending, Visited, OutOrder);
+        }
+    }
+
+    TSet<TWeakObjectPtr<UBlueprint>> Dependencies;
+    TSet<TWeakObjectPtr<UStruct>> StructDependencies;
+    FBlueprintEditorUtils::GatherDependencies(Blueprint, Dependencies, StructDependencies);
+    for (const TWeakObjectPtr<UBlueprint>& Dependency : Dependencies)
+    {
+        UBlueprint* DependencyBlueprint = Dependency.Get();
+        if (DependencyBlueprint && Pending.Contains(DependencyBlueprint))
+        {
+            AddInDependencyOrder(DependencyBlueprint, Pending, Visited, OutOrder);
+        }
+    }
+
+    OutOrder.Add(Blueprint);
+}
+
+static const TCHAR* BlueprintStatusToString(EBlueprintStatus Status)
+{
+    switch (Status)
+    {
+    case BS_UpToDate:
+        return TEXT("up_to_date");
+    case BS_UpToDateWithWarnings:
+        return TEXT("warnings");
+    case BS_Error:
+        return TEXT("error");
+    case BS_Dirty:
+        return TEXT("dirty");
+    default:
+        return TEXT("unknown");
+    }
+}
+
+FMCPBlueprintCompileQueue& FMCPBlueprintCompileQueue::Get()
+{
+    static FMCPBlueprintCompileQueue Queue;
+    return Queue;
+}
+
+FMCPBlueprintCompileQueue::FMCPBlueprintCompileQueue()
+    : CurrentClient(NoClient)
+{
+}
+
+FMCPBlueprintCompileQueue::FScopedClient::FScopedClient(int32 Client)
+    : PreviousClient(NoClient)
+    , bActive(IsInGameThread())
+{
+    if (bActive)
+    {
+        FMCPBlueprintCompileQueue& Queue = FMCPBlueprintCompileQueue::Get();
+        PreviousClient = Queue.CurrentClient;
+        Queue.CurrentClient = Client;
+    }
+}
+
+FMCPBlueprintCompileQueue::FScopedClient::~FScopedClient()
+{
+    if (bActive)
+    {
+        FMCPBlueprintCompileQueue::Get().CurrentClient = PreviousClient;
+    }
+}
+
+void FMCPBlueprintCompileQueue::BeginSession()
+{
+    check(IsInGameThread());
+    ++Sessions.FindOrAdd(CurrentClient).Depth;
+}
+
+TSharedPtr<FJsonObject> FMCPBlueprintCompileQueue::EndSession()
+{
+    check(IsInGameThread());
+
+    FClientSession* Session = Sessions.Find(CurrentClient);
+    if (!Session)
+    {
+        return nullptr;
+    }
+
+    --Session->Depth;
+    if (Session->Depth > 0)
+    {
+        // An outer session is still open; it will do the compiling
+        TSharedPtr<FJsonObject> Report = MakeShared<FJsonObject>();
+        Report->SetArrayField(TEXT("blueprints"), TArray<TSharedPtr<FJsonValue>>());
+        Report->SetNumberField(TEXT("compiled"), 0);
+        Report->SetNumberField(TEXT("failed"), 0);
+        Report->SetNumberField(TEXT("total_ms"), 0.0);
+        Report->SetNumberField(TEXT("pending"), Session->Dirty.Num());
+        return Report;
+    }
+
+    FClientSession Ended = MoveTemp(*Session);
+    Sessions.Remove(CurrentClient);
+    return CompileDirty(Ended);
+}
+
+TSharedPtr<FJsonObject> FMCPBlueprintCompileQueue::Flush()
+{
+    check(IsInGameThread());
+
+    if (FClientSession* Session = Sessions.Find(CurrentClient))
+    {
+        return CompileDirty(*Session);
+    }
+
+    FClientSession NoSession;
+    return CompileDirty(NoSession);
+}
+
+void FMCPBlueprintCompileQueue::EndClient(int32 Client)
+{
+    check(IsInGameThread());
+
+    FClientSession Session;
+    if (!Sessions.RemoveAndCopyValue(Client, Session))
+    {
+        return;
+    }
+
+    UE_LOG(LogUnrealMCP, Warning, TEXT("MCPBlueprintCompileQueue: Client %d disconnected with an edit session open, compiling its %d blueprints"),
+        Client, Session.Dirty.Num());
+    CompileDirty(Session);
+}
+
+TSharedPtr<FJsonObject> FMCPBlueprintCompileQueue::CompileDirty(FClientSession& Session)
+{
+    TArray<UBlueprint*> Pending;
+    Pending.Reserve(Session.Dirty.Num());
+    for (const TWeakObjectPtr<UBlueprint>& DirtyBlueprint : Session.Dirty)
+    {
+        if (UBlueprint* Blueprint = DirtyBlueprint.Get())
+        {
+            Pending.Add(Blueprint);
+        }
+    }
+    Session.Dirty.Reset();
+
+    const TSet<UBlueprint*> PendingSet(Pending);
+    TSet<UBlueprint*> Visited;
+    TArray<UBlueprint*> Order;
+    Order.Reserve(Pending.Num());
+    for (UBlueprint* Blueprint : Pending)
+    {
+        AddInDependencyOrder(Blueprint, PendingSet, Visited, Order);
+    }
+
+    TArray<TSharedPtr<FJsonValue>> Entries;
+    Entries.Reserve(Order.Num());
+    int32 NumFailed = 0;
+    double TotalMilliseconds = 0.0;
+
+    for (UBlueprint* Blueprint : Order)
+    {
+        TSharedPtr<FJsonObject> Entry = CompileNow(Blueprint);
+        TotalMilliseconds += Entry->GetNumberField(TEXT("ms"));
+        if (Blueprint->Status == BS_Error)
+        {
+            ++NumFailed;
+        }
+        Entries.Add(MakeShared<FJsonValueObject>(Entry));
+    }
+
+    if (Order.Num() > 0)
+    {
+        UE_LOG(LogUnrealMCP, Display, TEXT("MCPBlueprintCompileQueue: Compiled %d blueprints in %.1f ms, %d failed"), Order.Num(), TotalMilliseconds, NumFailed);
+    }
+
+    // Saves held back until their blueprint compiled
+    int32 NumSaved = 0;
+    for (const TWeakObjectPtr<UBlueprint>& SaveBlueprint : Session.NeedsSave)
+    {
+        if (UBlueprint* Blueprint = SaveBlueprint.Get())
+        {
+            NumSaved += UEditorAssetLibrary::SaveLoadedAsset(Blueprint, false) ? 1 : 0;
+        }
+    }
+    Session.NeedsSave.Reset();
+
+    TSharedPtr<FJsonObject> Report = MakeShared<FJsonObject>();
+    Report->SetArrayField(TEXT("blueprints"), Entries);
+    Report->SetNumberField(TEXT("compiled"), Order.Num());
+    Report->SetNumberField(TEXT("failed"), NumFailed);
+    Report->SetNumberField(TEXT("total_ms"), TotalMilliseconds);
+    Report->SetNumberField(TEXT("saved"), NumSaved);
+    Report->SetNumberField(TEXT("pending"), 0);
+    return Report;
+}
+
+bool FMCPBlueprintCompileQueue::IsSessionOpen() const
+{
+    const FClientSession* Session = Sessions.Find(CurrentClient);
+    return Session && Session->Depth > 0;
+}
+
+int32 FMCPBlueprintCompileQueue::NumDirty() const
+{
+    const FClientSession* Session = Sessions.Find(CurrentClient);
+    return Session ? Session->Dirty.Num() : 0;
+}
+
+bool FMCPBlueprintCompileQueue::RequestCompile(UBlueprint* Blueprint)
+{
+    if (!Blueprint)
+    {
+        return false;
+    }
+
+    if (IsSessionOpen())
+    {
+        MarkDirty(Blueprint);
+        return false;
+    }
+
+    FKismetEditorUtilities::CompileBlueprint(Blueprint);
+    return true;
+}
+
+bool FMCPBlueprintCompileQueue::RequestCompileAndSave(UBlueprint* Blueprint)
+{
+    if (!Blueprint)
+    {
+        return false;
+    }
+
+    if (!RequestCompile(Blueprint))
+    {
+        // Deferred: CompileDirty saves it after the session compiles it
+        Sessions.FindChecked(CurrentClient).NeedsSave.AddUnique(Blueprint);
+        return false;
+    }
+
+    return UEditorAssetLibrary::SaveLoadedAsset(Blueprint, false);
+}
+
+void FMCPBlueprintCompileQueue::MarkDirty(UBlueprint* Blueprint)
+{
+    check(IsInGameThread());
+
+    FClientSession* Session = Sessions.Find(CurrentClient);
+    if (Blueprint && Session)
+    {
+        Session->Dirty.AddUnique(Blueprint);
+    }
+}
+
+TSharedPtr<FJsonObject> FMCPBlueprintCompileQueue::CompileNow(UBlueprint* Blueprint)
+{
+    FCompilerResultsLog Results;
+
+    const double StartTime = FPlatformTime::Seconds();
+    FKismetEditorUtilities::CompileBlueprint(Blueprint, EBlueprintCompileOptions::None, &Results);
+    const double Milliseconds = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+    TSharedPtr<FJsonObject> Entry = MakeShared<FJsonObject>();
+    Entry->SetStringField(TEXT("name"), Blueprint->GetName());
+    Entry->SetStringField(TEXT("path"), Blueprint->GetPathName());
+    Entry->SetStringField(TEXT("status"), BlueprintStatusToString(Blueprint->Status));
+    Entry->SetNumberField(TEXT("errors"), Results.NumErrors);
+    Entry->SetNumberField(TEXT("warnings"), Results.NumWarnings);
+    Entry->SetNumberField(TEXT("ms"), Milliseconds);
+    return Entry;
+}
+
+void FMCPBlueprintCompileQueue::Reset()
+{
+    int32 NumDirty = 0;
+    for (const TPair<int32, FClientSession>& Pair : Sessions)
+    {
+        NumDirty += Pair.Value.Dirty.Num();
+    }
+
+    if (NumDirty > 0)
+    {
+        UE_LOG(LogUnrealMCP, Warning, TEXT("MCPBlueprintCompileQueue: Edit sessions closed with %d blueprints left uncompiled"), NumDirty);
+    }
+
+    Sessions.Reset();
+    CurrentClient = NoClient;
+}
@@ -0,0 +1,491 @@
+#include "MCPClientSession.h"
+#include "MCPBlueprintCompileQueue.h"
+#include "MCPCommandRegistry.h"
+#include "MCPLog.h"
+#include "MCPServerStats.h"
+#include "UnrealMCPBridge.h"
+#include "HAL/Event.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/RunnableThread.h"
+#include "Async/Future.h"
+#include "Misc/ScopeLock.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonReader.h"
+
+// Buffer size for receiving data. Larger messages are assembled by the framer.
+const int32 MCPSESSION_RECV_BUFFER_SIZE = 65536;
+
+// How long a blocked wait may last before the session checks whether it should stop
+const FTimespan MCPSESSION_WAIT_TIMEOUT = FTimespan::FromMilliseconds(250);
+
+// Pipelined requests a single client may have in flight before we stop reading from it
+const int32 MCPSESSION_MAX_IN_FLIGHT = 64;
+
+FMCPSessionChannel::FMCPSessionChannel(TUniquePtr<IMCPConnection>&& InConnection)
+    : Connection(MoveTemp(InConnection))
+    , SharedMemoryThreshold(0)
+    , bClosing(false)
+    , Mode(EMCPFramingMode::Newline)
+    , NumInFlight(0)
+    , CompletionEvent(FPlatformProcess::GetSynchEventFromPool(false))
+{
+}
+
+FMCPSessionChannel::~FMCPSessionChannel()
+{
+    Close();
+    FPlatformProcess::ReturnSynchEventToPool(CompletionEvent);
+    CompletionEvent = nullptr;
+}
+
+bool FMCPSessionChannel::SendResponse(const TSharedPtr<FJsonObject>& Response, const TSharedPtr<FJsonValue>& RequestId, const FMCPResponseFormat& Format, const FString& CommandType)
+{
+    if (RequestId.IsValid())
+    {
+        Response->SetField(TEXT("id"), RequestId);
+    }
+
+    // Encode straight into the bytes that get framed, so there's no FString or UTF-8 conversion pass
+    const double SerializeStartTime = FPlatformTime::Seconds();
+    TArray<uint8> Payload;
+    const int32 NumAllocations = FMCPResponseEncoder::Encode(*Response, Format, Payload);
+    if (!CommandType.IsEmpty())
+    {
+        FMCPServerStats& Stats = FMCPServerStats::Get();
+        Stats.RecordStage(CommandType, EMCPRequestStage::Serialize, FPlatformTime::Seconds() - SerializeStartTime);
+        Stats.RecordAllocations(CommandType, NumAllocations);
+    }
+
+    return SendEncoded(Payload, Format.IsBinary(), CommandType);
+}
+
+bool FMCPSessionChannel::SendStreamedResponse(const FMCPResultWriter& Result, const TSharedPtr<FJsonValue>& RequestId, const FMCPResponseFormat& Format, const FString& CommandType)
+{
+    // The result is already encoded, so this only adds the envelope around it
+    const double SerializeStartTime = FPlatformTime::Seconds();
+    TArray<uint8> Payload;
+    const int32 NumAllocations = FMCPResponseEncoder::EncodeStreamed(Result, RequestId, Format, Payload);
+    if (!CommandType.IsEmpty())
+    {
+        FMCPServerStats& Stats = FMCPServerStats::Get();
+        Stats.RecordStage(CommandType, EMCPRequestStage::Serialize, FPlatformTime::Seconds() - SerializeStartTime);
+        Stats.RecordAllocations(CommandType, NumAllocations);
+    }
+
+    return SendEncoded(Payload, Format.IsBinary(), CommandType);
+}
+
+bool FMCPSessionChannel::SendEncoded(const TArray<uint8>& Payload, bool bBinary, const FString& CommandType)
+{
+    const double SendStartTime = FPlatformTime::Seconds();
+
+    if (!bBinary)
+    {
+        MCPLogPayload(TEXT("MCPSessionChannel: Sending"), Payload.GetData(), Payload.Num());
+    }
+
+    // One writer at a time so frames from different threads never interleave
+    FScopeLock Lock(&SendLock);
+
+    if (!Connection)
+    {
+        return false;
+    }
+
+    // Large responses go through shared memory and the socket only carries where to find them
+    TArray<uint8> Frame;
+    uint64 SharedMemoryOffset = 0;
+    if (SharedMemory && Payload.Num() >= SharedMemoryThreshold && SharedMemory->Write(Payload.GetData(), Payload.Num(), SharedMemoryOffset))
+    {
+        const FTCHARToUTF8 Stub(*FString::Printf(TEXT("{\"shm\":{\"offset\":%llu,\"length\":%d}}"), SharedMemoryOffset, Payload.Num()));
+        FMCPMessageFramer::FrameResponse(Mode, reinterpret_cast<const uint8*>(Stub.Get()), Stub.Length(), Frame);
+    }
+    else
+    {
+        FMCPMessageFramer::FrameResponse(Mode, Payload.GetData(), Payload.Num(), Frame);
+    }
+
+    UE_LOG(LogUnrealMCP, Verbose, TEXT("MCPSessionChannel: Sending response (%d bytes)"), Frame.Num());
+    const bool bSent = SendAll(Frame.GetData(), Frame.Num());
+
+    FMCPServerStats& Stats = FMCPServerStats::Get();
+    Stats.AddBytesOut(Frame.Num());
+    if (!CommandType.IsEmpty())
+    {
+        Stats.RecordStage(CommandType, EMCPRequestStage::Send, FPlatformTime::Seconds() - SendStartTime);
+    }
+    return bSent;
+}
+
+void FMCPSessionChannel::Close()
+{
+    // Let a sender stuck waiting on a full socket give up before we take the lock
+    bClosing = true;
+
+    FScopeLock Lock(&SendLock);
+
+    if (Connection)
+    {
+        Connection->Close();
+    }
+    SharedMemory.Reset();
+}
+
+bool FMCPSessionChannel::OpenSharedMemory(const FString& Name, int64 Capacity, int32 Threshold, FString& OutError)
+{
+    FScopeLock Lock(&SendLock);
+
+    if (!Connection || !Connection->SupportsSharedMemory())
+    {
+        OutError = TEXT("Shared memory needs a Unix socket connection");
+        return false;
+    }
+
+    if (SharedMemory)
+    {
+        OutError = TEXT("Shared memory is already open on this connection");
+        return false;
+    }
+
+    SharedMemory = FMCPSharedMemoryRing::Create(Name, Capacity, OutError);
+    SharedMemoryThreshold = Threshold;
+    return SharedMemory.IsValid();
+}
+
+void FMCPSessionChannel::EndRequest()
+{
+    --NumInFlight;
+    CompletionEvent->Trigger();
+}
+
+void FMCPSessionChannel::WaitForCompletion(const FTimespan& Timeout)
+{
+    CompletionEvent->Wait(Timeout);
+}
+
+bool FMCPSessionChannel::SendAll(const uint8* Data, int32 Count)
+{
+    // Large responses may go out in several pieces
+    int32 TotalSent = 0;
+    while (TotalSent < Count && !bClosing)
+    {
+        int32 BytesSent = 0;
+        const EMCPIoResult Result = Connection->Send(Data + TotalSent, Count - TotalSent, BytesSent);
+        if (Result == EMCPIoResult::Ok)
+        {
+            TotalSent += BytesSent;
+        }
+        else if (Result == EMCPIoResult::WouldBlock)
+        {
+            Connection->WaitForWrite(MCPSESSION_WAIT_TIMEOUT);
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    return TotalSent == Count;
+}
+
+FMCPClientSession::FMCPClientSession(UUnrealMCPBridge* InBridge, TUniquePtr<IMCPConnection>&& InConnection, int32 InSessionId, const FMCPTransportConfig& InConfig)
+    : Bridge(InBridge)
+    , Connection(InConnection.Get())
+    , Thread(nullptr)
+    , SessionId(InSessionId)
+    , Config(InConfig)
+    , Channel(MakeShared<FMCPSessionChannel, ESPMode::ThreadSafe>(MoveTemp(InConnection)))
+    , bRunning(true)
+    , bFinished(false)
+{
+}
+
+FMCPClientSession::~FMCPClientSession()
+{
+    // Join the thread before the connection goes away
+    if (Thread)
+    {
+        Thread->Kill(true);
+        delete Thread;
+        Thread = nullptr;
+    }
+
+    // Commands still in flight keep the channel alive but can no longer write to the connection
+    Channel->Close();
+    Connection = nullptr;
+}
+
+bool FMCPClientSession::Start()
+{
+    Thread = FRunnableThread::Create(this, *FString::Printf(TEXT("UnrealMCPSession%d"), SessionId), 0, TPri_Normal);
+    if (!Thread)
+    {
+        bFinished = true;
+        return false;
+    }
+
+    return true;
+}
+
+uint32 FMCPClientSession::Run()
+{
+    UE_LOG(LogUnrealMCP, Display, TEXT("MCPClientSession %d: Started"), SessionId);
+    FMCPServerStats::Get().SessionOpened();
+
+    TArray<uint8> RecvBuffer;
+    RecvBuffer.SetNumUninitialized(MCPSESSION_RECV_BUFFER_SIZE);
+    TArray<uint8> Message;
+
+    while (bRunning)
+    {
+        // Sleep in the kernel until the client sends something
+        if (!Connection->WaitForRead(MCPSESSION_WAIT_TIMEOUT))
+        {
+            if (Connection->IsConnectionLost())
+            {
+                UE_LOG(LogUnrealMCP, Display, TEXT("MCPClientSession %d: Connection lost"), SessionId);
+                break;
+            }
+            continue;
+        }
+
+        int32 BytesRead = 0;
+        const EMCPIoResult Result = Connection->Recv(RecvBuffer.GetData(), RecvBuffer.Num(), BytesRead);
+        if (Result == EMCPIoResult::WouldBlock)
+        {
+            continue;
+        }
+
+        if (Result == EMCPIoResult::Error)
+        {
+            UE_LOG(LogUnrealMCP, Display, TEXT("MCPClientSession %d: Client disconnected or error"), SessionId);
+            break;
+        }
+
+        if (Result == EMCPIoResult::Closed)
+        {
+            UE_LOG(LogUnrealMCP, Display, TEXT("MCPClientSession %d: Client disconnected (zero bytes)"), SessionId);
+            break;
+        }
+
+        FMCPServerStats::Get().AddBytesIn(BytesRead);
+        Framer.Append(RecvBuffer.GetData(), BytesRead);
+
+        // Handle every complete message buffered so far
+        while (bRunning && Framer.PopMessage(Message))
+        {
+            Channel->SetFramingMode(Framer.GetMode());
+            ProcessMessage(Message);
+        }
+
+        if (Framer.HasError())
+        {
+            UE_LOG(LogUnrealMCP, Warning, TEXT("MCPClientSession %d: Dropping client, framing error: %s"), SessionId, *Framer.GetError());
+            break;
+        }
+    }
+
+    // Don't let a blueprint edit session this client left open defer compiles forever
+    const int32 ClientId = SessionId;
+    FMCPGameThreadQueue::Enqueue([ClientId]()
+    {
+        FMCPBlueprintCompileQueue::Get().EndClient(ClientId);
+    });
+
+    UE_LOG(LogUnrealMCP, Display, TEXT("MCPClientSession %d: Finished"), SessionId);
+    FMCPServerStats::Get().SessionClosed();
+    bFinished = true;
+    return 0;
+}
+
+void FMCPClientSession::Stop()
+{
+    bRunning = false;
+}
+
+void FMCPClientSession::ProcessMessage(const TArray<uint8>& Message)
+{
+    FMCPServerStats::Get().AddMessageIn();
+    MCPLogPayload(TEXT("MCPClientSession: Received"), Message.GetData(), Message.Num());
+
+    // Parse straight from the UTF-8 bytes without converting to an FString first
+    TSharedPtr<FJsonObject> JsonMessage;
+    TSharedRef<TJsonReader<UTF8CHAR>> Reader = TJsonReaderFactory<UTF8CHAR>::CreateFromView(
+        FUtf8StringView(reinterpret_cast<const UTF8CHAR*>(Message.GetData()), Message.Num()));
+
+    if (!FJsonSerializer::Deserialize(Reader, JsonMessage) || !JsonMessage.IsValid())
+    {
+        UE_LOG(LogUnrealMCP, Warning, TEXT("MCPClientSession %d: Failed to parse message as JSON (%d bytes)"), SessionId, Message.Num());
+        SendError(TEXT("Failed to parse message as JSON"), nullptr);
+        return;
+    }
+
+    // Optional request id, echoed back on the response
+    TSharedPtr<FJsonValue> RequestId = JsonMessage->TryGetField(TEXT("id"));
+
+    // Accept both the legacy "type" field and the MCP protocol "command" field
+    FString CommandType;
+    if (!JsonMessage->TryGetStringField(TEXT("type"), CommandType) && !JsonMessage->TryGetStringField(TEXT("command"), CommandType))
+    {
+        UE_LOG(LogUnrealMCP, Warning, TEXT("MCPClientSession %d: Message missing 'type' field"), SessionId);
+        SendError(TEXT("Message missing 'type' field"), RequestId);
+        return;
+    }
+
+    // Parameters are optional
+    TSharedPtr<FJsonObject> Params = MakeShareable(new FJsonObject());
+    const TSharedPtr<FJsonObject>* ParamsObject = nullptr;
+    if (JsonMessage->TryGetObjectField(TEXT("params"), ParamsObject))
+    {
+        Params = *ParamsObject;
+    }
+
+    UE_LOG(LogUnrealMCP, Verbose, TEXT("MCPClientSession %d: Executing command: %s"), SessionId, *CommandType);
+
+    if (CommandType == TEXT("open_shared_memory"))
+    {
+        OpenSharedMemory(RequestId);
+        return;
+    }
+
+    if (CommandType == TEXT("set_encoding"))
+    {
+        SetEncoding(Params, RequestId);
+        return;
+    }
+
+    // The request may ask for its own response format, otherwise the connection's is used
+    FMCPResponseFormat Format = DefaultFormat;
+    FString FormatError;
+    if (!Format.ParseFrom(*JsonMessage, FormatError))
+    {
+        SendError(FormatError, RequestId);
+        return;
+    }
+
+    if (Format.IsBinary() && Framer.GetMode() != EMCPFramingMode::LengthPrefixed)
+    {
+        SendError(TEXT("Binary encodings and compression need length-prefixed framing"), RequestId);
+        return;
+    }
+
+    // Without an id the client can't match responses to requests, so answer in order
+    if (!RequestId.IsValid())
+    {
+        TSharedRef<TPromise<TSharedPtr<FJsonObject>>, ESPMode::ThreadSafe> Promise = MakeShared<TPromise<TSharedPtr<FJsonObject>>, ESPMode::ThreadSafe>();
+        TFuture<TSharedPtr<FJsonObject>> Future = Promise->GetFuture();
+        TSharedPtr<FMCPResultWriter, ESPMode::ThreadSafe> ResultWriter = MakeShared<FMCPResultWriter, ESPMode::ThreadSafe>(Format.Encoding);
+        Bridge->ExecuteCommandAsync(CommandType, Params, SessionId, ResultWriter, [Promise](TSharedPtr<FJsonObject> Response)
+        {
+            Promise->SetValue(Response);
+        });
+
+        // Wait in slices so stopping the server isn't held up by a slow command
+        while (!Future.WaitFor(MCPSESSION_WAIT_TIMEOUT))
+        {
+            if (!bRunning)
+            {
+                return;
+            }
+        }
+
+        const TSharedPtr<FJsonObject> Response = Future.Get();
+        const bool bSent = Response.IsValid()
+            ? Channel->SendResponse(Response, nullptr, Format, CommandType)
+            : Channel->SendStreamedResponse(*ResultWriter, nullptr, Format, CommandType);
+        if (!bSent)
+        {
+            UE_LOG(LogUnrealMCP, Warning, TEXT("MCPClientSession %d: Failed to send response"), SessionId);
+        }
+        return;
+    }
+
+    // Stop reading more work from this client until some of its requests finish
+    while (bRunning && Channel->GetNumInFlight() >= MCPSESSION_MAX_IN_FLIGHT)
+    {
+        Channel->WaitForCompletion(MCPSESSION_WAIT_TIMEOUT);
+    }
+
+    Channel->BeginRequest();
+
+    TSharedRef<FMCPSessionChannel, ESPMode::ThreadSafe> RequestChannel = Channel;
+    TSharedPtr<FMCPResultWriter, ESPMode::ThreadSafe> ResultWriter = MakeShared<FMCPResultWriter, ESPMode::ThreadSafe>(Format.Encoding);
+    Bridge->ExecuteCommandAsync(CommandType, Params, SessionId, ResultWriter, [RequestChannel, RequestId, Format, CommandType, ResultWriter](TSharedPtr<FJsonObject> Response)
+    {
+        if (Response.IsValid())
+        {
+            RequestChannel->SendResponse(Response, RequestId, Format, CommandType);
+        }
+        else
+        {
+            RequestChannel->SendStreamedResponse(*ResultWriter, RequestId, Format, CommandType);
+        }
+        RequestChannel->EndRequest();
+    });
+}
+
+void FMCPClientSession::SendError(const FString& Error, const TSharedPtr<FJsonValue>& RequestId)
+{
+    TSharedPtr<FJsonObject> Response = MakeShareable(new FJsonObject());
+    Response->SetStringField(TEXT("status"), TEXT("error"));
+    Response->SetStringField(TEXT("error"), Error);
+    Channel->SendResponse(Response, RequestId, DefaultFormat);
+}
+
+void FMCPClientSession::OpenSharedMemory(const TSharedPtr<FJsonValue>& RequestId)
+{
+    if (Config.SharedMemoryBytes <= 0)
+    {
+        SendError(TEXT("Shared memory is disabled in the Unreal MCP settings"), RequestId);
+        return;
+    }
+
+    // Unique per editor process and session, so concurrent editors and clients never collide
+    const FString Name = FString::Printf(TEXT("/unreal_mcp_%u_%d"), FPlatformProcess::GetCurrentProcessId(), SessionId);
+    FString Error;
+    if (!Channel->OpenSharedMemory(Name, Config.SharedMemoryBytes, Config.SharedMemoryThreshold, Error))
+    {
+        SendError(Error, RequestId);
+        return;
+    }
+
+    TSharedPtr<FJsonObject> Result = MakeShareable(new FJsonObject());
+    Result->SetStringField(TEXT("name"), Name);
+    Result->SetNumberField(TEXT("capacity"), static_cast<double>(Config.SharedMemoryBytes));
+    Result->SetNumberField(TEXT("threshold"), Config.SharedMemoryThreshold);
+
+    TSharedPtr<FJsonObject> Response = MakeShareable(new FJsonObject());
+    Response->SetStringField(TEXT("status"), TEXT("success"));
+    Response->SetObjectField(TEXT("result"), Result);
+    Channel->SendResponse(Response, RequestId, DefaultFormat);
+}
+
+void FMCPClientSession::SetEncoding(const TSharedPtr<FJsonObject>& Params, const TSharedPtr<FJsonValue>& RequestId)
+{
+    FMCPResponseFormat Format = DefaultFormat;
+    FString Error;
+    if (!Format.ParseFrom(*Params, Error))
+    {
+        SendError(Error, RequestId);
+        return;
+    }
+
+    // Newline framing ends a message at a newline byte, which binary payloads may contain
+    if (Format.IsBinary() && Framer.GetMode() != EMCPFramingMode::LengthPrefixed)
+    {
+        SendError(TEXT("Binary encodings and compression need length-prefixed framing"), RequestId);
+        return;
+    }
+
+    UE_LOG(LogUnrealMCP, Verbose, TEXT("MCPClientSession %d: Responses now use %s, compression %s"), SessionId,
+        FMCPResponseFormat::GetEncodingName(Format.Encoding), FMCPResponseFormat::GetCompressionName(Format.Compression));
+
+    // The acknowledgement already uses the new format
+    DefaultFormat = Format;
+
+    TSharedPtr<FJsonObject> Response = MakeShareable(new FJsonObject());
+    Response->SetStringField(TEXT("status"), TEXT("success"));
+    Response->SetObjectField(TEXT("result"), Format.ToJson());
+    Channel->SendResponse(Response, RequestId, DefaultFormat);
+}
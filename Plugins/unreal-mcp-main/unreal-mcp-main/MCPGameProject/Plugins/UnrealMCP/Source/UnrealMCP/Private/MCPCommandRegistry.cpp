@@ -0,0 +1,157 @@
+#include "MCPCommandRegistry.h"
+#include "Async/Async.h"
+#include "Containers/Queue.h"
+#include "Dom/JsonValue.h"
+#include "MCPLog.h"
+#include "Misc/ScopeRWLock.h"
+
+static TQueue<TUniqueFunction<void()>, EQueueMode::Mpsc> GameThreadWork;
+
+void FMCPGameThreadQueue::Enqueue(TUniqueFunction<void()>&& Work)
+{
+    GameThreadWork.Enqueue(MoveTemp(Work));
+
+    // Whoever gets there first runs it: this task, or a game thread already waiting on a command
+    AsyncTask(ENamedThreads::GameThread, []()
+    {
+        ProcessPending();
+    });
+}
+
+void FMCPGameThreadQueue::ProcessPending()
+{
+    check(IsInGameThread());
+
+    TUniqueFunction<void()> Work;
+    while (GameThreadWork.Dequeue(Work))
+    {
+        Work();
+    }
+}
+
+FString FMCPCommandInfo::FindMissingParam(const TSharedPtr<FJsonObject>& InParams) const
+{
+    for (const FMCPCommandParam& CommandParam : Params)
+    {
+        if (CommandParam.bRequired && (!InParams.IsValid() || !InParams->HasField(CommandParam.Name)))
+        {
+            return CommandParam.Name;
+        }
+    }
+
+    return FString();
+}
+
+TSharedPtr<FJsonObject> FMCPCommandInfo::ToJson() const
+{
+    TSharedPtr<FJsonObject> CommandJson = MakeShared<FJsonObject>();
+    CommandJson->SetStringField(TEXT("name"), Name.ToString());
+    CommandJson->SetStringField(TEXT("description"), Description);
+    CommandJson->SetBoolField(TEXT("read_only"), bReadOnly);
+    CommandJson->SetBoolField(TEXT("game_thread"), bRequiresGameThread);
+    CommandJson->SetBoolField(TEXT("async"), IsAsync());
+    CommandJson->SetBoolField(TEXT("streaming"), IsStreaming());
+    CommandJson->SetStringField(TEXT("owner"), Owner.ToString());
+
+    TArray<TSharedPtr<FJsonValue>> ParamsJson;
+    ParamsJson.Reserve(Params.Num());
+    for (const FMCPCommandParam& CommandParam : Params)
+    {
+        TSharedPtr<FJsonObject> ParamJson = MakeShared<FJsonObject>();
+        ParamJson->SetStringField(TEXT("name"), CommandParam.Name);
+        ParamJson->SetStringField(TEXT("type"), CommandParam.Type);
+        ParamJson->SetBoolField(TEXT("required"), CommandParam.bRequired);
+        ParamsJson.Add(MakeShared<FJsonValueObject>(ParamJson));
+    }
+    CommandJson->SetArrayField(TEXT("params"), ParamsJson);
+
+    return CommandJson;
+}
+
+FMCPCommandRegistry& FMCPCommandRegistry::Get()
+{
+    static FMCPCommandRegistry Registry;
+    return Registry;
+}
+
+bool FMCPCommandRegistry::Register(FName Owner, FMCPCommandInfo Info)
+{
+    // Callers register at startup and don't check the result, so a command that can't be added
+    // is reported here, loudly, rather than turning into "Unknown command" at request time
+    if (!ensureMsgf(!Info.Name.IsNone() && (Info.Handler.IsBound() || Info.AsyncHandler.IsBound() || Info.StreamingHandler.IsBound()),
+        TEXT("MCPCommandRegistry: Command '%s' has no name or handler"), *Info.Name.ToString()))
+    {
+        UE_LOG(LogUnrealMCP, Error, TEXT("MCPCommandRegistry: Failed to register command '%s': it has no name or handler"), *Info.Name.ToString());
+        return false;
+    }
+
+    Info.Owner = Owner;
+    const FName Name = Info.Name;
+
+    FWriteScopeLock WriteLock(Lock);
+
+    if (Commands.Contains(Name))
+    {
+        UE_LOG(LogUnrealMCP, Error, TEXT("MCPCommandRegistry: Failed to register command '%s' for %s: it is already registered by %s"),
+            *Name.ToString(), *Owner.ToString(), *Commands[Name]->Owner.ToString());
+        return false;
+    }
+
+    Commands.Add(Name, MakeShared<FMCPCommandInfo>(MoveTemp(Info)));
+    return true;
+}
+
+bool FMCPCommandRegistry::Unregister(FName Name)
+{
+    FWriteScopeLock WriteLock(Lock);
+    return Commands.Remove(Name) > 0;
+}
+
+int32 FMCPCommandRegistry::UnregisterAll(FName Owner)
+{
+    FWriteScopeLock WriteLock(Lock);
+
+    int32 NumRemoved = 0;
+    for (auto It = Commands.CreateIterator(); It; ++It)
+    {
+        if (It->Value->Owner == Owner)
+        {
+            It.RemoveCurrent();
+            ++NumRemoved;
+        }
+    }
+
+    return NumRemoved;
+}
+
+TSharedPtr<const FMCPCommandInfo> FMCPCommandRegistry::Find(FName Name) const
+{
+    FReadScopeLock ReadLock(Lock);
+
+    const TSharedPtr<const FMCPCommandInfo>* Found = Commands.Find(Name);
+    return Found ? *Found : nullptr;
+}
+
+TSharedPtr<const FMCPCommandInfo> FMCPCommandRegistry::Find(const FString& Name) const
+{
+    // A name that was never registered isn't in the name table either
+    const FName CommandName(*Name, FNAME_Find);
+    return CommandName.IsNone() ? nullptr : Find(CommandName);
+}
+
+TArray<TSharedPtr<const FMCPCommandInfo>> FMCPCommandRegistry::GetAll() const
+{
+    TArray<TSharedPtr<const FMCPCommandInfo>> Result;
+
+    {
+        FReadScopeLock ReadLock(Lock);
+        Commands.GenerateValueArray(Result);
+    }
+
+    Result.Sort([](const TSharedPtr<const FMCPCommandInfo>& A, const TSharedPtr<const FMCPCommandInfo>& B)
+    {
+        return A->Name.LexicalLess(B->Name);
+    });
+
+    return Result;
+}
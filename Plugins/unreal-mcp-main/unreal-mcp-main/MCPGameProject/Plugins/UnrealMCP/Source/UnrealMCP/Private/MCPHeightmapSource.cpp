@@ -0,0 +1,325 @@
+#include "MCPHeightmapSource.h"
+#include "Async/ParallelFor.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformTime.h"
+#include "IImageWrapper.h"
+#include "IImageWrapperModule.h"
+#include "MCPLog.h"
+#include "Math/RandomStream.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Modules/ModuleManager.h"
+#include <atomic>
+
+// The height a landscape shows at its actor's Z
+const uint16 MCPHEIGHTMAP_MID_HEIGHT = 32768;
+
+// More layers than this are finer than a landscape sample
+const int32 MCPHEIGHTMAP_MAX_OCTAVES = 12;
+
+static bool IsPngPath(const FString& Path)
+{
+    return FPaths::GetExtension(Path).Equals(TEXT("png"), ESearchCase::IgnoreCase);
+}
+
+// Run Body over the heightmap in parallel, one tile of TileSize quads at a time, logging every
+// tenth of the way. The last tile in each direction also takes the final row or column of samples.
+static void ForEachTile(int32 SizeX, int32 SizeY, int32 TileSize, const TCHAR* What, TFunctionRef<void(int32 MinX, int32 MinY, int32 MaxX, int32 MaxY)> Body)
+{
+    const int32 NumTilesX = FMath::Max(1, (SizeX - 1) / TileSize);
+    const int32 NumTilesY = FMath::Max(1, (SizeY - 1) / TileSize);
+    const int32 NumTiles = NumTilesX * NumTilesY;
+    std::atomic<int32> NumDone(0);
+
+    ParallelFor(NumTiles, [&](int32 TileIndex)
+    {
+        const int32 TileX = TileIndex % NumTilesX;
+        const int32 TileY = TileIndex / NumTilesX;
+        const int32 MinX = TileX * TileSize;
+        const int32 MinY = TileY * TileSize;
+        const int32 MaxX = TileX == NumTilesX - 1 ? SizeX : MinX + TileSize;
+        const int32 MaxY = TileY == NumTilesY - 1 ? SizeY : MinY + TileSize;
+        Body(MinX, MinY, MaxX, MaxY);
+
+        const int32 Done = ++NumDone;
+        if (Done * 10 / NumTiles != (Done - 1) * 10 / NumTiles)
+        {
+            UE_LOG(LogUnrealMCP, Display, TEXT("MCPHeightmap: %s %d%% (%d of %d regions)"), What, Done * 100 / NumTiles, Done, NumTiles);
+        }
+    });
+}
+
+static void GenerateNoise(const FMCPHeightmapSource& Source, int32 SizeX, int32 SizeY, int32 TileSize, uint16* OutHeights)
+{
+    // Perlin noise repeats every 256 units, so each octave gets its own offset and angle to hide the seams
+    FRandomStream Stream(Source.Seed);
+    TArray<FVector2D, TInlineAllocator<MCPHEIGHTMAP_MAX_OCTAVES>> Offsets;
+    TArray<FVector2D, TInlineAllocator<MCPHEIGHTMAP_MAX_OCTAVES>> Axes;
+    double TotalWeight = 0.0;
+    for (int32 Octave = 0; Octave < Source.Octaves; ++Octave)
+    {
+        Offsets.Emplace(Stream.FRandRange(0.0f, 256.0f), Stream.FRandRange(0.0f, 256.0f));
+        const float Angle = Stream.FRandRange(0.0f, 2.0f * PI);
+        Axes.Emplace(FMath::Cos(Angle), FMath::Sin(Angle));
+        TotalWeight += FMath::Pow(0.5, Octave);
+    }
+
+    const double BaseFrequency = 1.0 / Source.FeatureSize;
+    const double Scale = Source.Amplitude * (MCPHEIGHTMAP_MID_HEIGHT - 1) / TotalWeight;
+
+    ForEachTile(SizeX, SizeY, TileSize, TEXT("Generating noise"), [&](int32 MinX, int32 MinY, int32 MaxX, int32 MaxY)
+    {
+        for (int32 Y = MinY; Y < MaxY; ++Y)
+        {
+            for (int32 X = MinX; X < MaxX; ++X)
+            {
+                double Frequency = BaseFrequency;
+                double Weight = 1.0;
+                double Sum = 0.0;
+                for (int32 Octave = 0; Octave < Source.Octaves; ++Octave)
+                {
+                    const double U = X * Frequency;
+                    const double V = Y * Frequency;
+                    const FVector2D& Axis = Axes[Octave];
+                    Sum += Weight * FMath::PerlinNoise2D(FVector2D(U * Axis.X - V * Axis.Y, U * Axis.Y + V * Axis.X) + Offsets[Octave]);
+                    Frequency *= 2.0;
+                    Weight *= 0.5;
+                }
+
+                OutHeights[Y * SizeX + X] = static_cast<uint16>(FMath::Clamp<int32>(FMath::RoundToInt32(MCPHEIGHTMAP_MID_HEIGHT + Sum * Scale), 0, MAX_uint16));
+            }
+        }
+    });
+}
+
+// Bilinear resample of a SourceX by SourceY heightmap to SizeX by SizeY, keeping the corners in place
+static void Resample(const uint16* Source, int32 SourceX, int32 SourceY, int32 SizeX, int32 SizeY, int32 TileSize, uint16* OutHeights)
+{
+    const double StepX = SizeX > 1 ? double(SourceX - 1) / (SizeX - 1) : 0.0;
+    const double StepY = SizeY > 1 ? double(SourceY - 1) / (SizeY - 1) : 0.0;
+
+    ForEachTile(SizeX, SizeY, TileSize, TEXT("Resampling"), [&](int32 MinX, int32 MinY, int32 MaxX, int32 MaxY)
+    {
+        for (int32 Y = MinY; Y < MaxY; ++Y)
+        {
+            const double SampleY = Y * StepY;
+            const int32 Y0 = FMath::Min(FMath::FloorToInt32(SampleY), SourceY - 1);
+            const int32 Y1 = FMath::Min(Y0 + 1, SourceY - 1);
+            const double AlphaY = SampleY - Y0;
+
+            for (int32 X = MinX; X < MaxX; ++X)
+            {
+                const double SampleX = X * StepX;
+                const int32 X0 = FMath::Min(FMath::FloorToInt32(SampleX), SourceX - 1);
+                const int32 X1 = FMath::Min(X0 + 1, SourceX - 1);
+                const double AlphaX = SampleX - X0;
+
+                const double Top = FMath::Lerp<double>(Source[Y0 * SourceX + X0], Source[Y0 * SourceX + X1], AlphaX);
+                const double Bottom = FMath::Lerp<double>(Source[Y1 * SourceX + X0], Source[Y1 * SourceX + X1], AlphaX);
+                OutHeights[Y * SizeX + X] = static_cast<uint16>(FMath::RoundToInt32(FMath::Lerp(Top, Bottom, AlphaY)));
+            }
+        }
+    });
+}
+
+static bool LoadRawFile(const FString& Path, int32 SizeX, int32 SizeY, int32 TileSize, TArray<uint16>& OutHeights, FString& OutError)
+{
+    TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(*Path));
+    if (!Reader)
+    {
+        OutError = FString::Printf(TEXT("Failed to open heightmap %s"), *Path);
+        return false;
+    }
+
+    const int64 NumBytes = Reader->TotalSize();
+    if (NumBytes == int64(SizeX) * SizeY * sizeof(uint16))
+    {
+        // Same shape as the landscape, so read it straight into the output
+        OutHeights.SetNumUninitialized(SizeX * SizeY);
+        Reader->Serialize(OutHeights.GetData(), NumBytes);
+    }
+    else
+    {
+        // Raw files don't record their shape, so anything else has to be square
+        const int32 Side = FMath::RoundToInt32(FMath::Sqrt(double(NumBytes / sizeof(uint16))));
+        if (int64(Side) * Side * sizeof(uint16) != NumBytes || Side < 2)
+        {
+            OutError = FString::Printf(TEXT("Heightmap %s is %lld bytes, which is neither %dx%d 16-bit samples nor a square heightmap"),
+                *Path, NumBytes, SizeX, SizeY);
+            return false;
+        }
+
+        TArray<uint16> Source;
+        Source.SetNumUninitialized(Side * Side);
+        Reader->Serialize(Source.GetData(), NumBytes);
+        if (!Reader->IsError())
+        {
+            OutHeights.SetNumUninitialized(SizeX * SizeY);
+            Resample(Source.GetData(), Side, Side, SizeX, SizeY, TileSize, OutHeights.GetData());
+        }
+    }
+
+    if (Reader->IsError() || !Reader->Close())
+    {
+        OutHeights.Empty();
+        OutError = FString::Printf(TEXT("Failed to read heightmap %s"), *Path);
+        return false;
+    }
+
+    return true;
+}
+
+static bool LoadPngFile(const FString& Path, int32 SizeX, int32 SizeY, int32 TileSize, TArray<uint16>& OutHeights, FString& OutError)
+{
+    TArray64<uint8> Compressed;
+    if (!FFileHelper::LoadFileToArray(Compressed, *Path))
+    {
+        OutError = FString::Printf(TEXT("Failed to read heightmap %s"), *Path);
+        return false;
+    }
+
+    IImageWrapperModule& ImageWrapperModule = FModuleManager::GetModuleChecked<IImageWrapperModule>(TEXT("ImageWrapper"));
+    TSharedPtr<IImageWrapper> ImageWrapper = ImageWrapperModule.CreateImageWrapper(EImageFormat::PNG);
+    if (!ImageWrapper.IsValid() || !ImageWrapper->SetCompressed(Compressed.GetData(), Compressed.Num()))
+    {
+        OutError = FString::Printf(TEXT("Heightmap %s is not a valid PNG"), *Path);
+        return false;
+    }
+
+    if (ImageWrapper->GetBitDepth() != 16)
+    {
+        OutError = FString::Printf(TEXT("Heightmap %s is %d-bit, expected 16-bit grayscale"), *Path, ImageWrapper->GetBitDepth());
+        return false;
+    }
+
+    TArray64<uint8> Decoded;
+    if (!ImageWrapper->GetRaw(ERGBFormat::Gray, 16, Decoded))
+    {
+        OutError = FString::Printf(TEXT("Failed to decode heightmap %s"), *Path);
+        return false;
+    }
+    Compressed.Empty();
+
+    const int32 Width = ImageWrapper->GetWidth();
+    const int32 Height = ImageWrapper->GetHeight();
+    const uint16* Samples = reinterpret_cast<const uint16*>(Decoded.GetData());
+
+    OutHeights.SetNumUninitialized(SizeX * SizeY);
+    if (Width == SizeX && Height == SizeY)
+    {
+        FMemory::Memcpy(OutHeights.GetData(), Samples, OutHeights.Num() * sizeof(uint16));
+    }
+    else
+    {
+        Resample(Samples, Width, Height, SizeX, SizeY, TileSize, OutHeights.GetData());
+    }
+
+    return true;
+}
+
+bool FMCPHeightmapGenerator::ParseSource(const TSharedPtr<FJsonObject>& Json, FMCPHeightmapSource& OutSource, FString& OutError)
+{
+    check(IsInGameThread());
+
+    OutSource = FMCPHeightmapSource();
+    if (!Json.IsValid())
+    {
+        return true;
+    }
+
+    FString TypeName = GetTypeName(EMCPHeightmapSourceType::Flat);
+    Json->TryGetStringField(TEXT("type"), TypeName);
+
+    if (TypeName.Equals(GetTypeName(EMCPHeightmapSourceType::Flat), ESearchCase::IgnoreCase))
+    {
+        OutSource.Type = EMCPHeightmapSourceType::Flat;
+    }
+    else if (TypeName.Equals(GetTypeName(EMCPHeightmapSourceType::Noise), ESearchCase::IgnoreCase))
+    {
+        OutSource.Type = EMCPHeightmapSourceType::Noise;
+        Json->TryGetNumberField(TEXT("seed"), OutSource.Seed);
+        Json->TryGetNumberField(TEXT("feature_size"), OutSource.FeatureSize);
+        Json->TryGetNumberField(TEXT("octaves"), OutSource.Octaves);
+        Json->TryGetNumberField(TEXT("amplitude"), OutSource.Amplitude);
+
+        OutSource.FeatureSize = FMath::Max(OutSource.FeatureSize, 1.0f);
+        OutSource.Octaves = FMath::Clamp(OutSource.Octaves, 1, MCPHEIGHTMAP_MAX_OCTAVES);
+        OutSource.Amplitude = FMath::Clamp(OutSource.Amplitude, 0.0f, 1.0f);
+    }
+    else if (TypeName.Equals(GetTypeName(EMCPHeightmapSourceType::File), ESearchCase::IgnoreCase))
+    {
+        OutSource.Type = EMCPHeightmapSourceType::File;
+        if (!Json->TryGetStringField(TEXT("path"), OutSource.FilePath) || OutSource.FilePath.IsEmpty())
+        {
+            OutError = TEXT("A file heightmap needs a 'path'");
+            return false;
+        }
+
+        if (!FPaths::FileExists(OutSource.FilePath))
+        {
+            OutError = FString::Printf(TEXT("Heightmap file not found: %s"), *OutSource.FilePath);
+            return false;
+        }
+
+        // The decoders live in a module that may only be loaded from the game thread
+        if (IsPngPath(OutSource.FilePath))
+        {
+            FModuleManager::Get().LoadModuleChecked<IImageWrapperModule>(TEXT("ImageWrapper"));
+        }
+    }
+    else
+    {
+        OutError = FString::Printf(TEXT("Unknown heightmap type '%s', expected flat, noise or file"), *TypeName);
+        return false;
+    }
+
+    return true;
+}
+
+const TCHAR* FMCPHeightmapGenerator::GetTypeName(EMCPHeightmapSourceType Type)
+{
+    switch (Type)
+    {
+    case EMCPHeightmapSourceType::Noise:
+        return TEXT("noise");
+    case EMCPHeightmapSourceType::File:
+        return TEXT("file");
+    default:
+        return TEXT("flat");
+    }
+}
+
+bool FMCPHeightmapGenerator::Generate(const FMCPHeightmapSource& Source, int32 SizeX, int32 SizeY, int32 TileSize, TArray<uint16>& OutHeights, FString& OutError)
+{
+    if (SizeX < 2 || SizeY < 2)
+    {
+        OutError = FString::Printf(TEXT("Heightmap size %dx%d is too small"), SizeX, SizeY);
+        return false;
+    }
+
+    TileSize = FMath::Max(TileSize, 1);
+    const double StartTime = FPlatformTime::Seconds();
+
+    switch (Source.Type)
+    {
+    case EMCPHeightmapSourceType::Noise:
+        OutHeights.SetNumUninitialized(SizeX * SizeY);
+        GenerateNoise(Source, SizeX, SizeY, TileSize, OutHeights.GetData());
+        break;
+    case EMCPHeightmapSourceType::File:
+        if (!(IsPngPath(Source.FilePath)
+            ? LoadPngFile(Source.FilePath, SizeX, SizeY, TileSize, OutHeights, OutError)
+            : LoadRawFile(Source.FilePath, SizeX, SizeY, TileSize, OutHeights, OutError)))
+        {
+            return false;
+        }
+        break;
+    default:
+        OutHeights.Init(MCPHEIGHTMAP_MID_HEIGHT, SizeX * SizeY);
+        break;
+    }
+
+    UE_LOG(LogUnrealMCP, Display, TEXT("MCPHeightmap: Built %dx%d %s heightmap in %.1f ms"),
+        SizeX, SizeY, GetTypeName(Source.Type), (FPlatformTime::Seconds() - StartTime) * 1000.0);
+    return true;
+}
@@ -0,0 +1,252 @@
+#include "MCPMessageFraming.h"
+
+FMCPByteRingBuffer::FMCPByteRingBuffer(int32 InitialCapacity)
+    : Head(0)
+    , Count(0)
+{
+    Data.SetNumUninitialized(FMath::RoundUpToPowerOfTwo(FMath::Max(InitialCapacity, 16)));
+}
+
+void FMCPByteRingBuffer::Append(const uint8* InData, int32 InCount)
+{
+    if (InCount <= 0)
+    {
+        return;
+    }
+
+    if (Count + InCount > Data.Num())
+    {
+        Grow(Count + InCount);
+    }
+
+    // Copy in at most two pieces, wrapping around the end of the storage
+    const int32 Capacity = Data.Num();
+    const int32 Tail = (Head + Count) & (Capacity - 1);
+    const int32 FirstPart = FMath::Min(InCount, Capacity - Tail);
+
+    FMemory::Memcpy(Data.GetData() + Tail, InData, FirstPart);
+    if (FirstPart < InCount)
+    {
+        FMemory::Memcpy(Data.GetData(), InData + FirstPart, InCount - FirstPart);
+    }
+
+    Count += InCount;
+}
+
+void FMCPByteRingBuffer::Consume(int32 InCount)
+{
+    InCount = FMath::Clamp(InCount, 0, Count);
+    Head = (Head + InCount) & (Data.Num() - 1);
+    Count -= InCount;
+
+    // Rewind when empty so small messages stay contiguous
+    if (Count == 0)
+    {
+        Head = 0;
+    }
+}
+
+void FMCPByteRingBuffer::Peek(int32 Offset, uint8* Dest, int32 InCount) const
+{
+    check(Offset >= 0 && InCount >= 0 && Offset + InCount <= Count);
+
+    const int32 Capacity = Data.Num();
+    const int32 Start = (Head + Offset) & (Capacity - 1);
+    const int32 FirstPart = FMath::Min(InCount, Capacity - Start);
+
+    FMemory::Memcpy(Dest, Data.GetData() + Start, FirstPart);
+    if (FirstPart < InCount)
+    {
+        FMemory::Memcpy(Dest + FirstPart, Data.GetData(), InCount - FirstPart);
+    }
+}
+
+void FMCPByteRingBuffer::Reset()
+{
+    Head = 0;
+    Count = 0;
+}
+
+void FMCPByteRingBuffer::Grow(int32 MinCapacity)
+{
+    // Unwrap the existing bytes into the new storage
+    TArray<uint8> NewData;
+    NewData.SetNumUninitialized(FMath::RoundUpToPowerOfTwo(MinCapacity));
+
+    if (Count > 0)
+    {
+        Peek(0, NewData.GetData(), Count);
+    }
+
+    Data = MoveTemp(NewData);
+    Head = 0;
+}
+
+FMCPMessageFramer::FMCPMessageFramer()
+    : Mode(EMCPFramingMode::Undetermined)
+    , ScanOffset(0)
+    , Depth(0)
+    , bInString(false)
+    , bEscape(false)
+    , bStarted(false)
+    , bError(false)
+{
+}
+
+void FMCPMessageFramer::Append(const uint8* Data, int32 Count)
+{
+    if (!bError)
+    {
+        Buffer.Append(Data, Count);
+    }
+}
+
+bool FMCPMessageFramer::PopMessage(TArray<uint8>& OutMessage)
+{
+    if (bError || Buffer.Num() == 0)
+    {
+        return false;
+    }
+
+    // Pick the framing mode from the first byte. JSON text starts with a brace or whitespace,
+    // while a length prefix starts with a zero or small byte because of the size cap.
+    if (Mode == EMCPFramingMode::Undetermined)
+    {
+        const uint8 First = Buffer.At(0);
+        const bool bLooksLikeText = First == '{' || First == '[' || First == ' ' || First == '\t' || First == '\r' || First == '\n';
+        Mode = bLooksLikeText ? EMCPFramingMode::Newline : EMCPFramingMode::LengthPrefixed;
+    }
+
+    return Mode == EMCPFramingMode::Newline ? PopNewlineMessage(OutMessage) : PopLengthPrefixedMessage(OutMessage);
+}
+
+bool FMCPMessageFramer::PopNewlineMessage(TArray<uint8>& OutMessage)
+{
+    while (ScanOffset < Buffer.Num())
+    {
+        const uint8 Char = Buffer.At(ScanOffset);
+
+        // Skip separators between messages
+        if (!bStarted)
+        {
+            if (Char == ' ' || Char == '\t' || Char == '\r' || Char == '\n')
+            {
+                Buffer.Consume(1);
+                continue;
+            }
+
+            if (Char != '{' && Char != '[')
+            {
+                SetError(FString::Printf(TEXT("Expected a JSON object, got byte 0x%02X"), Char));
+                return false;
+            }
+
+            bStarted = true;
+        }
+
+        ++ScanOffset;
+
+        if (ScanOffset > MaxMessageSize)
+        {
+            SetError(FString::Printf(TEXT("Message exceeds %d bytes"), MaxMessageSize));
+            return false;
+        }
+
+        // Track strings so braces inside them don't count
+        if (bInString)
+        {
+            if (bEscape)
+            {
+                bEscape = false;
+            }
+            else if (Char == '\\')
+            {
+                bEscape = true;
+            }
+            else if (Char == '"')
+            {
+                bInString = false;
+            }
+            continue;
+        }
+
+        if (Char == '"')
+        {
+            bInString = true;
+        }
+        else if (Char == '{' || Char == '[')
+        {
+            ++Depth;
+        }
+        else if (Char == '}' || Char == ']')
+        {
+            if (--Depth == 0)
+            {
+                // The top-level value is complete
+                OutMessage.SetNumUninitialized(ScanOffset, EAllowShrinking::No);
+                Buffer.Peek(0, OutMessage.GetData(), ScanOffset);
+                Buffer.Consume(ScanOffset);
+
+                ScanOffset = 0;
+                bStarted = false;
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+bool FMCPMessageFramer::PopLengthPrefixedMessage(TArray<uint8>& OutMessage)
+{
+    if (Buffer.Num() < 4)
+    {
+        return false;
+    }
+
+    uint8 Header[4];
+    Buffer.Peek(0, Header, 4);
+
+    const uint32 Length = (uint32(Header[0]) << 24) | (uint32(Header[1]) << 16) | (uint32(Header[2]) << 8) | uint32(Header[3]);
+    if (Length > uint32(MaxMessageSize))
+    {
+        SetError(FString::Printf(TEXT("Message length %u exceeds %d bytes"), Length, MaxMessageSize));
+        return false;
+    }
+
+    if (Buffer.Num() < 4 + int32(Length))
+    {
+        return false;
+    }
+
+    OutMessage.SetNumUninitialized(Length, EAllowShrinking::No);
+    Buffer.Peek(4, OutMessage.GetData(), Length);
+    Buffer.Consume(4 + Length);
+    return true;
+}
+
+void FMCPMessageFramer::FrameResponse(EMCPFramingMode InMode, const uint8* Data, int32 Count, TArray<uint8>& OutFrame)
+{
+    OutFrame.Reset(Count + 4);
+
+    if (InMode == EMCPFramingMode::LengthPrefixed)
+    {
+        OutFrame.Add(uint8((Count >> 24) & 0xFF));
+        OutFrame.Add(uint8((Count >> 16) & 0xFF));
+        OutFrame.Add(uint8((Count >> 8) & 0xFF));
+        OutFrame.Add(uint8(Count & 0xFF));
+        OutFrame.Append(Data, Count);
+    }
+    else
+    {
+        OutFrame.Append(Data, Count);
+        OutFrame.Add('\n');
+    }
+}
+
+void FMCPMessageFramer::SetError(const FString& InError)
+{
+    bError = true;
+    Error = InError;
+    Buffer.Reset();
+}
@@ -0,0 +1,137 @@
+#include "MCPResponseEncoder.h"
+#include "MCPResultWriter.h"
+#include "Misc/Compression.h"
+
+bool FMCPResponseFormat::ParseFrom(const FJsonObject& Json, FString& OutError)
+{
+    FString EncodingName;
+    if (Json.TryGetStringField(TEXT("encoding"), EncodingName))
+    {
+        if (EncodingName == TEXT("json"))
+        {
+            Encoding = EMCPEncoding::Json;
+        }
+        else if (EncodingName == TEXT("msgpack"))
+        {
+            Encoding = EMCPEncoding::MessagePack;
+        }
+        else
+        {
+            OutError = FString::Printf(TEXT("Unknown encoding '%s', expected json or msgpack"), *EncodingName);
+            return false;
+        }
+    }
+
+    FString CompressionName;
+    if (Json.TryGetStringField(TEXT("compression"), CompressionName))
+    {
+        if (CompressionName == TEXT("none"))
+        {
+            Compression = EMCPCompression::None;
+        }
+        else if (CompressionName == TEXT("zlib"))
+        {
+            Compression = EMCPCompression::Zlib;
+        }
+        else
+        {
+            OutError = FString::Printf(TEXT("Unknown compression '%s', expected none or zlib"), *CompressionName);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+TSharedPtr<FJsonObject> FMCPResponseFormat::ToJson() const
+{
+    TSharedPtr<FJsonObject> Json = MakeShared<FJsonObject>();
+    Json->SetStringField(TEXT("encoding"), GetEncodingName(Encoding));
+    Json->SetStringField(TEXT("compression"), GetCompressionName(Compression));
+    return Json;
+}
+
+const TCHAR* FMCPResponseFormat::GetEncodingName(EMCPEncoding Encoding)
+{
+    switch (Encoding)
+    {
+    case EMCPEncoding::MessagePack:
+        return TEXT("msgpack");
+    default:
+        return TEXT("json");
+    }
+}
+
+const TCHAR* FMCPResponseFormat::GetCompressionName(EMCPCompression Compression)
+{
+    switch (Compression)
+    {
+    case EMCPCompression::Zlib:
+        return TEXT("zlib");
+    default:
+        return TEXT("none");
+    }
+}
+
+int32 FMCPResponseEncoder::Encode(const FJsonObject& Response, const FMCPResponseFormat& Format, TArray<uint8>& OutBytes)
+{
+    FMCPResultWriter Writer(Format.Encoding);
+    Writer.WriteObject(Response);
+    Finish(Writer, Format, OutBytes);
+    return Writer.GetNumAllocations();
+}
+
+int32 FMCPResponseEncoder::EncodeStreamed(const FMCPResultWriter& Result, const TSharedPtr<FJsonValue>& RequestId, const FMCPResponseFormat& Format, TArray<uint8>& OutBytes)
+{
+    check(Result.GetEncoding() == Format.Encoding);
+
+    // Same envelope the bridge builds for a handler's result object
+    FMCPResultWriter Writer(Format.Encoding);
+    Writer.BeginObject(RequestId.IsValid() ? 3 : 2);
+    Writer.WriteStringField(TEXT("status"), TEXT("success"));
+    Writer.WriteKey(TEXT("result"));
+    Writer.WriteEncoded(Result.GetBytes());
+    if (RequestId.IsValid())
+    {
+        Writer.WriteKey(TEXT("id"));
+        Writer.WriteValue(RequestId);
+    }
+    Writer.EndObject();
+
+    Finish(Writer, Format, OutBytes);
+    return Result.GetNumAllocations() + Writer.GetNumAllocations();
+}
+
+void FMCPResponseEncoder::Finish(FMCPResultWriter& Writer, const FMCPResponseFormat& Format, TArray<uint8>& OutBytes)
+{
+    OutBytes = MoveTemp(Writer.GetBytes());
+
+    if (Format.Compression != EMCPCompression::None && OutBytes.Num() >= MinCompressBytes)
+    {
+        // Keep the uncompressed bytes if compression didn't help; the first byte tells the client which it got
+        TArray<uint8> Compressed;
+        if (Compress(Format.Compression, OutBytes, Compressed) && Compressed.Num() < OutBytes.Num())
+        {
+            OutBytes = MoveTemp(Compressed);
+        }
+    }
+}
+
+bool FMCPResponseEncoder::Compress(EMCPCompression Compression, const TArray<uint8>& Data, TArray<uint8>& OutCompressed)
+{
+    if (Compression != EMCPCompression::Zlib)
+    {
+        return false;
+    }
+
+    int32 CompressedSize = FCompression::CompressMemoryBound(NAME_Zlib, Data.Num());
+    OutCompressed.SetNumUninitialized(CompressedSize);
+    if (!FCompression::CompressMemory(NAME_Zlib, OutCompressed.GetData(), CompressedSize, Data.GetData(), Data.Num()))
+    {
+        OutCompressed.Reset();
+        return false;
+    }
+
+    OutCompressed.SetNum(CompressedSize, EAllowShrinking::No);
+    return true;
+}
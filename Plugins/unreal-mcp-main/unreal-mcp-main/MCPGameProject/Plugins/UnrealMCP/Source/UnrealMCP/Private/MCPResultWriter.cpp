@@ -0,0 +1,429 @@
+#include "MCPResultWriter.h"
+
+// Whole numbers up to this magnitude are exact in a double and are written as integers
+static const double MCPWRITER_MAX_EXACT_INTEGER = 9007199254740992.0;
+
+FMCPResultWriter::FMCPResultWriter(EMCPEncoding InEncoding)
+    : Encoding(InEncoding)
+    , bAfterKey(false)
+    , NumAllocations(0)
+{
+}
+
+void FMCPResultWriter::Reset()
+{
+    Bytes.Reset();
+    HasElements.Reset();
+    bAfterKey = false;
+    NumAllocations = 0;
+}
+
+void FMCPResultWriter::BeginObject(int32 NumFields)
+{
+    BeginValue();
+    if (Encoding == EMCPEncoding::MessagePack)
+    {
+        AppendLengthHeader(NumFields, 0x80, 16, 0, 0xde, 0xdf);
+        return;
+    }
+
+    AppendByte('{');
+    HasElements.Push(false);
+}
+
+void FMCPResultWriter::EndObject()
+{
+    if (Encoding == EMCPEncoding::Json)
+    {
+        AppendByte('}');
+        HasElements.Pop(EAllowShrinking::No);
+    }
+}
+
+void FMCPResultWriter::BeginArray(int32 NumElements)
+{
+    BeginValue();
+    if (Encoding == EMCPEncoding::MessagePack)
+    {
+        AppendLengthHeader(NumElements, 0x90, 16, 0, 0xdc, 0xdd);
+        return;
+    }
+
+    AppendByte('[');
+    HasElements.Push(false);
+}
+
+void FMCPResultWriter::EndArray()
+{
+    if (Encoding == EMCPEncoding::Json)
+    {
+        AppendByte(']');
+        HasElements.Pop(EAllowShrinking::No);
+    }
+}
+
+void FMCPResultWriter::WriteKey(FStringView Key)
+{
+    BeginValue();
+    AppendString(Key);
+    if (Encoding == EMCPEncoding::Json)
+    {
+        AppendByte(':');
+        bAfterKey = true;
+    }
+}
+
+void FMCPResultWriter::WriteString(FStringView Value)
+{
+    BeginValue();
+    AppendString(Value);
+}
+
+void FMCPResultWriter::WriteNumber(double Value)
+{
+    BeginValue();
+    if (Encoding == EMCPEncoding::MessagePack)
+    {
+        AppendMessagePackNumber(Value);
+    }
+    else
+    {
+        AppendJsonNumber(Value);
+    }
+}
+
+void FMCPResultWriter::WriteBool(bool bValue)
+{
+    BeginValue();
+    if (Encoding == EMCPEncoding::MessagePack)
+    {
+        AppendByte(bValue ? 0xc3 : 0xc2);
+    }
+    else if (bValue)
+    {
+        Append("true", 4);
+    }
+    else
+    {
+        Append("false", 5);
+    }
+}
+
+void FMCPResultWriter::WriteNull()
+{
+    BeginValue();
+    if (Encoding == EMCPEncoding::MessagePack)
+    {
+        AppendByte(0xc0);
+    }
+    else
+    {
+        Append("null", 4);
+    }
+}
+
+void FMCPResultWriter::WriteVector(double X, double Y, double Z)
+{
+    BeginArray(3);
+    WriteNumber(X);
+    WriteNumber(Y);
+    WriteNumber(Z);
+    EndArray();
+}
+
+void FMCPResultWriter::WriteValue(const TSharedPtr<FJsonValue>& Value)
+{
+    if (!Value.IsValid())
+    {
+        WriteNull();
+        return;
+    }
+
+    // The value node itself
+    ++NumAllocations;
+
+    switch (Value->Type)
+    {
+    case EJson::Boolean:
+        WriteBool(Value->AsBool());
+        break;
+    case EJson::Number:
+        WriteNumber(Value->AsNumber());
+        break;
+    case EJson::String:
+    {
+        const FString String = Value->AsString();
+        NumAllocations += String.IsEmpty() ? 0 : 1;
+        WriteString(String);
+        break;
+    }
+    case EJson::Array:
+    {
+        const TArray<TSharedPtr<FJsonValue>>& Array = Value->AsArray();
+        NumAllocations += Array.Num() > 0 ? 1 : 0;
+        BeginArray(Array.Num());
+        for (const TSharedPtr<FJsonValue>& Element : Array)
+        {
+            WriteValue(Element);
+        }
+        EndArray();
+        break;
+    }
+    case EJson::Object:
+    {
+        const TSharedPtr<FJsonObject>& Object = Value->AsObject();
+        if (Object.IsValid())
+        {
+            WriteObject(*Object);
+        }
+        else
+        {
+            WriteNull();
+        }
+        break;
+    }
+    default:
+        WriteNull();
+        break;
+    }
+}
+
+void FMCPResultWriter::WriteObject(const FJsonObject& Object)
+{
+    // The object, its field map and one string per key
+    NumAllocations += 1 + (Object.Values.Num() > 0 ? 1 : 0) + Object.Values.Num();
+
+    BeginObject(Object.Values.Num());
+    for (const TPair<FString, TSharedPtr<FJsonValue>>& Pair : Object.Values)
+    {
+        WriteKey(Pair.Key);
+        WriteValue(Pair.Value);
+    }
+    EndObject();
+}
+
+void FMCPResultWriter::WriteEncoded(const TArray<uint8>& Encoded)
+{
+    BeginValue();
+    Append(Encoded.GetData(), Encoded.Num());
+}
+
+void FMCPResultWriter::BeginValue()
+{
+    if (Encoding != EMCPEncoding::Json)
+    {
+        return;
+    }
+
+    if (bAfterKey)
+    {
+        bAfterKey = false;
+        return;
+    }
+
+    if (HasElements.Num() > 0)
+    {
+        if (HasElements.Last())
+        {
+            AppendByte(',');
+        }
+        HasElements.Last() = true;
+    }
+}
+
+void FMCPResultWriter::Append(const void* Data, int32 Count)
+{
+    const int32 OldMax = Bytes.Max();
+    Bytes.Append(static_cast<const uint8*>(Data), Count);
+    if (Bytes.Max() != OldMax)
+    {
+        ++NumAllocations;
+    }
+}
+
+void FMCPResultWriter::AppendBigEndian(uint64 Value, int32 NumBytes)
+{
+    uint8 Buffer[8];
+    for (int32 Index = 0; Index < NumBytes; ++Index)
+    {
+        Buffer[Index] = static_cast<uint8>(Value >> ((NumBytes - 1 - Index) * 8));
+    }
+    Append(Buffer, NumBytes);
+}
+
+void FMCPResultWriter::AppendLengthHeader(uint32 Length, uint8 FixType, uint32 FixLimit, uint8 Type8, uint8 Type16, uint8 Type32)
+{
+    if (Length < FixLimit)
+    {
+        AppendByte(static_cast<uint8>(FixType | Length));
+    }
+    else if (Type8 != 0 && Length <= MAX_uint8)
+    {
+        AppendByte(Type8);
+        AppendBigEndian(Length, 1);
+    }
+    else if (Length <= MAX_uint16)
+    {
+        AppendByte(Type16);
+        AppendBigEndian(Length, 2);
+    }
+    else
+    {
+        AppendByte(Type32);
+        AppendBigEndian(Length, 4);
+    }
+}
+
+void FMCPResultWriter::AppendMessagePackNumber(double Value)
+{
+    if (FMath::Abs(Value) > MCPWRITER_MAX_EXACT_INTEGER || FMath::FloorToDouble(Value) != Value)
+    {
+        uint64 Bits;
+        FMemory::Memcpy(&Bits, &Value, sizeof(Bits));
+        AppendByte(0xcb);
+        AppendBigEndian(Bits, 8);
+        return;
+    }
+
+    const int64 Integer = static_cast<int64>(Value);
+    if (Integer >= 0)
+    {
+        if (Integer < 128)
+        {
+            AppendByte(static_cast<uint8>(Integer));
+        }
+        else if (Integer <= MAX_uint8)
+        {
+            AppendByte(0xcc);
+            AppendBigEndian(Integer, 1);
+        }
+        else if (Integer <= MAX_uint16)
+        {
+            AppendByte(0xcd);
+            AppendBigEndian(Integer, 2);
+        }
+        else if (Integer <= MAX_uint32)
+        {
+            AppendByte(0xce);
+            AppendBigEndian(Integer, 4);
+        }
+        else
+        {
+            AppendByte(0xcf);
+            AppendBigEndian(Integer, 8);
+        }
+    }
+    else if (Integer >= -32)
+    {
+        AppendByte(static_cast<uint8>(static_cast<int8>(Integer)));
+    }
+    else if (Integer >= MIN_int8)
+    {
+        AppendByte(0xd0);
+        AppendBigEndian(static_cast<uint64>(Integer), 1);
+    }
+    else if (Integer >= MIN_int16)
+    {
+        AppendByte(0xd1);
+        AppendBigEndian(static_cast<uint64>(Integer), 2);
+    }
+    else if (Integer >= MIN_int32)
+    {
+        AppendByte(0xd2);
+        AppendBigEndian(static_cast<uint64>(Integer), 4);
+    }
+    else
+    {
+        AppendByte(0xd3);
+        AppendBigEndian(static_cast<uint64>(Integer), 8);
+    }
+}
+
+void FMCPResultWriter::AppendJsonNumber(double Value)
+{
+    // JSON has no NaN or infinity
+    if (!FMath::IsFinite(Value))
+    {
+        Append("null", 4);
+        return;
+    }
+
+    ANSICHAR Buffer[32];
+    int32 Length;
+    if (FMath::Abs(Value) <= MCPWRITER_MAX_EXACT_INTEGER && FMath::FloorToDouble(Value) == Value)
+    {
+        Length = FCStringAnsi::Snprintf(Buffer, sizeof(Buffer), "%lld", static_cast<long long>(Value));
+    }
+    else
+    {
+        // Shortest of 15 or 17 significant digits that reads back as the same double
+        Length = FCStringAnsi::Snprintf(Buffer, sizeof(Buffer), "%.15g", Value);
+        if (FCStringAnsi::Atod(Buffer) != Value)
+        {
+            Length = FCStringAnsi::Snprintf(Buffer, sizeof(Buffer), "%.17g", Value);
+        }
+    }
+    Append(Buffer, Length);
+}
+
+void FMCPResultWriter::AppendString(FStringView Value)
+{
+    const FTCHARToUTF8 Utf8(Value.GetData(), Value.Len());
+    const uint8* Data = reinterpret_cast<const uint8*>(Utf8.Get());
+    const int32 Length = Utf8.Length();
+
+    if (Encoding == EMCPEncoding::MessagePack)
+    {
+        AppendLengthHeader(Length, 0xa0, 32, 0xd9, 0xda, 0xdb);
+        Append(Data, Length);
+        return;
+    }
+
+    // Copy runs of plain bytes in one go and escape the rest
+    AppendByte('"');
+    int32 RunStart = 0;
+    for (int32 Index = 0; Index < Length; ++Index)
+    {
+        const uint8 Char = Data[Index];
+        if (Char >= 0x20 && Char != '"' && Char != '\\')
+        {
+            continue;
+        }
+
+        Append(Data + RunStart, Index - RunStart);
+        RunStart = Index + 1;
+
+        switch (Char)
+        {
+        case '"':
+            Append("\\\"", 2);
+            break;
+        case '\\':
+            Append("\\\\", 2);
+            break;
+        case '\n':
+            Append("\\n", 2);
+            break;
+        case '\r':
+            Append("\\r", 2);
+            break;
+        case '\t':
+            Append("\\t", 2);
+            break;
+        case '\b':
+            Append("\\b", 2);
+            break;
+        case '\f':
+            Append("\\f", 2);
+            break;
+        default:
+        {
+            ANSICHAR Escape[8];
+            Append(Escape, FCStringAnsi::Snprintf(Escape, sizeof(Escape), "\\u%04x", Char));
+            break;
+        }
+        }
+    }
+    Append(Data + RunStart, Length - RunStart);
+    AppendByte('"');
+}
@@ -0,0 +1,148 @@
+#include "MCPScreenshotCapture.h"
+#include "Async/Async.h"
+#include "Commands/UnrealMCPCommonUtils.h"
+#include "HAL/PlatformTime.h"
+#include "ImageCore.h"
+#include "ImageUtils.h"
+#include "Misc/Base64.h"
+#include "Misc/FileHelper.h"
+#include "Misc/ScopeLock.h"
+#include "Modules/ModuleManager.h"
+#include "UnrealClient.h"
+
+// Spare frame buffers kept between captures. One is enough for back-to-back captures; the
+// second covers a capture starting while the previous one is still encoding.
+const int32 MCPSCREENSHOT_MAX_POOLED_BUFFERS = 2;
+
+static FCriticalSection PixelBufferPoolLock;
+static TArray<TArray<FColor>> PixelBufferPool;
+
+static TArray<FColor> AcquirePixelBuffer()
+{
+    FScopeLock Lock(&PixelBufferPoolLock);
+    return PixelBufferPool.Num() > 0 ? PixelBufferPool.Pop(EAllowShrinking::No) : TArray<FColor>();
+}
+
+static void ReleasePixelBuffer(TArray<FColor>&& Pixels)
+{
+    // Keep the allocation, drop the contents
+    Pixels.Reset();
+
+    FScopeLock Lock(&PixelBufferPoolLock);
+    if (PixelBufferPool.Num() < MCPSCREENSHOT_MAX_POOLED_BUFFERS)
+    {
+        PixelBufferPool.Add(MoveTemp(Pixels));
+    }
+}
+
+// Runs on a background task
+static TSharedPtr<FJsonObject> EncodeScreenshot(TArray<FColor>& Pixels, const FIntPoint& Size, const FMCPScreenshotRequest& Request, double ReadbackMilliseconds)
+{
+    const double EncodeStartTime = FPlatformTime::Seconds();
+
+    // The viewport's alpha channel is whatever the renderer left in it, so make the image opaque
+    for (FColor& Pixel : Pixels)
+    {
+        Pixel.A = 255;
+    }
+
+    TArray64<uint8> Encoded;
+    const FImageView Image(Pixels.GetData(), Size.X, Size.Y);
+    const int32 Quality = Request.Format == EMCPScreenshotFormat::Jpeg ? Request.Quality : 0;
+    if (!FImageUtils::CompressImage(Encoded, FMCPScreenshotCapture::GetExtension(Request.Format), Image, Quality))
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Failed to encode screenshot"));
+    }
+
+    const double EncodeMilliseconds = (FPlatformTime::Seconds() - EncodeStartTime) * 1000.0;
+
+    if (!Request.FilePath.IsEmpty() && !FFileHelper::SaveArrayToFile(Encoded, *Request.FilePath))
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Failed to write screenshot to %s"), *Request.FilePath));
+    }
+
+    TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
+    if (!Request.FilePath.IsEmpty())
+    {
+        ResultObj->SetStringField(TEXT("filepath"), Request.FilePath);
+    }
+    ResultObj->SetStringField(TEXT("format"), FMCPScreenshotCapture::GetExtension(Request.Format));
+    ResultObj->SetNumberField(TEXT("width"), Size.X);
+    ResultObj->SetNumberField(TEXT("height"), Size.Y);
+    ResultObj->SetNumberField(TEXT("bytes"), Encoded.Num());
+    ResultObj->SetNumberField(TEXT("readback_ms"), ReadbackMilliseconds);
+    ResultObj->SetNumberField(TEXT("encode_ms"), EncodeMilliseconds);
+
+    if (Request.bInline)
+    {
+        ResultObj->SetStringField(TEXT("image_base64"), FBase64::Encode(Encoded.GetData(), static_cast<uint32>(Encoded.Num())));
+    }
+
+    return ResultObj;
+}
+
+bool FMCPScreenshotCapture::ParseFormat(const FString& Name, EMCPScreenshotFormat& OutFormat)
+{
+    if (Name.Equals(TEXT("png"), ESearchCase::IgnoreCase))
+    {
+        OutFormat = EMCPScreenshotFormat::Png;
+        return true;
+    }
+    if (Name.Equals(TEXT("jpg"), ESearchCase::IgnoreCase) || Name.Equals(TEXT("jpeg"), ESearchCase::IgnoreCase))
+    {
+        OutFormat = EMCPScreenshotFormat::Jpeg;
+        return true;
+    }
+    if (Name.Equals(TEXT("bmp"), ESearchCase::IgnoreCase))
+    {
+        OutFormat = EMCPScreenshotFormat::Bmp;
+        return true;
+    }
+    return false;
+}
+
+const TCHAR* FMCPScreenshotCapture::GetExtension(EMCPScreenshotFormat Format)
+{
+    switch (Format)
+    {
+    case EMCPScreenshotFormat::Jpeg:
+        return TEXT("jpg");
+    case EMCPScreenshotFormat::Bmp:
+        return TEXT("bmp");
+    default:
+        return TEXT("png");
+    }
+}
+
+void FMCPScreenshotCapture::Capture(FViewport* Viewport, const FMCPScreenshotRequest& Request, FMCPCommandCompletion&& OnComplete)
+{
+    check(IsInGameThread());
+
+    const FIntPoint Size = Viewport->GetSizeXY();
+    if (Size.X <= 0 || Size.Y <= 0)
+    {
+        OnComplete(FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Viewport has no size")));
+        return;
+    }
+
+    // The encoders live in a module that may only be loaded from the game thread
+    FModuleManager::Get().LoadModule(TEXT("ImageWrapper"));
+
+    const double ReadbackStartTime = FPlatformTime::Seconds();
+    TArray<FColor> Pixels = AcquirePixelBuffer();
+    if (!Viewport->ReadPixels(Pixels, FReadSurfaceDataFlags(), FIntRect(0, 0, Size.X, Size.Y)) || Pixels.Num() != Size.X * Size.Y)
+    {
+        ReleasePixelBuffer(MoveTemp(Pixels));
+        OnComplete(FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Failed to read viewport pixels")));
+        return;
+    }
+    const double ReadbackMilliseconds = (FPlatformTime::Seconds() - ReadbackStartTime) * 1000.0;
+
+    AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask,
+        [Pixels = MoveTemp(Pixels), Size, Request, ReadbackMilliseconds, OnComplete = MoveTemp(OnComplete)]() mutable
+    {
+        TSharedPtr<FJsonObject> Result = EncodeScreenshot(Pixels, Size, Request, ReadbackMilliseconds);
+        ReleasePixelBuffer(MoveTemp(Pixels));
+        OnComplete(Result);
+    });
+}
@@ -0,0 +1,180 @@
+#include "MCPServerStats.h"
+#include "Dom/JsonValue.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/ScopeLock.h"
+
+void FMCPLatencyHistogram::Add(double Microseconds)
+{
+    const uint64 Whole = static_cast<uint64>(FMath::Max(Microseconds, 0.0));
+    const int32 Bucket = FMath::Min(static_cast<int32>(FMath::FloorLog2_64(Whole)), NumBuckets - 1);
+    ++Buckets[Bucket];
+    ++Count;
+    TotalMicroseconds += Microseconds;
+    MaxMicroseconds = FMath::Max(MaxMicroseconds, Microseconds);
+}
+
+double FMCPLatencyHistogram::GetPercentileMicroseconds(double Fraction) const
+{
+    if (Count == 0)
+    {
+        return 0.0;
+    }
+
+    const uint64 Target = FMath::Max<uint64>(1, static_cast<uint64>(FMath::CeilToDouble(Fraction * Count)));
+    uint64 Seen = 0;
+    for (int32 Bucket = 0; Bucket < NumBuckets; ++Bucket)
+    {
+        Seen += Buckets[Bucket];
+        if (Seen >= Target)
+        {
+            return FMath::Min(static_cast<double>(uint64(1) << (Bucket + 1)), MaxMicroseconds);
+        }
+    }
+    return MaxMicroseconds;
+}
+
+TSharedPtr<FJsonObject> FMCPLatencyHistogram::ToJson() const
+{
+    TSharedPtr<FJsonObject> Json = MakeShared<FJsonObject>();
+    Json->SetNumberField(TEXT("count"), static_cast<double>(Count));
+    Json->SetNumberField(TEXT("mean_ms"), Count > 0 ? TotalMicroseconds / Count / 1000.0 : 0.0);
+    Json->SetNumberField(TEXT("max_ms"), MaxMicroseconds / 1000.0);
+    Json->SetNumberField(TEXT("p50_ms"), GetPercentileMicroseconds(0.50) / 1000.0);
+    Json->SetNumberField(TEXT("p90_ms"), GetPercentileMicroseconds(0.90) / 1000.0);
+    Json->SetNumberField(TEXT("p99_ms"), GetPercentileMicroseconds(0.99) / 1000.0);
+
+    // Only the buckets that saw samples; "le_ms" is each bucket's upper bound
+    TArray<TSharedPtr<FJsonValue>> BucketsJson;
+    for (int32 Bucket = 0; Bucket < NumBuckets; ++Bucket)
+    {
+        if (Buckets[Bucket] > 0)
+        {
+            TSharedPtr<FJsonObject> BucketJson = MakeShared<FJsonObject>();
+            if (Bucket < NumBuckets - 1)
+            {
+                BucketJson->SetNumberField(TEXT("le_ms"), static_cast<double>(uint64(1) << (Bucket + 1)) / 1000.0);
+            }
+            BucketJson->SetNumberField(TEXT("count"), static_cast<double>(Buckets[Bucket]));
+            BucketsJson.Add(MakeShared<FJsonValueObject>(BucketJson));
+        }
+    }
+    Json->SetArrayField(TEXT("buckets"), BucketsJson);
+    return Json;
+}
+
+FMCPServerStats& FMCPServerStats::Get()
+{
+    static FMCPServerStats Stats;
+    return Stats;
+}
+
+FMCPServerStats::FMCPServerStats()
+    : NumInFlight(0)
+    , NumSessions(0)
+    , TotalSessions(0)
+    , BytesIn(0)
+    , BytesOut(0)
+    , MessagesIn(0)
+    , MessagesOut(0)
+    , StartTime(FPlatformTime::Seconds())
+{
+}
+
+void FMCPServerStats::RecordStage(const FString& CommandType, EMCPRequestStage Stage, double Seconds)
+{
+    FScopeLock Lock(&CommandsLock);
+    Commands.FindOrAdd(CommandType).Stages[static_cast<int32>(Stage)].Add(Seconds * 1000000.0);
+}
+
+void FMCPServerStats::RecordAllocations(const FString& CommandType, int32 Count)
+{
+    FScopeLock Lock(&CommandsLock);
+    FCommandStats& Command = Commands.FindOrAdd(CommandType);
+    ++Command.NumResponses;
+    Command.TotalAllocations += Count;
+    Command.MaxAllocations = FMath::Max<uint64>(Command.MaxAllocations, Count);
+}
+
+void FMCPServerStats::EndCommand(const FString& CommandType, bool bSucceeded)
+{
+    --NumInFlight;
+
+    if (!bSucceeded)
+    {
+        FScopeLock Lock(&CommandsLock);
+        ++Commands.FindOrAdd(CommandType).NumFailed;
+    }
+}
+
+TSharedPtr<FJsonObject> FMCPServerStats::ToJson() const
+{
+    TSharedPtr<FJsonObject> Json = MakeShared<FJsonObject>();
+    Json->SetNumberField(TEXT("since_reset_s"), FPlatformTime::Seconds() - StartTime);
+    Json->SetNumberField(TEXT("in_flight"), NumInFlight);
+    Json->SetNumberField(TEXT("sessions"), NumSessions);
+    Json->SetNumberField(TEXT("total_sessions"), static_cast<double>(TotalSessions));
+    Json->SetNumberField(TEXT("bytes_in"), static_cast<double>(BytesIn));
+    Json->SetNumberField(TEXT("bytes_out"), static_cast<double>(BytesOut));
+    Json->SetNumberField(TEXT("messages_in"), static_cast<double>(MessagesIn));
+    Json->SetNumberField(TEXT("messages_out"), static_cast<double>(MessagesOut));
+
+    TSharedPtr<FJsonObject> CommandsJson = MakeShared<FJsonObject>();
+    {
+        FScopeLock Lock(&CommandsLock);
+        for (const TPair<FString, FCommandStats>& Pair : Commands)
+        {
+            TSharedPtr<FJsonObject> CommandJson = MakeShared<FJsonObject>();
+            CommandJson->SetNumberField(TEXT("failed"), static_cast<double>(Pair.Value.NumFailed));
+            if (Pair.Value.NumResponses > 0)
+            {
+                TSharedPtr<FJsonObject> AllocationsJson = MakeShared<FJsonObject>();
+                AllocationsJson->SetNumberField(TEXT("mean"), static_cast<double>(Pair.Value.TotalAllocations) / Pair.Value.NumResponses);
+                AllocationsJson->SetNumberField(TEXT("max"), static_cast<double>(Pair.Value.MaxAllocations));
+                CommandJson->SetObjectField(TEXT("allocations"), AllocationsJson);
+            }
+            for (int32 Stage = 0; Stage < static_cast<int32>(EMCPRequestStage::Num); ++Stage)
+            {
+                const FMCPLatencyHistogram& Histogram = Pair.Value.Stages[Stage];
+                if (Histogram.Count > 0)
+                {
+                    CommandJson->SetObjectField(GetStageName(static_cast<EMCPRequestStage>(Stage)), Histogram.ToJson());
+                }
+            }
+            CommandsJson->SetObjectField(Pair.Key, CommandJson);
+        }
+    }
+    Json->SetObjectField(TEXT("commands"), CommandsJson);
+    return Json;
+}
+
+void FMCPServerStats::Reset()
+{
+    {
+        FScopeLock Lock(&CommandsLock);
+        Commands.Reset();
+    }
+
+    TotalSessions = NumSessions.load();
+    BytesIn = 0;
+    BytesOut = 0;
+    MessagesIn = 0;
+    MessagesOut = 0;
+    StartTime = FPlatformTime::Seconds();
+}
+
+const TCHAR* FMCPServerStats::GetStageName(EMCPRequestStage Stage)
+{
+    switch (Stage)
+    {
+    case EMCPRequestStage::QueueWait:
+        return TEXT("queue_wait");
+    case EMCPRequestStage::Execute:
+        return TEXT("execute");
+    case EMCPRequestStage::Serialize:
+        return TEXT("serialize");
+    case EMCPRequestStage::Send:
+        return TEXT("send");
+    default:
+        return TEXT("unknown");
+    }
+}
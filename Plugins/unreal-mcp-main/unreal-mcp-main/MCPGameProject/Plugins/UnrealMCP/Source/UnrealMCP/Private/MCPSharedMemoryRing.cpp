@@ -0,0 +1,123 @@
+#include "MCPSharedMemoryRing.h"
+#include "MCPLog.h"
+#include <atomic>
+
+#if PLATFORM_LINUX
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+// Layout shared with clients; see the header
+const uint32 MCPSHM_MAGIC = 0x50434D55;
+const uint32 MCPSHM_VERSION = 1;
+const int64 MCPSHM_HEADER_SIZE = 256;
+
+struct FMCPSharedMemoryHeader
+{
+    uint32 Magic;
+    uint32 Version;
+    uint64 Capacity;
+    alignas(64) std::atomic<uint64> WriteOffset;
+    alignas(64) std::atomic<uint64> ReadOffset;
+};
+
+static_assert(sizeof(FMCPSharedMemoryHeader) <= MCPSHM_HEADER_SIZE, "Shared memory header outgrew its reserved space");
+static_assert(std::atomic<uint64>::is_always_lock_free, "Shared memory offsets must be lock free to be shared between processes");
+
+FMCPSharedMemoryRing::FMCPSharedMemoryRing(const FString& InName, void* InMapping, int64 InMappingSize, int64 InCapacity)
+    : Name(InName)
+    , Mapping(InMapping)
+    , MappingSize(InMappingSize)
+    , Capacity(InCapacity)
+{
+}
+
+FMCPSharedMemoryRing::~FMCPSharedMemoryRing()
+{
+#if PLATFORM_LINUX
+    // A client that still has it mapped keeps its view; the name goes now
+    munmap(Mapping, MappingSize);
+    shm_unlink(TCHAR_TO_UTF8(*Name));
+#endif
+}
+
+TUniquePtr<FMCPSharedMemoryRing> FMCPSharedMemoryRing::Create(const FString& Name, int64 Capacity, FString& OutError)
+{
+#if PLATFORM_LINUX
+    const FTCHARToUTF8 Utf8Name(*Name);
+    const int Fd = shm_open(Utf8Name.Get(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (Fd < 0)
+    {
+        OutError = FString::Printf(TEXT("Failed to create shared memory %s (errno %d)"), *Name, errno);
+        return nullptr;
+    }
+
+    const int64 MappingSize = MCPSHM_HEADER_SIZE + Capacity;
+    void* Mapping = ftruncate(Fd, MappingSize) == 0 ? mmap(nullptr, MappingSize, PROT_READ | PROT_WRITE, MAP_SHARED, Fd, 0) : MAP_FAILED;
+    const int MapError = errno;
+
+    // The mapping keeps the segment alive without the descriptor
+    close(Fd);
+
+    if (Mapping == MAP_FAILED)
+    {
+        shm_unlink(Utf8Name.Get());
+        OutError = FString::Printf(TEXT("Failed to map %lld bytes of shared memory (errno %d)"), MappingSize, MapError);
+        return nullptr;
+    }
+
+    FMCPSharedMemoryHeader* Header = new (Mapping) FMCPSharedMemoryHeader();
+    Header->Magic = MCPSHM_MAGIC;
+    Header->Version = MCPSHM_VERSION;
+    Header->Capacity = Capacity;
+    Header->WriteOffset.store(0);
+    Header->ReadOffset.store(0);
+
+    UE_LOG(LogUnrealMCP, Verbose, TEXT("MCPSharedMemoryRing: Created %s with %lld bytes"), *Name, Capacity);
+    return TUniquePtr<FMCPSharedMemoryRing>(new FMCPSharedMemoryRing(Name, Mapping, MappingSize, Capacity));
+#else
+    OutError = TEXT("Shared memory is only supported on Linux");
+    return nullptr;
+#endif
+}
+
+bool FMCPSharedMemoryRing::Write(const uint8* Data, int64 Count, uint64& OutOffset)
+{
+    if (Count <= 0 || Count > Capacity)
+    {
+        return false;
+    }
+
+    FMCPSharedMemoryHeader* Header = static_cast<FMCPSharedMemoryHeader*>(Mapping);
+    const uint64 WriteOffset = Header->WriteOffset.load(std::memory_order_relaxed);
+    const uint64 ReadOffset = Header->ReadOffset.load(std::memory_order_acquire);
+
+    // The client owns the read offset, so don't trust it further than it can be checked
+    if (ReadOffset > WriteOffset || WriteOffset - ReadOffset > uint64(Capacity))
+    {
+        UE_LOG(LogUnrealMCP, Warning, TEXT("MCPSharedMemoryRing: %s has a bad read offset, using the socket"), *Name);
+        return false;
+    }
+
+    // Keep each payload contiguous by skipping whatever is left at the end of the area
+    uint64 Start = WriteOffset;
+    const uint64 Position = WriteOffset % Capacity;
+    if (Position + Count > uint64(Capacity))
+    {
+        Start += Capacity - Position;
+    }
+
+    if (Start + Count - ReadOffset > uint64(Capacity))
+    {
+        return false;
+    }
+
+    uint8* DataArea = static_cast<uint8*>(Mapping) + MCPSHM_HEADER_SIZE;
+    FMemory::Memcpy(DataArea + Start % Capacity, Data, Count);
+    Header->WriteOffset.store(Start + Count, std::memory_order_release);
+
+    OutOffset = Start;
+    return true;
+}
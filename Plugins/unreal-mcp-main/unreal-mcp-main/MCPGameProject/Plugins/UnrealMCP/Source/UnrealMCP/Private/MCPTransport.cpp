@@ -0,0 +1,471 @@
+#include "MCPTransport.h"
+#include "Interfaces/IPv4/IPv4Address.h"
+#include "Interfaces/IPv4/IPv4Endpoint.h"
+#include "MCPLog.h"
+#include "Sockets.h"
+#include "SocketSubsystem.h"
+
+#if PLATFORM_LINUX
+#include <errno.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+// Kernel buffer size requested for each TCP connection
+const int32 MCPTRANSPORT_TCP_BUFFER_SIZE = 65536;
+
+// Connections the OS queues for us before we accept them
+const int32 MCPTRANSPORT_LISTEN_BACKLOG = 5;
+
+FMCPTransportConfig FMCPTransportConfig::FromSettings(const UUnrealMCPSettings& Settings)
+{
+    FMCPTransportConfig Config;
+    Config.Transport = Settings.Transport;
+    Config.Host = Settings.Host;
+    Config.Port = Settings.Port;
+    Config.SocketPath = Settings.SocketPath;
+    Config.SharedMemoryBytes = Settings.bEnableSharedMemory ? int64(Settings.SharedMemorySizeMB) * 1024 * 1024 : 0;
+    Config.SharedMemoryThreshold = Settings.SharedMemoryThresholdKB * 1024;
+    return Config;
+}
+
+/**
+ * Connection over an engine socket
+ */
+class FMCPTcpConnection : public IMCPConnection
+{
+public:
+    FMCPTcpConnection(FSocket* InSocket)
+        : Socket(InSocket)
+    {
+        // Non-blocking reads and writes. All blocking happens in Wait, which has a timeout.
+        int32 ActualSize = 0;
+        Socket->SetNonBlocking(true);
+        Socket->SetNoDelay(true);
+        Socket->SetSendBufferSize(MCPTRANSPORT_TCP_BUFFER_SIZE, ActualSize);
+        Socket->SetReceiveBufferSize(MCPTRANSPORT_TCP_BUFFER_SIZE, ActualSize);
+    }
+
+    virtual ~FMCPTcpConnection()
+    {
+        Close();
+    }
+
+    virtual bool WaitForRead(const FTimespan& Timeout) override
+    {
+        return Socket && Socket->Wait(ESocketWaitConditions::WaitForRead, Timeout);
+    }
+
+    virtual bool WaitForWrite(const FTimespan& Timeout) override
+    {
+        return Socket && Socket->Wait(ESocketWaitConditions::WaitForWrite, Timeout);
+    }
+
+    virtual EMCPIoResult Recv(uint8* Data, int32 Count, int32& OutBytesRead) override
+    {
+        OutBytesRead = 0;
+        if (!Socket)
+        {
+            return EMCPIoResult::Error;
+        }
+
+        if (Socket->Recv(Data, Count, OutBytesRead))
+        {
+            // Readable with nothing to read means the peer closed the connection
+            return OutBytesRead > 0 ? EMCPIoResult::Ok : EMCPIoResult::Closed;
+        }
+        return GetLastResult();
+    }
+
+    virtual EMCPIoResult Send(const uint8* Data, int32 Count, int32& OutBytesSent) override
+    {
+        OutBytesSent = 0;
+        if (!Socket)
+        {
+            return EMCPIoResult::Error;
+        }
+
+        return Socket->Send(Data, Count, OutBytesSent) ? EMCPIoResult::Ok : GetLastResult();
+    }
+
+    virtual bool IsConnectionLost() const override
+    {
+        return !Socket || Socket->GetConnectionState() == SCS_ConnectionError;
+    }
+
+    virtual void Close() override
+    {
+        if (Socket)
+        {
+            Socket->Close();
+            ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->DestroySocket(Socket);
+            Socket = nullptr;
+        }
+    }
+
+    virtual bool SupportsSharedMemory() const override
+    {
+        // A TCP peer may be on another machine
+        return false;
+    }
+
+private:
+    static EMCPIoResult GetLastResult()
+    {
+        const ESocketErrors LastError = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->GetLastErrorCode();
+        if (LastError == SE_EWOULDBLOCK || LastError == SE_EINTR)
+        {
+            return EMCPIoResult::WouldBlock;
+        }
+
+        UE_LOG(LogUnrealMCP, Verbose, TEXT("MCPTcpConnection: Socket error %d"), (int32)LastError);
+        return EMCPIoResult::Error;
+    }
+
+    FSocket* Socket;
+};
+
+/**
+ * TCP listener on Host:Port
+ */
+class FMCPTcpListener : public IMCPListener
+{
+public:
+    static TUniquePtr<IMCPListener> Create(const FMCPTransportConfig& Config, FString& OutError)
+    {
+        ISocketSubsystem* SocketSubsystem = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM);
+        if (!SocketSubsystem)
+        {
+            OutError = TEXT("Failed to get socket subsystem");
+            return nullptr;
+        }
+
+        FIPv4Address Address;
+        if (!FIPv4Address::Parse(Config.Host, Address))
+        {
+            OutError = FString::Printf(TEXT("Invalid host address %s"), *Config.Host);
+            return nullptr;
+        }
+
+        FSocket* Socket = SocketSubsystem->CreateSocket(NAME_Stream, TEXT("UnrealMCPListener"), false);
+        if (!Socket)
+        {
+            OutError = TEXT("Failed to create listener socket");
+            return nullptr;
+        }
+
+        // Allow address reuse for quick restarts
+        Socket->SetReuseAddr(true);
+        Socket->SetNonBlocking(true);
+
+        const FIPv4Endpoint Endpoint(Address, static_cast<uint16>(Config.Port));
+        if (!Socket->Bind(*Endpoint.ToInternetAddr()))
+        {
+            OutError = FString::Printf(TEXT("Failed to bind listener socket to %s"), *Endpoint.ToString());
+            SocketSubsystem->DestroySocket(Socket);
+            return nullptr;
+        }
+
+        if (!Socket->Listen(MCPTRANSPORT_LISTEN_BACKLOG))
+        {
+            OutError = TEXT("Failed to start listening");
+            SocketSubsystem->DestroySocket(Socket);
+            return nullptr;
+        }
+
+        return TUniquePtr<IMCPListener>(new FMCPTcpListener(Socket, Endpoint.ToString()));
+    }
+
+    virtual ~FMCPTcpListener()
+    {
+        Socket->Close();
+        ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->DestroySocket(Socket);
+    }
+
+    virtual bool WaitForConnection(const FTimespan& Timeout) override
+    {
+        bool bPending = false;
+        return Socket->WaitForPendingConnection(bPending, Timeout) && bPending;
+    }
+
+    virtual TUniquePtr<IMCPConnection> Accept() override
+    {
+        bool bPending = false;
+        if (!Socket->HasPendingConnection(bPending) || !bPending)
+        {
+            return nullptr;
+        }
+
+        FSocket* ClientSocket = Socket->Accept(TEXT("MCPClient"));
+        if (!ClientSocket)
+        {
+            UE_LOG(LogUnrealMCP, Warning, TEXT("MCPTcpListener: Failed to accept client connection"));
+            return nullptr;
+        }
+
+        return MakeUnique<FMCPTcpConnection>(ClientSocket);
+    }
+
+    virtual FString Describe() const override
+    {
+        return FString::Printf(TEXT("tcp://%s"), *Endpoint);
+    }
+
+private:
+    FMCPTcpListener(FSocket* InSocket, const FString& InEndpoint)
+        : Socket(InSocket)
+        , Endpoint(InEndpoint)
+    {
+    }
+
+    FSocket* Socket;
+    FString Endpoint;
+};
+
+#if PLATFORM_LINUX
+
+static int32 TimespanToPollTimeout(const FTimespan& Timeout)
+{
+    return static_cast<int32>(FMath::Clamp<double>(Timeout.GetTotalMilliseconds(), 0.0, MAX_int32));
+}
+
+static bool PollFor(int Fd, short Events, const FTimespan& Timeout)
+{
+    pollfd PollFd = {};
+    PollFd.fd = Fd;
+    PollFd.events = Events;
+
+    // Hang-ups and errors count as ready so the next call reports them
+    return poll(&PollFd, 1, TimespanToPollTimeout(Timeout)) > 0;
+}
+
+static EMCPIoResult ErrnoToResult(const TCHAR* Context)
+{
+    if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)
+    {
+        return EMCPIoResult::WouldBlock;
+    }
+
+    UE_LOG(LogUnrealMCP, Verbose, TEXT("%s: errno %d"), Context, errno);
+    return EMCPIoResult::Error;
+}
+
+/**
+ * Connection over a Unix domain socket. Skips the TCP/IP stack entirely, and the peer is
+ * always on this machine, so it can also share memory with us.
+ */
+class FMCPUnixConnection : public IMCPConnection
+{
+public:
+    FMCPUnixConnection(int InFd)
+        : Fd(InFd)
+    {
+    }
+
+    virtual ~FMCPUnixConnection()
+    {
+        Close();
+    }
+
+    virtual bool WaitForRead(const FTimespan& Timeout) override
+    {
+        return Fd >= 0 && PollFor(Fd, POLLIN, Timeout);
+    }
+
+    virtual bool WaitForWrite(const FTimespan& Timeout) override
+    {
+        return Fd >= 0 && PollFor(Fd, POLLOUT, Timeout);
+    }
+
+    virtual EMCPIoResult Recv(uint8* Data, int32 Count, int32& OutBytesRead) override
+    {
+        OutBytesRead = 0;
+        const ssize_t Result = Fd >= 0 ? recv(Fd, Data, Count, 0) : -1;
+        if (Result > 0)
+        {
+            OutBytesRead = static_cast<int32>(Result);
+            return EMCPIoResult::Ok;
+        }
+        return Result == 0 ? EMCPIoResult::Closed : ErrnoToResult(TEXT("MCPUnixConnection: recv"));
+    }
+
+    virtual EMCPIoResult Send(const uint8* Data, int32 Count, int32& OutBytesSent) override
+    {
+        OutBytesSent = 0;
+
+        // No SIGPIPE if the client has gone; we get EPIPE instead
+        const ssize_t Result = Fd >= 0 ? send(Fd, Data, Count, MSG_NOSIGNAL) : -1;
+        if (Result >= 0)
+        {
+            OutBytesSent = static_cast<int32>(Result);
+            return EMCPIoResult::Ok;
+        }
+        return ErrnoToResult(TEXT("MCPUnixConnection: send"));
+    }
+
+    virtual bool IsConnectionLost() const override
+    {
+        // A hang-up wakes WaitForRead and the read that follows returns zero bytes
+        return Fd < 0;
+    }
+
+    virtual void Close() override
+    {
+        if (Fd >= 0)
+        {
+            shutdown(Fd, SHUT_RDWR);
+            close(Fd);
+            Fd = -1;
+        }
+    }
+
+    virtual bool SupportsSharedMemory() const override
+    {
+        return true;
+    }
+
+private:
+    int Fd;
+};
+
+/**
+ * Unix domain socket listener. The socket file is only accessible to the current user and is
+ * removed when the listener goes away.
+ */
+class FMCPUnixListener : public IMCPListener
+{
+public:
+    static TUniquePtr<IMCPListener> Create(const FMCPTransportConfig& Config, FString& OutError)
+    {
+        sockaddr_un Address = {};
+        Address.sun_family = AF_UNIX;
+        const FTCHARToUTF8 Path(*Config.SocketPath);
+        if (Path.Length() == 0 || Path.Length() >= static_cast<int32>(sizeof(Address.sun_path)))
+        {
+            OutError = FString::Printf(TEXT("Socket path '%s' must be 1 to %d bytes long"), *Config.SocketPath, static_cast<int32>(sizeof(Address.sun_path)) - 1);
+            return nullptr;
+        }
+        FMemory::Memcpy(Address.sun_path, Path.Get(), Path.Length());
+
+        const int Fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        if (Fd < 0)
+        {
+            OutError = FString::Printf(TEXT("Failed to create Unix socket (errno %d)"), errno);
+            return nullptr;
+        }
+
+        // A socket file left by an editor that crashed would make bind fail, but one that
+        // still answers belongs to another running editor and must be left alone
+        if (access(Path.Get(), F_OK) == 0)
+        {
+            const int ProbeFd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+            const bool bInUse = ProbeFd >= 0 && connect(ProbeFd, reinterpret_cast<const sockaddr*>(&Address), sizeof(Address)) == 0;
+            if (ProbeFd >= 0)
+            {
+                close(ProbeFd);
+            }
+
+            if (bInUse)
+            {
+                OutError = FString::Printf(TEXT("Another server is already listening on %s"), *Config.SocketPath);
+                close(Fd);
+                return nullptr;
+            }
+            unlink(Path.Get());
+        }
+
+        // bind creates the socket file with the umask's permissions, so mask off everything but
+        // the owner while it does, rather than leave a window where other users could connect.
+        // The umask is process-wide, but only for the length of the bind call
+        const mode_t OldMask = umask(S_IXUSR | S_IRWXG | S_IRWXO);
+        const int BindResult = bind(Fd, reinterpret_cast<const sockaddr*>(&Address), sizeof(Address));
+        const int BindErrno = errno;
+        umask(OldMask);
+
+        if (BindResult != 0)
+        {
+            OutError = FString::Printf(TEXT("Failed to bind Unix socket %s (errno %d)"), *Config.SocketPath, BindErrno);
+            close(Fd);
+            return nullptr;
+        }
+
+        // Enforce owner-only access even if the file system ignored the umask
+        if (chmod(Path.Get(), S_IRUSR | S_IWUSR) != 0)
+        {
+            OutError = FString::Printf(TEXT("Failed to restrict Unix socket %s to its owner (errno %d)"), *Config.SocketPath, errno);
+            close(Fd);
+            unlink(Path.Get());
+            return nullptr;
+        }
+
+        if (listen(Fd, MCPTRANSPORT_LISTEN_BACKLOG) != 0)
+        {
+            OutError = FString::Printf(TEXT("Failed to listen on Unix socket %s (errno %d)"), *Config.SocketPath, errno);
+            close(Fd);
+            unlink(Path.Get());
+            return nullptr;
+        }
+
+        return TUniquePtr<IMCPListener>(new FMCPUnixListener(Fd, Config.SocketPath));
+    }
+
+    virtual ~FMCPUnixListener()
+    {
+        close(Fd);
+        unlink(TCHAR_TO_UTF8(*SocketPath));
+    }
+
+    virtual bool WaitForConnection(const FTimespan& Timeout) override
+    {
+        return PollFor(Fd, POLLIN, Timeout);
+    }
+
+    virtual TUniquePtr<IMCPConnection> Accept() override
+    {
+        const int ClientFd = accept4(Fd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (ClientFd < 0)
+        {
+            if (errno != EAGAIN && errno != EWOULDBLOCK)
+            {
+                UE_LOG(LogUnrealMCP, Warning, TEXT("MCPUnixListener: Failed to accept client connection (errno %d)"), errno);
+            }
+            return nullptr;
+        }
+
+        return MakeUnique<FMCPUnixConnection>(ClientFd);
+    }
+
+    virtual FString Describe() const override
+    {
+        return FString::Printf(TEXT("unix://%s"), *SocketPath);
+    }
+
+private:
+    FMCPUnixListener(int InFd, const FString& InSocketPath)
+        : Fd(InFd)
+        , SocketPath(InSocketPath)
+    {
+    }
+
+    int Fd;
+    FString SocketPath;
+};
+
+#endif // PLATFORM_LINUX
+
+TUniquePtr<IMCPListener> IMCPListener::Create(const FMCPTransportConfig& Config, FString& OutError)
+{
+    if (Config.Transport == EMCPTransportType::UnixSocket)
+    {
+#if PLATFORM_LINUX
+        return FMCPUnixListener::Create(Config, OutError);
+#else
+        UE_LOG(LogUnrealMCP, Warning, TEXT("MCPTransport: Unix domain sockets are only supported on Linux, using TCP"));
+#endif
+    }
+
+    return FMCPTcpListener::Create(Config, OutError);
+}
@@ -2,6 +2,7 @@
 #include "MCPServerRunnable.h"
 #include "Sockets.h"
 #include "SocketSubsystem.h"
+#include "HAL/PlatformTime.h"
 #include "HAL/RunnableThread.h"
 #include "Interfaces/IPv4/IPv4Address.h"
 #include "Interfaces/IPv4/IPv4Endpoint.h"
@@ -57,10 +58,15 @@
 #include "Commands/UnrealMCPProjectCommands.h"
 #include "Commands/UnrealMCPCommonUtils.h"
 #include "Commands/UnrealMCPUMGCommands.h"
+#include "MCPBlueprintCache.h"
+#include "MCPBlueprintCompileQueue.h"
+#include "MCPCommandRegistry.h"
+#include "MCPLog.h"
+#include "MCPServerStats.h"
+#include "UnrealMCPSettings.h"
 
-// Default settings
-#define MCP_SERVER_HOST "127.0.0.1"
-#define MCP_SERVER_PORT 55557
+// Owner name for the commands this plugin registers
+static const FName MCPBuiltinCommandOwner(TEXT("UnrealMCP"));
 
 UUnrealMCPBridge::UUnrealMCPBridge()
 {
@@ -83,14 +89,14 @@ UUnrealMCPBridge::~UUnrealMCPBridge()
 // Initialize subsystem
 void UUnrealMCPBridge::Initialize(FSubsystemCollectionBase& Collection)
 {
-    UE_LOG(LogTemp, Display, TEXT("UnrealMCPBridge: Initializing"));
+    UE_LOG(LogUnrealMCP, Display, TEXT("UnrealMCPBridge: Initializing"));
     
     bIsRunning = false;
-    ListenerSocket = nullptr;
-    ConnectionSocket = nullptr;
+    Listener = nullptr;
     ServerThread = nullptr;
-    Port = MCP_SERVER_PORT;
-    FIPv4Address::Parse(MCP_SERVER_HOST, ServerAddress);
+
+    FMCPBlueprintCache::Get().Start();
+    RegisterCommands();
 
     // Start the server automatically
     StartServer();
@@ -99,68 +105,84 @@ void UUnrealMCPBridge::Initialize(FSubsystemCollectionBase& Collection)
 // Clean up resources when subsystem is destroyed
 void UUnrealMCPBridge::Deinitialize()
 {
-    UE_LOG(LogTemp, Display, TEXT("UnrealMCPBridge: Shutting down"));
+    UE_LOG(LogUnrealMCP, Display, TEXT("UnrealMCPBridge: Shutting down"));
     StopServer();
+
+    // The handlers are bound to our command objects, so they must go with us
+    FMCPCommandRegistry::Get().UnregisterAll(MCPBuiltinCommandOwner);
+
+    // Release resident blueprints while the object system is still up
+    FMCPBlueprintCache::Get().Stop();
+    FMCPBlueprintCompileQueue::Get().Reset();
 }
 
-// Start the MCP server
-void UUnrealMCPBridge::StartServer()
+// Register the built-in commands and those of every handler class
+void UUnrealMCPBridge::RegisterCommands()
 {
-    if (bIsRunning)
-    {
-        UE_LOG(LogTemp, Warning, TEXT("UnrealMCPBridge: Server is already running"));
-        return;
-    }
+    FMCPCommandRegistry& Registry = FMCPCommandRegistry::Get();
 
-    // Create socket subsystem
-    ISocketSubsystem* SocketSubsystem = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM);
-    if (!SocketSubsystem)
-    {
-        UE_LOG(LogTemp, Error, TEXT("UnrealMCPBridge: Failed to get socket subsystem"));
-        return;
-    }
+    Registry.Register(MCPBuiltinCommandOwner, FMCPCommandInfo(TEXT("ping"), TEXT("Check that the server is alive"),
+        FMCPCommandHandler::CreateUObject(this, &UUnrealMCPBridge::HandlePing))
+        .ReadOnly()
+        .AnyThread());
 
-    // Create listener socket
-    TSharedPtr<FSocket> NewListenerSocket = MakeShareable(SocketSubsystem->CreateSocket(NAME_Stream, TEXT("UnrealMCPListener"), false));
-    if (!NewListenerSocket.IsValid())
-    {
-        UE_LOG(LogTemp, Error, TEXT("UnrealMCPBridge: Failed to create listener socket"));
-        return;
-    }
+    Registry.Register(MCPBuiltinCommandOwner, FMCPCommandInfo(TEXT("list_commands"), TEXT("List every registered command with its parameters"),
+        FMCPCommandHandler::CreateUObject(this, &UUnrealMCPBridge::HandleListCommands))
+        .ReadOnly()
+        .AnyThread());
 
-    // Allow address reuse for quick restarts
-    NewListenerSocket->SetReuseAddr(true);
-    NewListenerSocket->SetNonBlocking(true);
+    Registry.Register(MCPBuiltinCommandOwner, FMCPCommandInfo(TEXT("get_server_stats"), TEXT("Report traffic counters and per-command latency"),
+        FMCPCommandHandler::CreateUObject(this, &UUnrealMCPBridge::HandleGetServerStats))
+        .Param(TEXT("reset"), TEXT("boolean"))
+        .ReadOnly()
+        .AnyThread());
 
-    // Bind to address
-    FIPv4Endpoint Endpoint(ServerAddress, Port);
-    if (!NewListenerSocket->Bind(*Endpoint.ToInternetAddr()))
+    Registry.Register(MCPBuiltinCommandOwner, FMCPCommandInfo(TEXT("batch"), TEXT("Run several commands in order within one game thread task"),
+        FMCPCommandHandler::CreateUObject(this, &UUnrealMCPBridge::HandleBatch))
+        .Param(TEXT("commands"), TEXT("array"), true)
+        .Param(TEXT("stop_on_error"), TEXT("boolean"))
+        .Param(TEXT("defer_compile"), TEXT("boolean")));
+
+    EditorCommands->RegisterCommands(Registry, MCPBuiltinCommandOwner);
+    BlueprintCommands->RegisterCommands(Registry, MCPBuiltinCommandOwner);
+    BlueprintNodeCommands->RegisterCommands(Registry, MCPBuiltinCommandOwner);
+    ProjectCommands->RegisterCommands(Registry, MCPBuiltinCommandOwner);
+    UMGCommands->RegisterCommands(Registry, MCPBuiltinCommandOwner);
+}
+
+// Start the MCP server
+void UUnrealMCPBridge::StartServer()
+{
+    if (bIsRunning)
     {
-        UE_LOG(LogTemp, Error, TEXT("UnrealMCPBridge: Failed to bind listener socket to %s:%d"), *ServerAddress.ToString(), Port);
+        UE_LOG(LogUnrealMCP, Warning, TEXT("UnrealMCPBridge: Server is already running"));
         return;
     }
 
-    // Start listening
-    if (!NewListenerSocket->Listen(5))
+    TransportConfig = FMCPTransportConfig::FromSettings(*GetDefault<UUnrealMCPSettings>());
+
+    FString Error;
+    TSharedPtr<IMCPListener> NewListener(IMCPListener::Create(TransportConfig, Error).Release());
+    if (!NewListener.IsValid())
     {
-        UE_LOG(LogTemp, Error, TEXT("UnrealMCPBridge: Failed to start listening"));
+        UE_LOG(LogUnrealMCP, Error, TEXT("UnrealMCPBridge: %s"), *Error);
         return;
     }
 
-    ListenerSocket = NewListenerSocket;
+    Listener = NewListener;
     bIsRunning = true;
-    UE_LOG(LogTemp, Display, TEXT("UnrealMCPBridge: Server started on %s:%d"), *ServerAddress.ToString(), Port);
+    UE_LOG(LogUnrealMCP, Display, TEXT("UnrealMCPBridge: Server started on %s"), *Listener->Describe());
 
     // Start server thread
     ServerThread = FRunnableThread::Create(
-        new FMCPServerRunnable(this, ListenerSocket),
+        new FMCPServerRunnable(this, Listener, TransportConfig),
         TEXT("UnrealMCPServerThread"),
         0, TPri_Normal
     );
 
     if (!ServerThread)
     {
-        UE_LOG(LogTemp, Error, TEXT("UnrealMCPBridge: Failed to create server thread"));
+        UE_LOG(LogUnrealMCP, Error, TEXT("UnrealMCPBridge: Failed to create server thread"));
         StopServer();
         return;
     }
@@ -184,149 +206,382 @@ void UUnrealMCPBridge::StopServer()
         ServerThread = nullptr;
     }
 
-    // Close sockets
-    if (ConnectionSocket.IsValid())
+    // Close the listener; the server thread that used it has exited
+    Listener.Reset();
+
+    UE_LOG(LogUnrealMCP, Display, TEXT("UnrealMCPBridge: Server stopped"));
+}
+
+// Execute a command received from a client and wait for its response
+FString UUnrealMCPBridge::ExecuteCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params)
+{
+    // Create a promise to wait for the result
+    TSharedRef<TPromise<FString>, ESPMode::ThreadSafe> Promise = MakeShared<TPromise<FString>, ESPMode::ThreadSafe>();
+    TFuture<FString> Future = Promise->GetFuture();
+    
+    ExecuteCommandAsync(CommandType, Params, [Promise, CommandType](TSharedPtr<FJsonObject> ResponseJson)
     {
-        ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->DestroySocket(ConnectionSocket.Get());
-        ConnectionSocket.Reset();
+        const double SerializeStartTime = FPlatformTime::Seconds();
+        FString ResultString;
+        TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&ResultString);
+        FJsonSerializer::Serialize(ResponseJson.ToSharedRef(), Writer);
+        FMCPServerStats::Get().RecordStage(CommandType, EMCPRequestStage::Serialize, FPlatformTime::Seconds() - SerializeStartTime);
+        Promise->SetValue(ResultString);
+    });
+    
+    // Wait in slices so a session blocked here can't hold up StopServer, which runs on the
+    // game thread and so would never let this task execute
+    while (!Future.WaitFor(FTimespan::FromMilliseconds(100)))
+    {
+        if (!bIsRunning)
+        {
+            return TEXT("{\"status\":\"error\",\"error\":\"Server is shutting down\"}");
+        }
     }
 
-    if (ListenerSocket.IsValid())
+    return Future.Get();
+}
+
+// Queue a command and call OnComplete with its response once it has run
+void UUnrealMCPBridge::ExecuteCommandAsync(const FString& CommandType, const TSharedPtr<FJsonObject>& Params, TFunction<void(TSharedPtr<FJsonObject>)>&& OnComplete)
+{
+    ExecuteCommandAsync(CommandType, Params, FMCPBlueprintCompileQueue::NoClient, nullptr, MoveTemp(OnComplete));
+}
+
+void UUnrealMCPBridge::ExecuteCommandAsync(const FString& CommandType, const TSharedPtr<FJsonObject>& Params, int32 ClientId, TSharedPtr<FMCPResultWriter, ESPMode::ThreadSafe> ResultWriter, TFunction<void(TSharedPtr<FJsonObject>)>&& OnComplete)
+{
+    UE_LOG(LogUnrealMCP, Verbose, TEXT("UnrealMCPBridge: Executing command: %s"), *CommandType);
+    
+    // Read-only commands that don't touch engine state run on the worker pool, so they
+    // can overlap with edits queued on the game thread
+    TSharedPtr<const FMCPCommandInfo> Command = FMCPCommandRegistry::Get().Find(CommandType);
+    const bool bRunOnWorker = Command.IsValid() && Command->bReadOnly && !Command->bRequiresGameThread;
+    
+    const double QueuedTime = FPlatformTime::Seconds();
+    FMCPServerStats::Get().BeginCommand();
+    
+    AsyncTask(bRunOnWorker ? ENamedThreads::AnyBackgroundThreadNormalTask : ENamedThreads::GameThread,
+        [this, CommandType, Params, ClientId, ResultWriter, QueuedTime, OnComplete = MoveTemp(OnComplete)]() mutable
     {
-        ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->DestroySocket(ListenerSocket.Get());
-        ListenerSocket.Reset();
-    }
+        const double StartTime = FPlatformTime::Seconds();
+        FMCPServerStats::Get().RecordStage(CommandType, EMCPRequestStage::QueueWait, StartTime - QueuedTime);
+        
+        // Blueprint edit sessions opened or joined by this command belong to the client that sent it
+        FMCPBlueprintCompileQueue::FScopedClient CompileClient(ClientId);
+        
+        RunCommandAsync(CommandType, Params, ResultWriter.Get(), [CommandType, StartTime, OnComplete = MoveTemp(OnComplete)](TSharedPtr<FJsonObject> ResponseJson)
+        {
+            // No response object means the result was streamed, which only happens on success
+            FMCPServerStats& Stats = FMCPServerStats::Get();
+            Stats.RecordStage(CommandType, EMCPRequestStage::Execute, FPlatformTime::Seconds() - StartTime);
+            Stats.EndCommand(CommandType, !ResponseJson.IsValid() || ResponseJson->GetStringField(TEXT("status")) == TEXT("success"));
+            OnComplete(ResponseJson);
+        });
+    });
+}
 
-    UE_LOG(LogTemp, Display, TEXT("UnrealMCPBridge: Server stopped"));
+// Wrap a handler's result in the response envelope sent to the client
+static TSharedPtr<FJsonObject> MakeCommandResponse(const FString& CommandType, TSharedPtr<FJsonObject> ResultJson)
+{
+    TSharedPtr<FJsonObject> ResponseJson = MakeShareable(new FJsonObject);
+    
+    if (!ResultJson.IsValid())
+    {
+        ResultJson = FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Command %s returned no result"), *CommandType));
+    }
+    
+    // Check if the result contains an error
+    bool bSuccess = true;
+    FString ErrorMessage;
+    
+    if (ResultJson->HasField(TEXT("success")))
+    {
+        bSuccess = ResultJson->GetBoolField(TEXT("success"));
+        if (!bSuccess && ResultJson->HasField(TEXT("error")))
+        {
+            ErrorMessage = ResultJson->GetStringField(TEXT("error"));
+        }
+    }
+    
+    if (bSuccess)
+    {
+        // Set success status and include the result
+        ResponseJson->SetStringField(TEXT("status"), TEXT("success"));
+        ResponseJson->SetObjectField(TEXT("result"), ResultJson);
+    }
+    else
+    {
+        // Set error status and include the error message
+        ResponseJson->SetStringField(TEXT("status"), TEXT("error"));
+        ResponseJson->SetStringField(TEXT("error"), ErrorMessage);
+    }
+    
+    return ResponseJson;
 }
 
-// Execute a command received from a client
-FString UUnrealMCPBridge::ExecuteCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params)
+// Look up a command and check its parameters. Returns an error response if it can't run.
+static TSharedPtr<FJsonObject> ValidateCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params, TSharedPtr<const FMCPCommandInfo>& OutCommand)
 {
-    UE_LOG(LogTemp, Display, TEXT("UnrealMCPBridge: Executing command: %s"), *CommandType);
+    OutCommand = FMCPCommandRegistry::Get().Find(CommandType);
+    if (!OutCommand.IsValid())
+    {
+        TSharedPtr<FJsonObject> ResponseJson = MakeShareable(new FJsonObject);
+        ResponseJson->SetStringField(TEXT("status"), TEXT("error"));
+        ResponseJson->SetStringField(TEXT("error"), FString::Printf(TEXT("Unknown command: %s"), *CommandType));
+        return ResponseJson;
+    }
     
-    // Create a promise to wait for the result
-    TPromise<FString> Promise;
-    TFuture<FString> Future = Promise.GetFuture();
+    const FString MissingParam = OutCommand->FindMissingParam(Params);
+    if (!MissingParam.IsEmpty())
+    {
+        TSharedPtr<FJsonObject> ResponseJson = MakeShareable(new FJsonObject);
+        ResponseJson->SetStringField(TEXT("status"), TEXT("error"));
+        ResponseJson->SetStringField(TEXT("error"), FString::Printf(TEXT("Missing '%s' parameter"), *MissingParam));
+        return ResponseJson;
+    }
     
-    // Queue execution on Game Thread
-    AsyncTask(ENamedThreads::GameThread, [this, CommandType, Params, Promise = MoveTemp(Promise)]() mutable
+    return nullptr;
+}
+
+// Run a streaming handler for a caller that needs a result object, by parsing the JSON it writes
+static TSharedPtr<FJsonObject> InvokeStreamingHandlerAsObject(const FMCPCommandInfo& Command, const TSharedPtr<FJsonObject>& Params)
+{
+    FMCPResultWriter Writer(EMCPEncoding::Json);
+    if (TSharedPtr<FJsonObject> ErrorJson = Command.StreamingHandler.Execute(Params, Writer))
+    {
+        return ErrorJson;
+    }
+    
+    const TArray<uint8>& Bytes = Writer.GetBytes();
+    TSharedPtr<FJsonObject> ResultJson;
+    TSharedRef<TJsonReader<UTF8CHAR>> Reader = TJsonReaderFactory<UTF8CHAR>::CreateFromView(
+        FUtf8StringView(reinterpret_cast<const UTF8CHAR*>(Bytes.GetData()), Bytes.Num()));
+    FJsonSerializer::Deserialize(Reader, ResultJson);
+    return ResultJson;
+}
+
+// Call a synchronous or streaming handler, turning exceptions into error responses
+static TSharedPtr<FJsonObject> InvokeHandler(const FMCPCommandInfo& Command, const FString& CommandType, const TSharedPtr<FJsonObject>& Params)
+{
+    try
+    {
+        return MakeCommandResponse(CommandType, Command.IsStreaming() ? InvokeStreamingHandlerAsObject(Command, Params) : Command.Handler.Execute(Params));
+    }
+    catch (const std::exception& e)
     {
         TSharedPtr<FJsonObject> ResponseJson = MakeShareable(new FJsonObject);
-        
+        ResponseJson->SetStringField(TEXT("status"), TEXT("error"));
+        ResponseJson->SetStringField(TEXT("error"), UTF8_TO_TCHAR(e.what()));
+        return ResponseJson;
+    }
+}
+
+// Route a single command to its handler and wait for the result. Must be called on the game
+// thread unless the command is registered as AnyThread.
+TSharedPtr<FJsonObject> UUnrealMCPBridge::RunCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params)
+{
+    TSharedPtr<const FMCPCommandInfo> Command;
+    if (TSharedPtr<FJsonObject> ErrorJson = ValidateCommand(CommandType, Params, Command))
+    {
+        return ErrorJson;
+    }
+    
+    if (!Command->IsAsync())
+    {
+        return InvokeHandler(*Command, CommandType, Params);
+    }
+    
+    TSharedRef<TPromise<TSharedPtr<FJsonObject>>, ESPMode::ThreadSafe> Promise = MakeShared<TPromise<TSharedPtr<FJsonObject>>, ESPMode::ThreadSafe>();
+    TFuture<TSharedPtr<FJsonObject>> Future = Promise->GetFuture();
+    Command->AsyncHandler.Execute(Params, [Promise](TSharedPtr<FJsonObject> ResultJson)
+    {
+        Promise->SetValue(ResultJson);
+    });
+    
+    // The command may need the game thread to finish, so keep running its continuations while we wait
+    const bool bOnGameThread = IsInGameThread();
+    while (!Future.WaitFor(FTimespan::FromMilliseconds(1)))
+    {
+        if (bOnGameThread)
+        {
+            FMCPGameThreadQueue::ProcessPending();
+        }
+    }
+    
+    return MakeCommandResponse(CommandType, Future.Get());
+}
+
+// Route a single command to its handler and call OnComplete with the response. Asynchronous
+// commands return straight away and complete later on whichever thread finishes them.
+void UUnrealMCPBridge::RunCommandAsync(const FString& CommandType, const TSharedPtr<FJsonObject>& Params, FMCPResultWriter* ResultWriter, FMCPCommandCompletion&& OnComplete)
+{
+    TSharedPtr<const FMCPCommandInfo> Command;
+    if (TSharedPtr<FJsonObject> ErrorJson = ValidateCommand(CommandType, Params, Command))
+    {
+        OnComplete(ErrorJson);
+        return;
+    }
+    
+    // Streamed results skip the response object entirely; the caller wraps the written bytes
+    if (Command->IsStreaming() && ResultWriter)
+    {
+        TSharedPtr<FJsonObject> ErrorJson;
         try
         {
-            TSharedPtr<FJsonObject> ResultJson;
-            
-            if (CommandType == TEXT("ping"))
-            {
-                ResultJson = MakeShareable(new FJsonObject);
-                ResultJson->SetStringField(TEXT("message"), TEXT("pong"));
-            }
-            // Editor Commands (including actor manipulation)
-            else if (CommandType == TEXT("get_actors_in_level") || 
-                     CommandType == TEXT("find_actors_by_name") ||
-                     CommandType == TEXT("spawn_actor") ||
-                     CommandType == TEXT("create_actor") ||
-                     CommandType == TEXT("delete_actor") || 
-                     CommandType == TEXT("set_actor_transform") ||
-                     CommandType == TEXT("get_actor_properties") ||
-                     CommandType == TEXT("set_actor_property") ||
-                     CommandType == TEXT("spawn_blueprint_actor") ||
-                     CommandType == TEXT("focus_viewport") || 
-                     CommandType == TEXT("take_screenshot"))
-            {
-                ResultJson = EditorCommands->HandleCommand(CommandType, Params);
-            }
-            // Blueprint Commands
-            else if (CommandType == TEXT("create_blueprint") || 
-                     CommandType == TEXT("add_component_to_blueprint") || 
-                     CommandType == TEXT("set_component_property") || 
-                     CommandType == TEXT("set_physics_properties") || 
-                     CommandType == TEXT("compile_blueprint") || 
-                     CommandType == TEXT("set_blueprint_property") || 
-                     CommandType == TEXT("set_static_mesh_properties") ||
-                     CommandType == TEXT("set_pawn_properties"))
-            {
-                ResultJson = BlueprintCommands->HandleCommand(CommandType, Params);
-            }
-            // Blueprint Node Commands
-            else if (CommandType == TEXT("connect_blueprint_nodes") || 
-                     CommandType == TEXT("add_blueprint_get_self_component_reference") ||
-                     CommandType == TEXT("add_blueprint_self_reference") ||
-                     CommandType == TEXT("find_blueprint_nodes") ||
-                     CommandType == TEXT("add_blueprint_event_node") ||
-                     CommandType == TEXT("add_blueprint_input_action_node") ||
-                     CommandType == TEXT("add_blueprint_function_node") ||
-                     CommandType == TEXT("add_blueprint_get_component_node") ||
-                     CommandType == TEXT("add_blueprint_variable"))
-            {
-                ResultJson = BlueprintNodeCommands->HandleCommand(CommandType, Params);
-            }
-            // Project Commands
-            else if (CommandType == TEXT("create_input_mapping"))
-            {
-                ResultJson = ProjectCommands->HandleCommand(CommandType, Params);
-            }
-            // UMG Commands
-            else if (CommandType == TEXT("create_umg_widget_blueprint") ||
-                     CommandType == TEXT("add_text_block_to_widget") ||
-                     CommandType == TEXT("add_button_to_widget") ||
-                     CommandType == TEXT("bind_widget_event") ||
-                     CommandType == TEXT("set_text_block_binding") ||
-                     CommandType == TEXT("add_widget_to_viewport"))
-            {
-                ResultJson = UMGCommands->HandleCommand(CommandType, Params);
-            }
-            else
-            {
-                ResponseJson->SetStringField(TEXT("status"), TEXT("error"));
-                ResponseJson->SetStringField(TEXT("error"), FString::Printf(TEXT("Unknown command: %s"), *CommandType));
-                
-                FString ResultString;
-                TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&ResultString);
-                FJsonSerializer::Serialize(ResponseJson.ToSharedRef(), Writer);
-                Promise.SetValue(ResultString);
-                return;
-            }
-            
-            // Check if the result contains an error
-            bool bSuccess = true;
-            FString ErrorMessage;
-            
-            if (ResultJson->HasField(TEXT("success")))
+            ErrorJson = Command->StreamingHandler.Execute(Params, *ResultWriter);
+        }
+        catch (const std::exception& e)
+        {
+            ErrorJson = FUnrealMCPCommonUtils::CreateErrorResponse(UTF8_TO_TCHAR(e.what()));
+        }
+        
+        if (ErrorJson.IsValid())
+        {
+            ResultWriter->Reset();
+            OnComplete(MakeCommandResponse(CommandType, ErrorJson));
+        }
+        else
+        {
+            OnComplete(nullptr);
+        }
+        return;
+    }
+    
+    if (!Command->IsAsync())
+    {
+        OnComplete(InvokeHandler(*Command, CommandType, Params));
+        return;
+    }
+    
+    Command->AsyncHandler.Execute(Params, [CommandType, OnComplete = MoveTemp(OnComplete)](TSharedPtr<FJsonObject> ResultJson)
+    {
+        OnComplete(MakeCommandResponse(CommandType, ResultJson));
+    });
+}
+
+TSharedPtr<FJsonObject> UUnrealMCPBridge::HandlePing(const TSharedPtr<FJsonObject>& Params)
+{
+    TSharedPtr<FJsonObject> ResultJson = MakeShareable(new FJsonObject);
+    ResultJson->SetStringField(TEXT("message"), TEXT("pong"));
+    return ResultJson;
+}
+
+TSharedPtr<FJsonObject> UUnrealMCPBridge::HandleGetServerStats(const TSharedPtr<FJsonObject>& Params)
+{
+    TSharedPtr<FJsonObject> ResultJson = FMCPServerStats::Get().ToJson();
+    
+    bool bReset = false;
+    if (Params->TryGetBoolField(TEXT("reset"), bReset) && bReset)
+    {
+        FMCPServerStats::Get().Reset();
+    }
+    
+    return ResultJson;
+}
+
+TSharedPtr<FJsonObject> UUnrealMCPBridge::HandleListCommands(const TSharedPtr<FJsonObject>& Params)
+{
+    TArray<TSharedPtr<FJsonValue>> CommandsJson;
+    for (const TSharedPtr<const FMCPCommandInfo>& Command : FMCPCommandRegistry::Get().GetAll())
+    {
+        CommandsJson.Add(MakeShared<FJsonValueObject>(Command->ToJson()));
+    }
+    
+    TSharedPtr<FJsonObject> ResultJson = MakeShareable(new FJsonObject);
+    ResultJson->SetArrayField(TEXT("commands"), CommandsJson);
+    ResultJson->SetNumberField(TEXT("count"), CommandsJson.Num());
+    return ResultJson;
+}
+
+// Run an ordered list of commands in one go. Runs on the game thread like any other command,
+// so the whole batch costs a single hop.
+TSharedPtr<FJsonObject> UUnrealMCPBridge::HandleBatch(const TSharedPtr<FJsonObject>& Params)
+{
+    const TArray<TSharedPtr<FJsonValue>>* Commands = nullptr;
+    if (!Params->TryGetArrayField(TEXT("commands"), Commands))
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Missing 'commands' array"));
+    }
+    
+    bool bStopOnError = false;
+    Params->TryGetBoolField(TEXT("stop_on_error"), bStopOnError);
+    
+    // Run the whole batch as one blueprint edit session so each blueprint compiles once at the end
+    bool bDeferCompile = false;
+    Params->TryGetBoolField(TEXT("defer_compile"), bDeferCompile);
+    if (bDeferCompile)
+    {
+        FMCPBlueprintCompileQueue::Get().BeginSession();
+    }
+    
+    TArray<TSharedPtr<FJsonValue>> Results;
+    Results.Reserve(Commands->Num());
+    int32 NumFailed = 0;
+    bool bStopped = false;
+    
+    for (int32 Index = 0; Index < Commands->Num(); ++Index)
+    {
+        TSharedPtr<FJsonObject> SubResponse;
+        
+        // Each entry uses the same shape as a top-level request
+        const TSharedPtr<FJsonObject>* CommandObject = nullptr;
+        FString SubCommandType;
+        if (!(*Commands)[Index]->TryGetObject(CommandObject) ||
+            (!(*CommandObject)->TryGetStringField(TEXT("type"), SubCommandType) && !(*CommandObject)->TryGetStringField(TEXT("command"), SubCommandType)))
+        {
+            SubResponse = MakeShareable(new FJsonObject);
+            SubResponse->SetStringField(TEXT("status"), TEXT("error"));
+            SubResponse->SetStringField(TEXT("error"), FString::Printf(TEXT("Batch entry %d is missing a 'type' field"), Index));
+        }
+        else if (SubCommandType == TEXT("batch"))
+        {
+            SubResponse = MakeShareable(new FJsonObject);
+            SubResponse->SetStringField(TEXT("status"), TEXT("error"));
+            SubResponse->SetStringField(TEXT("error"), TEXT("Nested batches are not supported"));
+        }
+        else
+        {
+            TSharedPtr<FJsonObject> SubParams = MakeShareable(new FJsonObject);
+            const TSharedPtr<FJsonObject>* SubParamsObject = nullptr;
+            if ((*CommandObject)->TryGetObjectField(TEXT("params"), SubParamsObject))
             {
-                bSuccess = ResultJson->GetBoolField(TEXT("success"));
-                if (!bSuccess && ResultJson->HasField(TEXT("error")))
-                {
-                    ErrorMessage = ResultJson->GetStringField(TEXT("error"));
-                }
+                SubParams = *SubParamsObject;
             }
             
-            if (bSuccess)
-            {
-                // Set success status and include the result
-                ResponseJson->SetStringField(TEXT("status"), TEXT("success"));
-                ResponseJson->SetObjectField(TEXT("result"), ResultJson);
-            }
-            else
+            SubResponse = RunCommand(SubCommandType, SubParams);
+        }
+        
+        const bool bFailed = SubResponse->GetStringField(TEXT("status")) != TEXT("success");
+        Results.Add(MakeShared<FJsonValueObject>(SubResponse));
+        
+        if (bFailed)
+        {
+            ++NumFailed;
+            if (bStopOnError)
             {
-                // Set error status and include the error message
-                ResponseJson->SetStringField(TEXT("status"), TEXT("error"));
-                ResponseJson->SetStringField(TEXT("error"), ErrorMessage);
+                bStopped = true;
+                break;
             }
         }
-        catch (const std::exception& e)
+    }
+    
+    UE_LOG(LogUnrealMCP, Verbose, TEXT("UnrealMCPBridge: Batch ran %d of %d commands, %d failed"), Results.Num(), Commands->Num(), NumFailed);
+    
+    TSharedPtr<FJsonObject> ResultJson = MakeShareable(new FJsonObject);
+    ResultJson->SetArrayField(TEXT("results"), Results);
+    ResultJson->SetNumberField(TEXT("executed"), Results.Num());
+    ResultJson->SetNumberField(TEXT("failed"), NumFailed);
+    ResultJson->SetBoolField(TEXT("stopped_on_error"), bStopped);
+    
+    if (bDeferCompile)
+    {
+        // A sub-command may already have closed the session with end_blueprint_edits
+        TSharedPtr<FJsonObject> CompileReport = FMCPBlueprintCompileQueue::Get().EndSession();
+        if (CompileReport.IsValid())
         {
-            ResponseJson->SetStringField(TEXT("status"), TEXT("error"));
-            ResponseJson->SetStringField(TEXT("error"), UTF8_TO_TCHAR(e.what()));
+            ResultJson->SetObjectField(TEXT("compile_report"), CompileReport);
         }
-        
-        FString ResultString;
-        TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&ResultString);
-        FJsonSerializer::Serialize(ResponseJson.ToSharedRef(), Writer);
-        Promise.SetValue(ResultString);
-    });
+    }
     
-    return Future.Get();
-}
\ No newline at end of file
+    return ResultJson;
+}
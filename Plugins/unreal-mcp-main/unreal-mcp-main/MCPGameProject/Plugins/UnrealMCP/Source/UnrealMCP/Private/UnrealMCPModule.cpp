@@ -1,19 +1,22 @@
 #include "UnrealMCPModule.h"
 #include "UnrealMCPBridge.h"
+#include "MCPLog.h"
 #include "Modules/ModuleManager.h"
 #include "EditorSubsystem.h"
 #include "Editor.h"
 
+DEFINE_LOG_CATEGORY(LogUnrealMCP);
+
 #define LOCTEXT_NAMESPACE "FUnrealMCPModule"
 
 void FUnrealMCPModule::StartupModule()
 {
-	UE_LOG(LogTemp, Display, TEXT("Unreal MCP Module has started"));
+	UE_LOG(LogUnrealMCP, Display, TEXT("Unreal MCP Module has started"));
 }
 
 void FUnrealMCPModule::ShutdownModule()
 {
-	UE_LOG(LogTemp, Display, TEXT("Unreal MCP Module has shut down"));
+	UE_LOG(LogUnrealMCP, Display, TEXT("Unreal MCP Module has shut down"));
 }
 
 #undef LOCTEXT_NAMESPACE
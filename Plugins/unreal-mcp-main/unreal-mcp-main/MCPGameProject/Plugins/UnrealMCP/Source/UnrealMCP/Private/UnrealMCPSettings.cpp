@@ -0,0 +1,6 @@
+#include "UnrealMCPSettings.h"
+
+UUnrealMCPSettings::UUnrealMCPSettings()
+{
+    SectionName = TEXT("UnrealMCP");
+}
@@ -3,6 +3,8 @@
 #include "CoreMinimal.h"
 #include "Json.h"
 
+class FMCPCommandRegistry;
+
 /**
  * Handler class for Blueprint-related MCP commands
  */
@@ -11,8 +13,8 @@ class UNREALMCP_API FUnrealMCPBlueprintCommands
 public:
     FUnrealMCPBlueprintCommands();
 
-    // Handle blueprint commands
-    TSharedPtr<FJsonObject> HandleCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params);
+    // Register the blueprint commands with the command registry
+    void RegisterCommands(FMCPCommandRegistry& Registry, FName Owner);
 
 private:
     // Specific blueprint command handlers
@@ -21,6 +23,9 @@ private:
     TSharedPtr<FJsonObject> HandleSetComponentProperty(const TSharedPtr<FJsonObject>& Params);
     TSharedPtr<FJsonObject> HandleSetPhysicsProperties(const TSharedPtr<FJsonObject>& Params);
     TSharedPtr<FJsonObject> HandleCompileBlueprint(const TSharedPtr<FJsonObject>& Params);
+    TSharedPtr<FJsonObject> HandleBeginBlueprintEdits(const TSharedPtr<FJsonObject>& Params);
+    TSharedPtr<FJsonObject> HandleFlushBlueprintCompiles(const TSharedPtr<FJsonObject>& Params);
+    TSharedPtr<FJsonObject> HandleEndBlueprintEdits(const TSharedPtr<FJsonObject>& Params);
     TSharedPtr<FJsonObject> HandleSpawnBlueprintActor(const TSharedPtr<FJsonObject>& Params);
     TSharedPtr<FJsonObject> HandleSetBlueprintProperty(const TSharedPtr<FJsonObject>& Params);
     TSharedPtr<FJsonObject> HandleSetStaticMeshProperties(const TSharedPtr<FJsonObject>& Params);
@@ -16,6 +16,7 @@ class UK2Node_VariableSet;
 class UK2Node_InputAction;
 class UK2Node_Self;
 class UFunction;
+class FMCPResultWriter;
 
 /**
  * Common utilities for UnrealMCP commands
@@ -35,6 +36,8 @@ public:
     // Actor utilities
     static TSharedPtr<FJsonValue> ActorToJson(AActor* Actor);
     static TSharedPtr<FJsonObject> ActorToJsonObject(AActor* Actor, bool bDetailed = false);
+    // Same fields as ActorToJsonObject, written straight to a streaming result
+    static void WriteActor(FMCPResultWriter& Writer, AActor* Actor);
     
     // Blueprint utilities
     static UBlueprint* FindBlueprint(const FString& BlueprintName);
@@ -2,6 +2,8 @@
 
 #include "CoreMinimal.h"
 #include "Json.h"
+#include "MCPActorIndex.h"
+#include "MCPCommandRegistry.h"
 
 /**
  * Handler class for Editor-related MCP commands
@@ -11,14 +13,14 @@ class UNREALMCP_API FUnrealMCPEditorCommands {
 public:
   FUnrealMCPEditorCommands();
 
-  // Handle editor commands
-  TSharedPtr<FJsonObject> HandleCommand(const FString &CommandType,
-                                        const TSharedPtr<FJsonObject> &Params);
+  // Register the editor commands with the command registry
+  void RegisterCommands(FMCPCommandRegistry &Registry, FName Owner);
 
 private:
-  // Actor manipulation commands
+  // Actor manipulation commands. The list and property dump stream their results
   TSharedPtr<FJsonObject>
-  HandleGetActorsInLevel(const TSharedPtr<FJsonObject> &Params);
+  HandleGetActorsInLevel(const TSharedPtr<FJsonObject> &Params,
+                         FMCPResultWriter &Writer);
   TSharedPtr<FJsonObject>
   HandleFindActorsByName(const TSharedPtr<FJsonObject> &Params);
   TSharedPtr<FJsonObject>
@@ -28,7 +30,8 @@ private:
   TSharedPtr<FJsonObject>
   HandleSetActorTransform(const TSharedPtr<FJsonObject> &Params);
   TSharedPtr<FJsonObject>
-  HandleGetActorProperties(const TSharedPtr<FJsonObject> &Params);
+  HandleGetActorProperties(const TSharedPtr<FJsonObject> &Params,
+                           FMCPResultWriter &Writer);
   TSharedPtr<FJsonObject>
   HandleSetActorProperty(const TSharedPtr<FJsonObject> &Params);
 
@@ -39,12 +42,12 @@ private:
   // Editor viewport commands
   TSharedPtr<FJsonObject>
   HandleFocusViewport(const TSharedPtr<FJsonObject> &Params);
-  TSharedPtr<FJsonObject>
-  HandleTakeScreenshot(const TSharedPtr<FJsonObject> &Params);
+  void HandleTakeScreenshot(const TSharedPtr<FJsonObject> &Params,
+                            FMCPCommandCompletion OnComplete);
 
   // Landscape commands
-  TSharedPtr<FJsonObject>
-  HandleCreateLandscape(const TSharedPtr<FJsonObject> &Params);
+  void HandleCreateLandscape(const TSharedPtr<FJsonObject> &Params,
+                             FMCPCommandCompletion OnComplete);
 
   // Level commands
   TSharedPtr<FJsonObject>
@@ -53,4 +56,7 @@ private:
   // Scripting commands
   TSharedPtr<FJsonObject>
   HandleRunPython(const TSharedPtr<FJsonObject> &Params);
+
+  // Name and label lookup for the actor commands
+  FMCPActorIndex ActorIndex;
 };
\ No newline at end of file
@@ -3,6 +3,8 @@
 #include "CoreMinimal.h"
 #include "Json.h"
 
+class FMCPCommandRegistry;
+
 /**
  * Handler class for Project-wide MCP commands
  */
@@ -11,8 +13,8 @@ class UNREALMCP_API FUnrealMCPProjectCommands
 public:
     FUnrealMCPProjectCommands();
 
-    // Handle project commands
-    TSharedPtr<FJsonObject> HandleCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params);
+    // Register the project commands with the command registry
+    void RegisterCommands(FMCPCommandRegistry& Registry, FName Owner);
 
 private:
     // Specific project command handlers
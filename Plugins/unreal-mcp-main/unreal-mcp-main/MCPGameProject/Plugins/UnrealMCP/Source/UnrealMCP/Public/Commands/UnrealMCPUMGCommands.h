@@ -3,6 +3,8 @@
 #include "CoreMinimal.h"
 #include "Json.h"
 
+class FMCPCommandRegistry;
+
 /**
  * Handles UMG (Widget Blueprint) related MCP commands
  * Responsible for creating and modifying UMG Widget Blueprints,
@@ -14,12 +16,11 @@ public:
     FUnrealMCPUMGCommands();
 
     /**
-     * Handle UMG-related commands
-     * @param CommandType - The type of command to handle
-     * @param Params - JSON parameters for the command
-     * @return JSON response with results or error
+     * Register the UMG-related commands with the command registry
+     * @param Registry - Registry to add the commands to
+     * @param Owner - Owner name the commands are registered under
      */
-    TSharedPtr<FJsonObject> HandleCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params);
+    void RegisterCommands(FMCPCommandRegistry& Registry, FName Owner);
 
 private:
     /**
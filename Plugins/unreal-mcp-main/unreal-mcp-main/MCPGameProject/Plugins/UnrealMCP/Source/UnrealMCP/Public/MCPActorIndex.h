@@ -0,0 +1,112 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/WeakObjectPtr.h"
+
+class AActor;
+class UWorld;
+
+/** How FMCPActorIndex::Search matches a pattern against actor names and labels. Always case-insensitive */
+enum class EMCPActorMatch : uint8
+{
+	Exact,
+	Prefix,
+	Contains
+};
+
+/**
+ * Name and label index over the actors in the editor world.
+ * Kept current from the engine's actor added, deleted and label-changed events, so finding an
+ * actor by name is a hash lookup instead of a walk over every actor in the level.
+ * Changes the events don't describe (level loads, undo, switching worlds) mark the index stale
+ * and it is rebuilt on the next query. Game thread only.
+ */
+class UNREALMCP_API FMCPActorIndex
+{
+public:
+	FMCPActorIndex();
+	~FMCPActorIndex();
+
+	/** Subscribe to editor actor events. The index itself is built lazily on first use */
+	void Start();
+
+	/** Unsubscribe and drop everything indexed */
+	void Stop();
+
+	/** Find an actor by object name, falling back to its label. Returns nullptr if neither matches */
+	AActor* FindActor(const FString& NameOrLabel);
+
+	/** Actors whose name or label matches Pattern, sorted by name. Each actor appears once */
+	TArray<AActor*> Search(const FString& Pattern, EMCPActorMatch Match);
+
+	/** Number of actors currently indexed */
+	int32 Num();
+
+private:
+	struct FIndexedActor
+	{
+		TWeakObjectPtr<AActor> Actor;
+		FName Name;
+		FString Label;
+
+		/** Tells this entry's sorted keys apart from those left behind by an earlier entry for the same actor */
+		uint32 Generation;
+	};
+
+	/** Entry in the sorted key list used for prefix and substring search */
+	struct FSortedKey
+	{
+		FString Key;
+		const AActor* Actor;
+		uint32 Generation;
+	};
+
+	/** Rebuild if the editor world changed or the index was marked stale. Returns the indexed world */
+	UWorld* Refresh();
+	void Rebuild(UWorld* World);
+
+	void AddActor(AActor* Actor);
+	void RemoveActor(const AActor* Actor);
+	void SortKeysIfNeeded();
+
+	/** Drop the sorted keys of removed entries once they make up a quarter of the list */
+	void CompactKeysIfNeeded();
+
+	/** True if the key still belongs to a current entry */
+	bool IsLive(const FSortedKey& SortedKey) const;
+
+	/** Return the live actor for an entry, dropping or re-keying entries that went stale behind our back */
+	AActor* Resolve(const AActor* Key);
+
+	void OnActorAdded(AActor* Actor);
+	void OnActorDeleted(AActor* Actor);
+	void OnActorLabelChanged(AActor* Actor);
+	void OnActorListChanged();
+
+	TWeakObjectPtr<UWorld> IndexedWorld;
+
+	/** Pointers are only used as keys; the weak pointer in the entry decides whether the actor is still alive */
+	TMap<const AActor*, FIndexedActor> Entries;
+	TMultiMap<FName, const AActor*> ByName;
+	TMultiMap<FString, const AActor*> ByLabel;
+
+	/**
+	 * Names and labels, sorted case-insensitively on demand after the key set changes.
+	 * Removing an actor leaves its keys in place, dead, so bulk deletes don't rescan the list per actor
+	 */
+	TArray<FSortedKey> SortedKeys;
+
+	/** Dead keys in SortedKeys */
+	int32 NumDeadKeys;
+
+	/** Generation given to the next entry added */
+	uint32 NextGeneration;
+
+	bool bNeedsRebuild;
+	bool bKeysNeedSort;
+
+	FDelegateHandle ActorAddedHandle;
+	FDelegateHandle ActorDeletedHandle;
+	FDelegateHandle ActorListChangedHandle;
+	FDelegateHandle ActorLabelChangedHandle;
+};
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/SoftObjectPath.h"
+#include "UObject/StrongObjectPtr.h"
+
+class UBlueprint;
+class UObject;
+struct FAssetData;
+
+/**
+ * Resolves blueprint names sent by MCP clients to blueprint assets.
+ * Short names are looked up in a map built from the Asset Registry, so blueprints are found
+ * anywhere in the content tree, not just under /Game/Blueprints. The map is kept current from
+ * the registry's added, removed and renamed events. The most recently used blueprints are held
+ * loaded so chains of edits on the same blueprint skip the package lookup. Game thread only.
+ */
+class UNREALMCP_API FMCPBlueprintCache
+{
+public:
+	static FMCPBlueprintCache& Get();
+
+	/** Subscribe to Asset Registry and editor delete events. The name map is built on first use */
+	void Start();
+
+	/** Unsubscribe, drop the name map and release every resident blueprint */
+	void Stop();
+
+	/**
+	 * Find and load a blueprint. Accepts a short asset name ("BP_Door"), a path relative to
+	 * /Game/Blueprints ("Doors/BP_Door") or a full package or object path ("/Game/Props/BP_Door").
+	 * When several blueprints share a short name, the one under /Game/Blueprints wins.
+	 */
+	UBlueprint* FindBlueprint(const FString& BlueprintName);
+
+	/** The asset a name resolves to, without loading it. Invalid if nothing matches */
+	FSoftObjectPath ResolvePath(const FString& BlueprintName);
+
+private:
+	FMCPBlueprintCache();
+
+	void Refresh();
+	void AddAsset(const FAssetData& AssetData);
+	void RemovePath(FName AssetName, const FSoftObjectPath& Path);
+
+	/** Move a blueprint to the front of the resident list, evicting the least recently used */
+	void Touch(UBlueprint* Blueprint);
+	void Evict(const FSoftObjectPath& Path);
+
+	void OnAssetAdded(const FAssetData& AssetData);
+	void OnAssetRemoved(const FAssetData& AssetData);
+	void OnAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath);
+	void OnAssetsPreDelete(const TArray<UObject*>& Objects);
+
+	/** Blueprint asset paths by short asset name. Names are rarely shared, so one inline slot is enough */
+	TMap<FName, TArray<FSoftObjectPath, TInlineAllocator<1>>> PathsByName;
+
+	/** Recently used blueprints, most recent last */
+	TArray<TStrongObjectPtr<UBlueprint>> Resident;
+
+	bool bNeedsRebuild;
+
+	FDelegateHandle AssetAddedHandle;
+	FDelegateHandle AssetRemovedHandle;
+	FDelegateHandle AssetRenamedHandle;
+	FDelegateHandle AssetsPreDeleteHandle;
+};
@@ -0,0 +1,101 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"
+#include "UObject/WeakObjectPtr.h"
+
+class UBlueprint;
+
+/**
+ * Defers blueprint compilation while an edit session is open.
+ * Handlers call RequestCompile or MarkDirty rather than compiling themselves. Outside a session
+ * RequestCompile compiles straight away, as before. Inside one, the blueprint joins a dirty set
+ * and is compiled exactly once when the session ends or is flushed, after any parent or other
+ * dirty blueprint it depends on. Sessions nest.
+ * Sessions belong to the client that opened them: calls act on the client set with FScopedClient,
+ * so one client's open session never holds up another's compiles, and EndClient cleans up after a
+ * client that disconnects without closing its session. Game thread only.
+ */
+class UNREALMCP_API FMCPBlueprintCompileQueue
+{
+public:
+	static FMCPBlueprintCompileQueue& Get();
+
+	/** Client for calls that don't come from a client session */
+	static constexpr int32 NoClient = INDEX_NONE;
+
+	/** Attribute calls on the game thread to Client until the scope ends. Does nothing on other threads */
+	class UNREALMCP_API FScopedClient
+	{
+	public:
+		explicit FScopedClient(int32 Client);
+		~FScopedClient();
+
+	private:
+		int32 PreviousClient;
+		bool bActive;
+	};
+
+	/** Open a session. Compiles are held until the outermost session ends */
+	void BeginSession();
+
+	/**
+	 * Close a session. Closing the outermost one compiles everything dirty.
+	 * Returns the compile report, or null if no session was open.
+	 */
+	TSharedPtr<FJsonObject> EndSession();
+
+	/** Compile everything dirty now, leaving any session open. Returns the compile report */
+	TSharedPtr<FJsonObject> Flush();
+
+	/** True if the current client has a session open */
+	bool IsSessionOpen() const;
+
+	/** Compile now outside a session, otherwise queue for the end of it. Returns true if it compiled */
+	bool RequestCompile(UBlueprint* Blueprint);
+
+	/**
+	 * Like RequestCompile, then save the blueprint's package once it has compiled, so an uncompiled
+	 * blueprint is never saved. Inside a session the save waits for the compile. Returns true if it saved now
+	 */
+	bool RequestCompileAndSave(UBlueprint* Blueprint);
+
+	/** Note a modified blueprint so the open session compiles it. Does nothing outside a session */
+	void MarkDirty(UBlueprint* Blueprint);
+
+	int32 NumDirty() const;
+
+	/** Compile one blueprint immediately and describe the result: status, errors, warnings and time taken */
+	static TSharedPtr<FJsonObject> CompileNow(UBlueprint* Blueprint);
+
+	/**
+	 * Client disconnected. Compiles whatever its still-open session left dirty, so the edits aren't
+	 * lost, and forgets the session
+	 */
+	void EndClient(int32 Client);
+
+	/** Close every client's sessions and forget the dirty sets without compiling */
+	void Reset();
+
+private:
+	FMCPBlueprintCompileQueue();
+
+	struct FClientSession
+	{
+		int32 Depth = 0;
+
+		/** Blueprints waiting for the session to end, in the order they were first marked */
+		TArray<TWeakObjectPtr<UBlueprint>> Dirty;
+
+		/** Dirty blueprints to save once they have compiled */
+		TArray<TWeakObjectPtr<UBlueprint>> NeedsSave;
+	};
+
+	/** Compile the session's dirty blueprints in dependency order, save those waiting to be, and empty both. Returns the compile report */
+	static TSharedPtr<FJsonObject> CompileDirty(FClientSession& Session);
+
+	/** Open sessions by client. A client without one has no entry */
+	TMap<int32, FClientSession> Sessions;
+
+	int32 CurrentClient;
+};
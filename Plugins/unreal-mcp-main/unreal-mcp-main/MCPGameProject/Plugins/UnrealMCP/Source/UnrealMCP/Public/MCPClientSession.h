@@ -0,0 +1,128 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+#include "HAL/CriticalSection.h"
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+#include "MCPMessageFraming.h"
+#include "MCPResponseEncoder.h"
+#include "MCPResultWriter.h"
+#include "MCPSharedMemoryRing.h"
+#include "MCPTransport.h"
+#include <atomic>
+
+class UUnrealMCPBridge;
+class FRunnableThread;
+class FEvent;
+
+/**
+ * Write side of a client connection, shared between the session and its in-flight commands.
+ * Commands finish on the game thread or on workers, possibly after the session is gone, so they
+ * send through this channel, which serializes writes and drops responses once the socket is closed.
+ */
+class FMCPSessionChannel
+{
+public:
+	FMCPSessionChannel(TUniquePtr<IMCPConnection>&& InConnection);
+	~FMCPSessionChannel();
+
+	/**
+	 * Encode a response object in Format, tagging it with the request id if there is one, then frame
+	 * and send it. Safe to call from any thread. Timings go to CommandType's stats if given.
+	 */
+	bool SendResponse(const TSharedPtr<FJsonObject>& Response, const TSharedPtr<FJsonValue>& RequestId, const FMCPResponseFormat& Format, const FString& CommandType = FString());
+
+	/** Wrap a result a streaming command wrote in Format's encoding in a success response and send it */
+	bool SendStreamedResponse(const FMCPResultWriter& Result, const TSharedPtr<FJsonValue>& RequestId, const FMCPResponseFormat& Format, const FString& CommandType = FString());
+
+	/** Close the connection. Later sends are dropped */
+	void Close();
+
+	/**
+	 * Give this connection a shared-memory ring. Later responses of at least Threshold bytes go
+	 * through it when they fit. Returns false and sets OutError if the transport can't share memory.
+	 */
+	bool OpenSharedMemory(const FString& Name, int64 Capacity, int32 Threshold, FString& OutError);
+
+	/** Framing mode responses are sent with. Set once the first message has been framed */
+	void SetFramingMode(EMCPFramingMode InMode) { Mode = InMode; }
+
+	/** Pipelined request bookkeeping */
+	void BeginRequest() { ++NumInFlight; }
+	void EndRequest();
+	int32 GetNumInFlight() const { return NumInFlight; }
+
+	/** Block until a pipelined request finishes or the timeout expires */
+	void WaitForCompletion(const FTimespan& Timeout);
+
+private:
+	bool SendEncoded(const TArray<uint8>& Payload, bool bBinary, const FString& CommandType);
+	bool SendAll(const uint8* Data, int32 Count);
+
+	FCriticalSection SendLock;
+	TUniquePtr<IMCPConnection> Connection;
+	TUniquePtr<FMCPSharedMemoryRing> SharedMemory;
+	int32 SharedMemoryThreshold;
+	std::atomic<bool> bClosing;
+	std::atomic<EMCPFramingMode> Mode;
+	std::atomic<int32> NumInFlight;
+	FEvent* CompletionEvent;
+};
+
+/**
+ * One connected MCP client.
+ * Each session runs on its own thread and blocks in IMCPConnection::WaitForRead until data arrives,
+ * so idle connections cost no CPU and a slow client never holds up another one.
+ * Requests carrying an "id" are pipelined: they are dispatched without waiting and their
+ * responses, tagged with the same id, are written as each one completes. Requests without
+ * an id are answered in order, one at a time.
+ */
+class FMCPClientSession : public FRunnable
+{
+public:
+	FMCPClientSession(UUnrealMCPBridge* InBridge, TUniquePtr<IMCPConnection>&& InConnection, int32 InSessionId, const FMCPTransportConfig& InConfig);
+	virtual ~FMCPClientSession();
+
+	/** Start the session thread */
+	bool Start();
+
+	/** True once the client has disconnected and the session thread has left its loop */
+	bool IsFinished() const { return bFinished; }
+
+	int32 GetSessionId() const { return SessionId; }
+
+	// FRunnable interface
+	virtual uint32 Run() override;
+	virtual void Stop() override;
+
+protected:
+	void ProcessMessage(const TArray<uint8>& Message);
+	void SendError(const FString& Error, const TSharedPtr<FJsonValue>& RequestId);
+
+	/** Answer open_shared_memory, which is about this connection rather than the editor */
+	void OpenSharedMemory(const TSharedPtr<FJsonValue>& RequestId);
+
+	/** Answer set_encoding, which changes the default response format for this connection */
+	void SetEncoding(const TSharedPtr<FJsonObject>& Params, const TSharedPtr<FJsonValue>& RequestId);
+
+private:
+	UUnrealMCPBridge* Bridge;
+
+	// Owned by the channel. Only this session's thread reads from it.
+	IMCPConnection* Connection;
+
+	FRunnableThread* Thread;
+	int32 SessionId;
+	FMCPTransportConfig Config;
+
+	FMCPMessageFramer Framer;
+
+	// Response format for requests that don't ask for one. Only touched on the session thread
+	FMCPResponseFormat DefaultFormat;
+
+	TSharedRef<FMCPSessionChannel, ESPMode::ThreadSafe> Channel;
+
+	std::atomic<bool> bRunning;
+	std::atomic<bool> bFinished;
+};
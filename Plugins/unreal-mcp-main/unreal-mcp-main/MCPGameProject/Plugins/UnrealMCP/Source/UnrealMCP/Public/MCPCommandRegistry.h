@@ -0,0 +1,177 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"
+#include "HAL/CriticalSection.h"
+
+class FMCPResultWriter;
+
+/**
+ * Handler for a single MCP command.
+ * Returns the result object, or an error response from FUnrealMCPCommonUtils::CreateErrorResponse.
+ */
+DECLARE_DELEGATE_RetVal_OneParam(TSharedPtr<FJsonObject>, FMCPCommandHandler, const TSharedPtr<FJsonObject>& /* Params */);
+
+/** Receives the result of an asynchronous command. May be called from any thread */
+using FMCPCommandCompletion = TFunction<void(TSharedPtr<FJsonObject>)>;
+
+/**
+ * Handler for a command that finishes later, e.g. after work on a background task.
+ * Called on the game thread like a normal handler, and must call OnComplete exactly once,
+ * from any thread, with the same kind of result a normal handler would return.
+ * Work that has to come back to the game thread must go through FMCPGameThreadQueue rather
+ * than AsyncTask, as batch blocks the game thread while it waits for the command.
+ */
+DECLARE_DELEGATE_TwoParams(FMCPAsyncCommandHandler, const TSharedPtr<FJsonObject>& /* Params */, FMCPCommandCompletion /* OnComplete */);
+
+/**
+ * Handler for a command with large results, which it writes straight to Writer instead of
+ * building an FJsonObject tree. Writes exactly one value, normally an object, and returns null,
+ * or returns an error response from FUnrealMCPCommonUtils::CreateErrorResponse, in which case
+ * whatever it wrote is thrown away. Callers that need a result object get one parsed from JSON.
+ */
+DECLARE_DELEGATE_RetVal_TwoParams(TSharedPtr<FJsonObject>, FMCPStreamingCommandHandler, const TSharedPtr<FJsonObject>& /* Params */, FMCPResultWriter& /* Writer */);
+
+/**
+ * Game thread continuations for asynchronous commands.
+ * Queued work runs on the next game thread tick, or straight away if the game thread is
+ * blocked waiting for an asynchronous command to finish.
+ */
+class UNREALMCP_API FMCPGameThreadQueue
+{
+public:
+	/** Queue Work to run on the game thread. Safe to call from any thread */
+	static void Enqueue(TUniqueFunction<void()>&& Work);
+
+	/** Run everything queued so far. Game thread only */
+	static void ProcessPending();
+};
+
+/**
+ * One entry in a command's parameter schema
+ */
+struct UNREALMCP_API FMCPCommandParam
+{
+	FMCPCommandParam(const TCHAR* InName, const TCHAR* InType, bool bInRequired)
+		: Name(InName)
+		, Type(InType)
+		, bRequired(bInRequired)
+	{
+	}
+
+	/** Field name in the params object */
+	FString Name;
+
+	/** Expected JSON type: string, number, boolean, vector, array, object or any */
+	FString Type;
+
+	/** Requests without this field are rejected before the handler runs */
+	bool bRequired;
+};
+
+/**
+ * A registered command: its handler plus the metadata used for dispatch and introspection.
+ * Built with chained setters, e.g.
+ *   FMCPCommandInfo(TEXT("delete_actor"), TEXT("Delete an actor"), Handler).Param(TEXT("name"), TEXT("string"), true)
+ */
+struct UNREALMCP_API FMCPCommandInfo
+{
+	FMCPCommandInfo(FName InName, const TCHAR* InDescription, FMCPCommandHandler InHandler)
+		: Name(InName)
+		, Description(InDescription)
+		, Handler(MoveTemp(InHandler))
+	{
+	}
+
+	FMCPCommandInfo(FName InName, const TCHAR* InDescription, FMCPAsyncCommandHandler InAsyncHandler)
+		: Name(InName)
+		, Description(InDescription)
+		, AsyncHandler(MoveTemp(InAsyncHandler))
+	{
+	}
+
+	FMCPCommandInfo(FName InName, const TCHAR* InDescription, FMCPStreamingCommandHandler InStreamingHandler)
+		: Name(InName)
+		, Description(InDescription)
+		, StreamingHandler(MoveTemp(InStreamingHandler))
+	{
+	}
+
+	FMCPCommandInfo& Param(const TCHAR* ParamName, const TCHAR* ParamType, bool bRequired = false)
+	{
+		Params.Emplace(ParamName, ParamType, bRequired);
+		return *this;
+	}
+
+	/** Mark the command as not modifying the editor or any asset */
+	FMCPCommandInfo& ReadOnly()
+	{
+		bReadOnly = true;
+		return *this;
+	}
+
+	/** Mark the command as safe to run off the game thread */
+	FMCPCommandInfo& AnyThread()
+	{
+		bRequiresGameThread = false;
+		return *this;
+	}
+
+	/** True if the command completes through AsyncHandler rather than returning from Handler */
+	bool IsAsync() const { return AsyncHandler.IsBound(); }
+
+	/** True if the command writes its result through StreamingHandler */
+	bool IsStreaming() const { return StreamingHandler.IsBound(); }
+
+	/** Returns the name of the first required parameter missing from Params, or an empty string */
+	FString FindMissingParam(const TSharedPtr<FJsonObject>& InParams) const;
+
+	/** Describe the command for list_commands */
+	TSharedPtr<FJsonObject> ToJson() const;
+
+	FName Name;
+	FString Description;
+	FMCPCommandHandler Handler;
+	FMCPAsyncCommandHandler AsyncHandler;
+	FMCPStreamingCommandHandler StreamingHandler;
+	TArray<FMCPCommandParam> Params;
+	bool bReadOnly = false;
+	bool bRequiresGameThread = true;
+
+	/** Who registered the command, used to remove a plugin's commands in one go */
+	FName Owner;
+};
+
+/**
+ * Maps command names to handlers.
+ * Lookup is a single FName hash, so dispatch cost doesn't grow with the number of commands.
+ * Other plugins can add their own commands through FMCPCommandRegistry::Get().Register().
+ * Safe to use from any thread.
+ */
+class UNREALMCP_API FMCPCommandRegistry
+{
+public:
+	static FMCPCommandRegistry& Get();
+
+	/** Add a command. Fails, logging an error, if it has no handler or its name is already registered */
+	bool Register(FName Owner, FMCPCommandInfo Info);
+
+	/** Remove a single command */
+	bool Unregister(FName Name);
+
+	/** Remove every command added by Owner. Returns the number removed */
+	int32 UnregisterAll(FName Owner);
+
+	/** Look up a command. The returned info stays valid even if the command is unregistered meanwhile */
+	TSharedPtr<const FMCPCommandInfo> Find(FName Name) const;
+
+	/** Look up a command by its name as sent on the wire, without adding unknown names to the name table */
+	TSharedPtr<const FMCPCommandInfo> Find(const FString& Name) const;
+
+	/** All registered commands, sorted by name */
+	TArray<TSharedPtr<const FMCPCommandInfo>> GetAll() const;
+
+private:
+	mutable FRWLock Lock;
+	TMap<FName, TSharedPtr<const FMCPCommandInfo>> Commands;
+};
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"
+
+/** Where a landscape's heights come from */
+enum class EMCPHeightmapSourceType : uint8
+{
+	/** Every sample at mid height */
+	Flat,
+	/** Seeded fractal noise */
+	Noise,
+	/** A 16-bit heightmap on disk: raw little-endian (.r16, .raw) or grayscale PNG */
+	File
+};
+
+/** A heightmap source and its settings, as given in create_landscape's heightmap parameter */
+struct FMCPHeightmapSource
+{
+	EMCPHeightmapSourceType Type = EMCPHeightmapSourceType::Flat;
+
+	/** File to read, for File sources */
+	FString FilePath;
+
+	/** Same seed and settings give the same terrain */
+	int32 Seed = 0;
+
+	/** Width of the largest noise features, in samples */
+	float FeatureSize = 256.0f;
+
+	/** Noise layers, each half the size and strength of the one before */
+	int32 Octaves = 5;
+
+	/** 0-1. How much of the height range the noise may use either side of the midpoint */
+	float Amplitude = 0.25f;
+};
+
+/**
+ * Fills landscape heightmaps without blocking the editor.
+ * Generate is safe to call from a background task. Noise is evaluated in parallel, one tile per
+ * landscape component. A raw file the same size as the landscape is read straight into the
+ * output; PNGs and other sizes go through a decode buffer that is freed before Generate returns.
+ */
+class UNREALMCP_API FMCPHeightmapGenerator
+{
+public:
+	/**
+	 * Read a heightmap parameter such as {"type": "noise", "seed": 7}. Game thread only, since
+	 * it also loads anything Generate will need. Returns false and sets OutError if it's invalid.
+	 */
+	static bool ParseSource(const TSharedPtr<FJsonObject>& Json, FMCPHeightmapSource& OutSource, FString& OutError);
+
+	/** Name of a source type as used in the heightmap parameter */
+	static const TCHAR* GetTypeName(EMCPHeightmapSourceType Type);
+
+	/**
+	 * Fill OutHeights with SizeX by SizeY samples, row by row. TileSize is the number of quads
+	 * per landscape component and sets the grain of the parallel work and progress logging.
+	 */
+	static bool Generate(const FMCPHeightmapSource& Source, int32 SizeX, int32 SizeY, int32 TileSize, TArray<uint16>& OutHeights, FString& OutError);
+};
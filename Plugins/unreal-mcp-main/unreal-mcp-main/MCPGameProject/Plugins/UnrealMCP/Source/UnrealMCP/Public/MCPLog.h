@@ -0,0 +1,36 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Logging/LogMacros.h"
+
+/**
+ * Most verbose level LogUnrealMCP messages are compiled in at. Define it for the whole build,
+ * e.g. MCP_LOG_COMPILE_VERBOSITY=Log, to strip request and payload logging out entirely.
+ */
+#ifndef MCP_LOG_COMPILE_VERBOSITY
+#define MCP_LOG_COMPILE_VERBOSITY All
+#endif
+
+/**
+ * Everything the plugin logs. Runs at Log by default; raise it at runtime with
+ * "Log LogUnrealMCP Verbose" for one line per request, or VeryVerbose to include payloads.
+ */
+UNREALMCP_API DECLARE_LOG_CATEGORY_EXTERN(LogUnrealMCP, Log, MCP_LOG_COMPILE_VERBOSITY);
+
+// Longest payload excerpt a VeryVerbose log line shows, in bytes
+const int32 MCPLOG_MAX_PAYLOAD_BYTES = 1024;
+
+/**
+ * Log the start of a UTF-8 payload at VeryVerbose. The bytes are only converted and formatted
+ * when the category would actually print them, so this costs a branch otherwise.
+ */
+inline void MCPLogPayload(const TCHAR* Context, const uint8* Data, int32 Count)
+{
+	if (UE_LOG_ACTIVE(LogUnrealMCP, VeryVerbose))
+	{
+		const int32 ShownCount = FMath::Min(Count, MCPLOG_MAX_PAYLOAD_BYTES);
+		const FUTF8ToTCHAR Excerpt(reinterpret_cast<const ANSICHAR*>(Data), ShownCount);
+		UE_LOG(LogUnrealMCP, VeryVerbose, TEXT("%s (%d bytes): %s%s"), Context, Count, *FString(Excerpt.Length(), Excerpt.Get()),
+			ShownCount < Count ? TEXT("...") : TEXT(""));
+	}
+}
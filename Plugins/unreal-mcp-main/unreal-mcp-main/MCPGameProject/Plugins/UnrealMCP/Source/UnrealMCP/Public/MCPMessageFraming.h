@@ -0,0 +1,108 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Growable byte ring buffer used to accumulate socket reads.
+ * Appending and consuming never shift the stored bytes, and capacity grows in powers of two.
+ */
+class UNREALMCP_API FMCPByteRingBuffer
+{
+public:
+	FMCPByteRingBuffer(int32 InitialCapacity = 16 * 1024);
+
+	/** Append bytes to the end of the buffer, growing it if needed */
+	void Append(const uint8* Data, int32 Count);
+
+	/** Drop bytes from the front of the buffer */
+	void Consume(int32 Count);
+
+	/** Copy bytes starting at Offset into Dest without consuming them */
+	void Peek(int32 Offset, uint8* Dest, int32 Count) const;
+
+	/** Read a single byte at Offset from the front */
+	uint8 At(int32 Offset) const { return Data[(Head + Offset) & (Data.Num() - 1)]; }
+
+	/** Number of buffered bytes */
+	int32 Num() const { return Count; }
+
+	/** Drop everything */
+	void Reset();
+
+private:
+	void Grow(int32 MinCapacity);
+
+	TArray<uint8> Data;
+	int32 Head;
+	int32 Count;
+};
+
+/**
+ * Framing modes a connection can use. The mode is picked from the first byte the client sends.
+ */
+enum class EMCPFramingMode : uint8
+{
+	/** Nothing received yet */
+	Undetermined,
+
+	/** UTF-8 JSON objects, optionally separated by newlines. Responses end with a newline. */
+	Newline,
+
+	/** Each message is preceded by a 4 byte big-endian length. Responses use the same prefix. */
+	LengthPrefixed
+};
+
+/**
+ * Splits a byte stream into complete messages.
+ * Incoming bytes are scanned incrementally, so each byte is looked at once no matter how the
+ * stream is split across reads, and back-to-back messages in a single read are all returned.
+ * In newline mode a message ends at the closing brace of the top-level JSON object, which also
+ * covers clients that send raw JSON without a terminator.
+ */
+class UNREALMCP_API FMCPMessageFramer
+{
+public:
+	/** Largest message accepted in either mode */
+	static constexpr int32 MaxMessageSize = 64 * 1024 * 1024;
+
+	FMCPMessageFramer();
+
+	/** Feed received bytes into the framer */
+	void Append(const uint8* Data, int32 Count);
+
+	/** Pop the next complete message as UTF-8 bytes. Returns false if no full message is buffered yet */
+	bool PopMessage(TArray<uint8>& OutMessage);
+
+	/** Wrap a UTF-8 response for sending on this connection */
+	void FrameResponse(const uint8* Data, int32 Count, TArray<uint8>& OutFrame) const { FrameResponse(Mode, Data, Count, OutFrame); }
+
+	/** Wrap a UTF-8 response for a connection using the given mode. Safe to call from any thread */
+	static void FrameResponse(EMCPFramingMode InMode, const uint8* Data, int32 Count, TArray<uint8>& OutFrame);
+
+	/** True if the stream is malformed and the connection should be dropped */
+	bool HasError() const { return bError; }
+
+	/** Description of the last framing error */
+	const FString& GetError() const { return Error; }
+
+	/** Framing mode picked for this connection */
+	EMCPFramingMode GetMode() const { return Mode; }
+
+private:
+	bool PopNewlineMessage(TArray<uint8>& OutMessage);
+	bool PopLengthPrefixedMessage(TArray<uint8>& OutMessage);
+	void SetError(const FString& InError);
+
+	FMCPByteRingBuffer Buffer;
+	EMCPFramingMode Mode;
+
+	// Newline mode scan state, carried over between reads
+	int32 ScanOffset;
+	int32 Depth;
+	bool bInString;
+	bool bEscape;
+	bool bStarted;
+
+	bool bError;
+	FString Error;
+};
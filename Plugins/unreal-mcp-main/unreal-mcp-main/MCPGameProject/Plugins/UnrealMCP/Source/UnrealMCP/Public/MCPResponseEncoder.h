@@ -0,0 +1,70 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"
+
+/** How a response is serialized */
+enum class EMCPEncoding : uint8
+{
+	/** UTF-8 JSON text */
+	Json,
+	/** MessagePack (msgpack.org). Smaller and cheaper to parse for number-heavy responses */
+	MessagePack
+};
+
+/** Compression applied to a response after it is encoded */
+enum class EMCPCompression : uint8
+{
+	None,
+	/** A zlib stream (RFC 1950) per response */
+	Zlib
+};
+
+/** Encoding and compression for a response, negotiated per connection and overridable per request */
+struct FMCPResponseFormat
+{
+	EMCPEncoding Encoding = EMCPEncoding::Json;
+	EMCPCompression Compression = EMCPCompression::None;
+
+	/** True if the response may not be plain JSON text, so it can't be sent newline framed */
+	bool IsBinary() const { return Encoding != EMCPEncoding::Json || Compression != EMCPCompression::None; }
+
+	/** Override the fields named by "encoding" and "compression" in Json. Returns false and sets OutError for unknown names */
+	bool ParseFrom(const FJsonObject& Json, FString& OutError);
+
+	TSharedPtr<FJsonObject> ToJson() const;
+
+	static const TCHAR* GetEncodingName(EMCPEncoding Encoding);
+	static const TCHAR* GetCompressionName(EMCPCompression Compression);
+};
+
+class FMCPResultWriter;
+
+/**
+ * Turns responses into the bytes that get framed and sent. Everything is written straight into a
+ * byte buffer by FMCPResultWriter, without building an FString first.
+ * The first byte of the output tells the formats apart: '{' for JSON, 0x80-0x8f, 0xde or 0xdf for
+ * a MessagePack map, and 0x78 for a zlib stream.
+ */
+class UNREALMCP_API FMCPResponseEncoder
+{
+public:
+	/** Responses shorter than this are never compressed, as it would cost more than it saves */
+	static constexpr int32 MinCompressBytes = 1024;
+
+	/** Encode and, if asked and worthwhile, compress Response. Returns the allocations it took, see FMCPResultWriter */
+	static int32 Encode(const FJsonObject& Response, const FMCPResponseFormat& Format, TArray<uint8>& OutBytes);
+
+	/**
+	 * Wrap a result a streaming handler already wrote, in Format's encoding, in a success response
+	 * tagged with RequestId if there is one, then compress it like Encode
+	 */
+	static int32 EncodeStreamed(const FMCPResultWriter& Result, const TSharedPtr<FJsonValue>& RequestId, const FMCPResponseFormat& Format, TArray<uint8>& OutBytes);
+
+	/** Compress Data into OutCompressed. Returns false if compression failed */
+	static bool Compress(EMCPCompression Compression, const TArray<uint8>& Data, TArray<uint8>& OutCompressed);
+
+private:
+	/** Move the writer's bytes to OutBytes, compressing them if Format asks and it helps */
+	static void Finish(FMCPResultWriter& Writer, const FMCPResponseFormat& Format, TArray<uint8>& OutBytes);
+};
@@ -0,0 +1,85 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+#include "MCPResponseEncoder.h"
+
+/**
+ * Writes JSON or MessagePack straight into a byte buffer, without building an FJsonObject tree.
+ * Streaming command handlers write their results with it, and FMCPResponseEncoder uses it for
+ * response objects. MessagePack stores container sizes up front, so BeginObject and BeginArray
+ * take the number of fields or elements that will follow, and callers must write exactly that many.
+ */
+class UNREALMCP_API FMCPResultWriter
+{
+public:
+	explicit FMCPResultWriter(EMCPEncoding InEncoding);
+
+	EMCPEncoding GetEncoding() const { return Encoding; }
+
+	void BeginObject(int32 NumFields);
+	void EndObject();
+	void BeginArray(int32 NumElements);
+	void EndArray();
+
+	/** Start a field of the current object. Follow it with exactly one value */
+	void WriteKey(FStringView Key);
+
+	void WriteString(FStringView Value);
+	void WriteNumber(double Value);
+	void WriteBool(bool bValue);
+	void WriteNull();
+
+	/** Three numbers as an array, the way locations, rotations and scales appear in results */
+	void WriteVector(double X, double Y, double Z);
+
+	/** Values from an FJsonObject tree */
+	void WriteValue(const TSharedPtr<FJsonValue>& Value);
+	void WriteObject(const FJsonObject& Object);
+
+	/** One value already encoded in this writer's encoding, such as another writer's output */
+	void WriteEncoded(const TArray<uint8>& Encoded);
+
+	/** Key and value in one call */
+	void WriteStringField(FStringView Key, FStringView Value) { WriteKey(Key); WriteString(Value); }
+	void WriteNumberField(FStringView Key, double Value) { WriteKey(Key); WriteNumber(Value); }
+	void WriteBoolField(FStringView Key, bool bValue) { WriteKey(Key); WriteBool(bValue); }
+	void WriteVectorField(FStringView Key, double X, double Y, double Z) { WriteKey(Key); WriteVector(X, Y, Z); }
+
+	const TArray<uint8>& GetBytes() const { return Bytes; }
+	TArray<uint8>& GetBytes() { return Bytes; }
+
+	/**
+	 * Heap allocations spent on this output: every node of the FJsonObject trees passed to
+	 * WriteValue or WriteObject, plus each time the byte buffer grew
+	 */
+	int32 GetNumAllocations() const { return NumAllocations; }
+
+	/** Drop everything written so far */
+	void Reset();
+
+private:
+	/** Comma handling in JSON. Called before every value and key */
+	void BeginValue();
+
+	void Append(const void* Data, int32 Count);
+	void AppendByte(uint8 Byte) { Append(&Byte, 1); }
+	void AppendBigEndian(uint64 Value, int32 NumBytes);
+
+	/** MessagePack type byte and length, using the smallest of the fix, 8, 16 and 32 bit forms the type has */
+	void AppendLengthHeader(uint32 Length, uint8 FixType, uint32 FixLimit, uint8 Type8, uint8 Type16, uint8 Type32);
+
+	void AppendMessagePackNumber(double Value);
+	void AppendJsonNumber(double Value);
+	void AppendString(FStringView Value);
+
+	EMCPEncoding Encoding;
+	TArray<uint8> Bytes;
+
+	// JSON only: whether each open container has an element yet, and whether a key is waiting for its value
+	TArray<bool, TInlineAllocator<16>> HasElements;
+	bool bAfterKey;
+
+	int32 NumAllocations;
+};
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MCPCommandRegistry.h"
+
+class FViewport;
+
+/** Image formats a screenshot can be encoded to */
+enum class EMCPScreenshotFormat : uint8
+{
+	Png,
+	Jpeg,
+	Bmp
+};
+
+/** How to encode a screenshot and where to deliver it */
+struct FMCPScreenshotRequest
+{
+	EMCPScreenshotFormat Format = EMCPScreenshotFormat::Png;
+
+	/** 1-100. Only JPEG uses it */
+	int32 Quality = 90;
+
+	/** File to write the encoded image to. Empty to skip writing a file */
+	FString FilePath;
+
+	/** Return the encoded image in the response as base64 */
+	bool bInline = false;
+};
+
+/**
+ * Viewport screenshots that keep the editor responsive.
+ * Only the pixel readback happens on the game thread, which owns the viewport. Compression,
+ * the file write and base64 encoding run on a background task, and the command completes from
+ * there. Pixel buffers are pooled, so repeated captures don't allocate a full frame each time.
+ */
+class UNREALMCP_API FMCPScreenshotCapture
+{
+public:
+	/** Parse a format name: png, jpg, jpeg or bmp. Returns false for anything else */
+	static bool ParseFormat(const FString& Name, EMCPScreenshotFormat& OutFormat);
+
+	/** File extension for a format, without the dot */
+	static const TCHAR* GetExtension(EMCPScreenshotFormat Format);
+
+	/** Read Viewport back now and encode it in the background. OnComplete gets the result or an error response */
+	static void Capture(FViewport* Viewport, const FMCPScreenshotRequest& Request, FMCPCommandCompletion&& OnComplete);
+};
@@ -2,18 +2,21 @@
 
 #include "CoreMinimal.h"
 #include "HAL/Runnable.h"
-#include "Sockets.h"
-#include "Interfaces/IPv4/IPv4Address.h"
+#include "MCPTransport.h"
+#include <atomic>
 
 class UUnrealMCPBridge;
+class FMCPClientSession;
 
 /**
  * Runnable class for the MCP server thread
+ * Waits for incoming connections and hands each one to its own FMCPClientSession,
+ * so several tools can stay connected at the same time.
  */
 class FMCPServerRunnable : public FRunnable
 {
 public:
-	FMCPServerRunnable(UUnrealMCPBridge* InBridge, TSharedPtr<FSocket> InListenerSocket);
+	FMCPServerRunnable(UUnrealMCPBridge* InBridge, TSharedPtr<IMCPListener> InListener, const FMCPTransportConfig& InConfig);
 	virtual ~FMCPServerRunnable();
 
 	// FRunnable interface
@@ -23,12 +26,15 @@ public:
 	virtual void Exit() override;
 
 protected:
-	void HandleClientConnection(TSharedPtr<FSocket> ClientSocket);
-	void ProcessMessage(TSharedPtr<FSocket> Client, const FString& Message);
+	void AcceptPendingConnections();
+	void ReapFinishedSessions();
+	void StopAllSessions();
 
 private:
 	UUnrealMCPBridge* Bridge;
-	TSharedPtr<FSocket> ListenerSocket;
-	TSharedPtr<FSocket> ClientSocket;
-	bool bRunning;
-}; 
\ No newline at end of file
+	TSharedPtr<IMCPListener> Listener;
+	FMCPTransportConfig Config;
+	TArray<TUniquePtr<FMCPClientSession>> Sessions;
+	int32 NextSessionId;
+	std::atomic<bool> bRunning;
+};
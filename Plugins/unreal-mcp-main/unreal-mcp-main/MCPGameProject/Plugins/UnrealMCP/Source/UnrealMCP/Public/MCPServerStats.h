@@ -0,0 +1,104 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"
+#include "HAL/CriticalSection.h"
+#include <atomic>
+
+/** The stages a request's time is split into */
+enum class EMCPRequestStage : uint8
+{
+	/** From arriving at the bridge to its handler starting */
+	QueueWait,
+	/** Running the handler, until an asynchronous one completes */
+	Execute,
+	/** Turning the response into JSON text */
+	Serialize,
+	/** Writing the framed response to the socket */
+	Send,
+
+	Num
+};
+
+/**
+ * Latency histogram with power-of-two microsecond buckets.
+ * Bucket i counts samples below 2^(i+1) us, the last one everything slower.
+ */
+struct FMCPLatencyHistogram
+{
+	static constexpr int32 NumBuckets = 24;
+
+	uint64 Buckets[NumBuckets] = {};
+	uint64 Count = 0;
+	double TotalMicroseconds = 0.0;
+	double MaxMicroseconds = 0.0;
+
+	void Add(double Microseconds);
+
+	/** Upper bound of the bucket holding the given fraction of samples, capped at the slowest sample */
+	double GetPercentileMicroseconds(double Fraction) const;
+
+	/** Count, mean, max, p50/p90/p99 and the non-empty buckets, all in milliseconds */
+	TSharedPtr<FJsonObject> ToJson() const;
+};
+
+/**
+ * Server-wide counters and per-command latency, for get_server_stats.
+ * Counters are atomics. Latency samples take a short lock per sample, keyed by command name,
+ * which is small next to the cost of any command. Safe to call from any thread.
+ */
+class UNREALMCP_API FMCPServerStats
+{
+public:
+	static FMCPServerStats& Get();
+
+	/** Record how long one stage of a command took */
+	void RecordStage(const FString& CommandType, EMCPRequestStage Stage, double Seconds);
+
+	/** Heap allocations it took to build and encode one of the command's responses, see FMCPResultWriter */
+	void RecordAllocations(const FString& CommandType, int32 Count);
+
+	/** A command started or finished running. Failures are counted against the command */
+	void BeginCommand() { ++NumInFlight; }
+	void EndCommand(const FString& CommandType, bool bSucceeded);
+
+	void AddBytesIn(int64 Count) { BytesIn += Count; }
+	void AddBytesOut(int64 Count) { BytesOut += Count; ++MessagesOut; }
+	void AddMessageIn() { ++MessagesIn; }
+
+	void SessionOpened() { ++NumSessions; ++TotalSessions; }
+	void SessionClosed() { --NumSessions; }
+
+	/** Snapshot of every counter and histogram */
+	TSharedPtr<FJsonObject> ToJson() const;
+
+	/** Clear the histograms and totals. Gauges such as in-flight commands are left alone */
+	void Reset();
+
+	static const TCHAR* GetStageName(EMCPRequestStage Stage);
+
+private:
+	FMCPServerStats();
+
+	struct FCommandStats
+	{
+		FMCPLatencyHistogram Stages[static_cast<int32>(EMCPRequestStage::Num)];
+		uint64 NumFailed = 0;
+
+		uint64 NumResponses = 0;
+		uint64 TotalAllocations = 0;
+		uint64 MaxAllocations = 0;
+	};
+
+	mutable FCriticalSection CommandsLock;
+	TMap<FString, FCommandStats> Commands;
+
+	std::atomic<int32> NumInFlight;
+	std::atomic<int32> NumSessions;
+	std::atomic<int64> TotalSessions;
+	std::atomic<int64> BytesIn;
+	std::atomic<int64> BytesOut;
+	std::atomic<int64> MessagesIn;
+	std::atomic<int64> MessagesOut;
+	std::atomic<double> StartTime;
+};
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Single-producer ring in POSIX shared memory that carries large responses to a local client.
+ *
+ * The segment starts with a 256 byte header, followed by the data area:
+ *   0   uint32 magic 'UMCP'   4   uint32 version (1)   8   uint64 capacity of the data area
+ *   64  uint64 write offset, advanced by the server after copying a payload in
+ *   128 uint64 read offset, advanced by the client once it has read a payload
+ * Offsets only grow; a payload starting at offset O lives at data + O % capacity and never
+ * wraps, since the writer skips to the start of the area when the end is too short.
+ * Instead of the payload, the socket carries {"shm": {"offset": O, "length": N}}.
+ *
+ * Linux only. Create fails elsewhere and callers keep using the socket.
+ */
+class UNREALMCP_API FMCPSharedMemoryRing
+{
+public:
+	~FMCPSharedMemoryRing();
+
+	/** Create and map a new segment called Name (e.g. "/unreal_mcp_1234_1") with Capacity data bytes */
+	static TUniquePtr<FMCPSharedMemoryRing> Create(const FString& Name, int64 Capacity, FString& OutError);
+
+	/**
+	 * Copy a payload into the ring. Returns false without writing anything if it doesn't fit
+	 * until the client reads more. Not thread safe; the caller serializes writes.
+	 */
+	bool Write(const uint8* Data, int64 Count, uint64& OutOffset);
+
+	/** Name the client passes to shm_open, or opens under /dev/shm */
+	const FString& GetName() const { return Name; }
+
+	int64 GetCapacity() const { return Capacity; }
+
+private:
+	FMCPSharedMemoryRing(const FString& InName, void* InMapping, int64 InMappingSize, int64 InCapacity);
+
+	FString Name;
+	void* Mapping;
+	int64 MappingSize;
+	int64 Capacity;
+};
@@ -0,0 +1,81 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UnrealMCPSettings.h"
+
+/** Outcome of a single read or write on a connection */
+enum class EMCPIoResult : uint8
+{
+	/** Some bytes moved */
+	Ok,
+	/** Nothing to read, or no room to write, right now */
+	WouldBlock,
+	/** The peer closed the connection */
+	Closed,
+	Error
+};
+
+/** Transport settings, copied from UUnrealMCPSettings when the server starts so the server threads never read the UObject */
+struct FMCPTransportConfig
+{
+	EMCPTransportType Transport = EMCPTransportType::Tcp;
+	FString Host;
+	int32 Port = 0;
+	FString SocketPath;
+
+	/** Size of each session's shared-memory ring in bytes. Zero when shared memory is off */
+	int64 SharedMemoryBytes = 0;
+
+	/** Responses this long or longer go through the ring when the client has opened one */
+	int32 SharedMemoryThreshold = 0;
+
+	static FMCPTransportConfig FromSettings(const UUnrealMCPSettings& Settings);
+};
+
+/**
+ * One client connection, whatever it runs over. Non-blocking: all waiting happens in the
+ * Wait calls, which have timeouts. A session reads from one thread while responses are
+ * written from others, so implementations must allow one reader and one writer at a time.
+ */
+class IMCPConnection
+{
+public:
+	virtual ~IMCPConnection() {}
+
+	/** Block until there is something to read, the peer hangs up or the timeout expires */
+	virtual bool WaitForRead(const FTimespan& Timeout) = 0;
+
+	/** Block until a write could make progress or the timeout expires */
+	virtual bool WaitForWrite(const FTimespan& Timeout) = 0;
+
+	virtual EMCPIoResult Recv(uint8* Data, int32 Count, int32& OutBytesRead) = 0;
+	virtual EMCPIoResult Send(const uint8* Data, int32 Count, int32& OutBytesSent) = 0;
+
+	/** True once the transport knows the connection is gone without needing a read */
+	virtual bool IsConnectionLost() const = 0;
+
+	/** Close the connection. Later reads and writes fail */
+	virtual void Close() = 0;
+
+	/** True if the peer is on this machine and may map shared memory we create */
+	virtual bool SupportsSharedMemory() const = 0;
+};
+
+/** Accepts client connections for the server thread */
+class IMCPListener
+{
+public:
+	virtual ~IMCPListener() {}
+
+	/** Block until a client is waiting to be accepted or the timeout expires */
+	virtual bool WaitForConnection(const FTimespan& Timeout) = 0;
+
+	/** Accept the next waiting client, or return null if there is none */
+	virtual TUniquePtr<IMCPConnection> Accept() = 0;
+
+	/** Where the listener is bound, for logging */
+	virtual FString Describe() const = 0;
+
+	/** Bind and listen on the transport Config asks for. Returns null and sets OutError on failure */
+	static TUniquePtr<IMCPListener> Create(const FMCPTransportConfig& Config, FString& OutError);
+};
@@ -13,6 +13,10 @@
 #include "Commands/UnrealMCPBlueprintNodeCommands.h"
 #include "Commands/UnrealMCPProjectCommands.h"
 #include "Commands/UnrealMCPUMGCommands.h"
+#include "MCPCommandRegistry.h"
+#include "MCPResultWriter.h"
+#include "MCPTransport.h"
+#include <atomic>
 #include "UnrealMCPBridge.generated.h"
 
 class FMCPServerRunnable;
@@ -20,8 +24,8 @@ class FMCPServerRunnable;
 /**
  * Editor subsystem for MCP Bridge
  * Handles communication between external tools and the Unreal Editor
- * through a TCP socket connection. Commands are received as JSON and
- * routed to appropriate command handlers.
+ * through a TCP or Unix domain socket connection, picked in UUnrealMCPSettings.
+ * Commands are received as JSON and routed to appropriate command handlers.
  */
 UCLASS()
 class UNREALMCP_API UUnrealMCPBridge : public UEditorSubsystem
@@ -41,19 +45,38 @@ public:
 	void StopServer();
 	bool IsRunning() const { return bIsRunning; }
 
-	// Command execution
+	// Command execution. ExecuteCommand blocks until the response is ready. ExecuteCommandAsync returns
+	// immediately and calls OnComplete on whichever thread ran the command.
 	FString ExecuteCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params);
+	void ExecuteCommandAsync(const FString& CommandType, const TSharedPtr<FJsonObject>& Params, TFunction<void(TSharedPtr<FJsonObject>)>&& OnComplete);
+
+	// As above, on behalf of client session ClientId, whose blueprint edit session the command joins.
+	// A streaming command writes its result straight into ResultWriter and OnComplete gets null instead
+	// of a response object. Errors and other commands still give a response object.
+	void ExecuteCommandAsync(const FString& CommandType, const TSharedPtr<FJsonObject>& Params, int32 ClientId, TSharedPtr<FMCPResultWriter, ESPMode::ThreadSafe> ResultWriter, TFunction<void(TSharedPtr<FJsonObject>)>&& OnComplete);
 
 private:
-	// Server state
-	bool bIsRunning;
-	TSharedPtr<FSocket> ListenerSocket;
-	TSharedPtr<FSocket> ConnectionSocket;
+	// Command registration
+	void RegisterCommands();
+
+	// Run a command on the current thread. RunCommand waits for asynchronous commands to finish;
+	// RunCommandAsync lets them complete on their own thread, and streams results into ResultWriter if given.
+	TSharedPtr<FJsonObject> RunCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params);
+	void RunCommandAsync(const FString& CommandType, const TSharedPtr<FJsonObject>& Params, FMCPResultWriter* ResultWriter, FMCPCommandCompletion&& OnComplete);
+
+	// Built-in commands
+	TSharedPtr<FJsonObject> HandlePing(const TSharedPtr<FJsonObject>& Params);
+	TSharedPtr<FJsonObject> HandleListCommands(const TSharedPtr<FJsonObject>& Params);
+	TSharedPtr<FJsonObject> HandleGetServerStats(const TSharedPtr<FJsonObject>& Params);
+	TSharedPtr<FJsonObject> HandleBatch(const TSharedPtr<FJsonObject>& Params);
+
+	// Server state. Read from the session threads while waiting on the game thread.
+	std::atomic<bool> bIsRunning;
+	TSharedPtr<IMCPListener> Listener;
 	FRunnableThread* ServerThread;
 
-	// Server configuration
-	FIPv4Address ServerAddress;
-	uint16 Port;
+	// Server configuration, read from the settings when the server starts
+	FMCPTransportConfig TransportConfig;
 
 	// Command handler instances
 	TSharedPtr<FUnrealMCPEditorCommands> EditorCommands;
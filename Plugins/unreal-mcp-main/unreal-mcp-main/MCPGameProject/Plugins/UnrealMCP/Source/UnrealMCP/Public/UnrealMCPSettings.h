@@ -0,0 +1,58 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DeveloperSettings.h"
+#include "UnrealMCPSettings.generated.h"
+
+/** How clients connect to the editor */
+UENUM()
+enum class EMCPTransportType : uint8
+{
+	/** TCP on Host:Port. Works everywhere */
+	Tcp UMETA(DisplayName = "TCP"),
+
+	/** Unix domain socket at SocketPath. Linux only; falls back to TCP elsewhere */
+	UnixSocket UMETA(DisplayName = "Unix Domain Socket")
+};
+
+/**
+ * Server settings, under Project Settings > Plugins > Unreal MCP.
+ * Read when the server starts, so changes apply the next time the editor starts.
+ */
+UCLASS(config = EditorPerProjectUserSettings, meta = (DisplayName = "Unreal MCP"))
+class UNREALMCP_API UUnrealMCPSettings : public UDeveloperSettings
+{
+	GENERATED_BODY()
+
+public:
+	UUnrealMCPSettings();
+
+	virtual FName GetCategoryName() const override { return TEXT("Plugins"); }
+
+	UPROPERTY(config, EditAnywhere, Category = "Transport")
+	EMCPTransportType Transport = EMCPTransportType::Tcp;
+
+	/** Address the TCP listener binds to */
+	UPROPERTY(config, EditAnywhere, Category = "Transport", meta = (EditCondition = "Transport == EMCPTransportType::Tcp"))
+	FString Host = TEXT("127.0.0.1");
+
+	UPROPERTY(config, EditAnywhere, Category = "Transport", meta = (EditCondition = "Transport == EMCPTransportType::Tcp", ClampMin = "1", ClampMax = "65535"))
+	int32 Port = 55557;
+
+	/** Path of the Unix domain socket. Must be shorter than 108 characters */
+	UPROPERTY(config, EditAnywhere, Category = "Transport", meta = (EditCondition = "Transport == EMCPTransportType::UnixSocket"))
+	FString SocketPath = TEXT("/tmp/unreal_mcp.sock");
+
+	/**
+	 * Let Unix socket clients ask for a shared-memory ring. Responses at least
+	 * SharedMemoryThresholdKB long are then written to the ring instead of the socket.
+	 */
+	UPROPERTY(config, EditAnywhere, Category = "Transport|Shared Memory", meta = (EditCondition = "Transport == EMCPTransportType::UnixSocket"))
+	bool bEnableSharedMemory = false;
+
+	UPROPERTY(config, EditAnywhere, Category = "Transport|Shared Memory", meta = (EditCondition = "bEnableSharedMemory", ClampMin = "1", ClampMax = "1024"))
+	int32 SharedMemorySizeMB = 16;
+
+	UPROPERTY(config, EditAnywhere, Category = "Transport|Shared Memory", meta = (EditCondition = "bEnableSharedMemory", ClampMin = "1"))
+	int32 SharedMemoryThresholdKB = 64;
+};
@@ -52,7 +52,9 @@ public class UnrealMCP : ModuleRules
 				"KismetCompiler",
 				"BlueprintGraph",
 				"Projects",
-				"AssetRegistry"
+				"AssetRegistry",
+				"ImageCore",
+				"ImageWrapper"
 			}
 		);
 		
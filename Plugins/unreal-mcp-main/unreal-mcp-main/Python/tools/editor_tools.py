@@ -15,8 +15,21 @@ def register_editor_tools(mcp: FastMCP):
     """Register editor tools with the MCP server."""
     
     @mcp.tool()
-    def get_actors_in_level(ctx: Context) -> List[Dict[str, Any]]:
-        """Get a list of all actors in the current level."""
+    def get_actors_in_level(
+        ctx: Context,
+        class_name: Optional[str] = None,
+        name: Optional[str] = None,
+        tag: Optional[str] = None,
+        fields: Optional[List[str]] = None
+    ) -> List[Dict[str, Any]]:
+        """Get a list of actors in the current level.
+        
+        Args:
+            class_name: Only actors of this class or a subclass
+            name: Wildcard pattern (* and ?) matched against actor names and labels
+            tag: Only actors with this tag
+            fields: Fields to return per actor (name, label, class, location, rotation, scale, tags, folder)
+        """
         from unreal_mcp_server import get_unreal_connection
         
         try:
@@ -24,8 +37,18 @@ def register_editor_tools(mcp: FastMCP):
             if not unreal:
                 logger.warning("Failed to connect to Unreal Engine")
                 return []
+            
+            params = {}
+            if class_name:
+                params["class"] = class_name
+            if name:
+                params["name"] = name
+            if tag:
+                params["tag"] = tag
+            if fields:
+                params["fields"] = fields
                 
-            response = unreal.send_command("get_actors_in_level", {})
+            response = unreal.send_command("get_actors_in_level", params)
             
             if not response:
                 logger.warning("No response from Unreal Engine")
@@ -52,8 +75,13 @@ def register_editor_tools(mcp: FastMCP):
             return []
 
     @mcp.tool()
-    def find_actors_by_name(ctx: Context, pattern: str) -> List[str]:
-        """Find actors by name pattern."""
+    def find_actors_by_name(ctx: Context, pattern: str, match: str = "contains") -> List[str]:
+        """Find actors whose name or label matches a pattern.
+        
+        Args:
+            pattern: Text to match, case-insensitive
+            match: "contains" (default), "prefix" or "exact"
+        """
         from unreal_mcp_server import get_unreal_connection
         
         try:
@@ -63,7 +91,8 @@ def register_editor_tools(mcp: FastMCP):
                 return []
                 
             response = unreal.send_command("find_actors_by_name", {
-                "pattern": pattern
+                "pattern": pattern,
+                "match": match
             })
             
             if not response:
@@ -5,9 +5,13 @@ A simple MCP server for interacting with Unreal Engine.
 """
 
 import logging
+import mmap
+import os
 import socket
+import struct
 import sys
 import json
+import zlib
 from contextlib import asynccontextmanager
 from typing import AsyncIterator, Dict, Any, Optional
 from mcp.server.fastmcp import FastMCP
@@ -27,6 +31,26 @@ logger = logging.getLogger("UnrealMCP")
 UNREAL_HOST = "127.0.0.1"
 UNREAL_PORT = 55557
 
+# Set to the editor's socket path when it uses the Unix domain socket transport (Linux)
+UNREAL_SOCKET_PATH = os.environ.get("UNREAL_MCP_SOCKET")
+
+# Set to 1 to receive large responses through shared memory; needs UNREAL_MCP_SOCKET
+UNREAL_SHARED_MEMORY = os.environ.get("UNREAL_MCP_SHARED_MEMORY") == "1"
+
+# Response encoding to ask for: "json" or "msgpack" (needs the msgpack package)
+UNREAL_ENCODING = os.environ.get("UNREAL_MCP_ENCODING", "json")
+
+# Set to "zlib" to have large responses compressed
+UNREAL_COMPRESSION = os.environ.get("UNREAL_MCP_COMPRESSION", "none")
+
+# Binary responses can't be newline framed, so any of the above switches to length-prefixed framing
+UNREAL_LENGTH_PREFIXED = UNREAL_ENCODING != "json" or UNREAL_COMPRESSION != "none"
+
+# Shared memory ring layout, see MCPSharedMemoryRing.h
+SHM_HEADER_SIZE = 256
+SHM_CAPACITY_OFFSET = 8
+SHM_READ_OFFSET = 128
+
 class UnrealConnection:
     """Connection to an Unreal Engine instance."""
     
@@ -34,6 +58,7 @@ class UnrealConnection:
         """Initialize the connection."""
         self.socket = None
         self.connected = False
+        self.shared_memory = None
     
     def connect(self) -> bool:
         """Connect to the Unreal Engine instance."""
@@ -46,21 +71,33 @@ class UnrealConnection:
                     pass
                 self.socket = None
             
-            logger.info(f"Connecting to Unreal at {UNREAL_HOST}:{UNREAL_PORT}...")
-            self.socket = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
-            self.socket.settimeout(5)  # 5 second timeout
-            
-            # Set socket options for better stability
-            self.socket.setsockopt(socket.IPPROTO_TCP, socket.TCP_NODELAY, 1)
-            self.socket.setsockopt(socket.SOL_SOCKET, socket.SO_KEEPALIVE, 1)
+            self._close_shared_memory()
             
-            # Set larger buffer sizes
-            self.socket.setsockopt(socket.SOL_SOCKET, socket.SO_RCVBUF, 65536)
-            self.socket.setsockopt(socket.SOL_SOCKET, socket.SO_SNDBUF, 65536)
+            if UNREAL_SOCKET_PATH:
+                logger.info(f"Connecting to Unreal at {UNREAL_SOCKET_PATH}...")
+                self.socket = socket.socket(socket.AF_UNIX, socket.SOCK_STREAM)
+                self.socket.settimeout(5)  # 5 second timeout
+                self.socket.connect(UNREAL_SOCKET_PATH)
+            else:
+                logger.info(f"Connecting to Unreal at {UNREAL_HOST}:{UNREAL_PORT}...")
+                self.socket = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
+                self.socket.settimeout(5)  # 5 second timeout
+                
+                # Set socket options for better stability
+                self.socket.setsockopt(socket.IPPROTO_TCP, socket.TCP_NODELAY, 1)
+                self.socket.setsockopt(socket.SOL_SOCKET, socket.SO_KEEPALIVE, 1)
+                
+                # Set larger buffer sizes
+                self.socket.setsockopt(socket.SOL_SOCKET, socket.SO_RCVBUF, 65536)
+                self.socket.setsockopt(socket.SOL_SOCKET, socket.SO_SNDBUF, 65536)
+                
+                self.socket.connect((UNREAL_HOST, UNREAL_PORT))
             
-            self.socket.connect((UNREAL_HOST, UNREAL_PORT))
             self.connected = True
             logger.info("Connected to Unreal Engine")
+            
+            if UNREAL_SOCKET_PATH and UNREAL_SHARED_MEMORY:
+                self._open_shared_memory()
             return True
             
         except Exception as e:
@@ -70,6 +107,7 @@ class UnrealConnection:
     
     def disconnect(self):
         """Disconnect from the Unreal Engine instance."""
+        self._close_shared_memory()
         if self.socket:
             try:
                 self.socket.close()
@@ -78,6 +116,99 @@ class UnrealConnection:
         self.socket = None
         self.connected = False
 
+    def is_alive(self) -> bool:
+        """Check that the socket is still open without writing to it, so the request stream stays intact."""
+        if not self.connected or not self.socket:
+            return False
+        try:
+            self.socket.setblocking(False)
+            try:
+                # An orderly close reads as zero bytes; no data pending raises BlockingIOError
+                return self.socket.recv(1, socket.MSG_PEEK) != b''
+            except BlockingIOError:
+                return True
+            finally:
+                self.socket.settimeout(5)
+        except Exception:
+            return False
+    
+    def _open_shared_memory(self):
+        """Ask the editor for a shared memory ring; large responses then arrive through it."""
+        try:
+            self._send_message({"type": "open_shared_memory"})
+            response = self._receive_message()
+            if response.get("status") != "success":
+                logger.warning(f"Shared memory unavailable: {response.get('error')}")
+                return
+            
+            name = response["result"]["name"]
+            fd = os.open("/dev/shm/" + name.lstrip("/"), os.O_RDWR)
+            try:
+                self.shared_memory = mmap.mmap(fd, 0)
+            finally:
+                os.close(fd)
+            logger.info(f"Opened shared memory {name}")
+        except Exception as e:
+            logger.warning(f"Failed to open shared memory: {e}")
+            self.shared_memory = None
+    
+    def _close_shared_memory(self):
+        """Unmap the shared memory ring, if one is open."""
+        if self.shared_memory:
+            try:
+                self.shared_memory.close()
+            except:
+                pass
+        self.shared_memory = None
+    
+    def _read_shared_memory(self, location: Dict[str, Any]) -> bytes:
+        """Copy a response out of the shared memory ring and release its space."""
+        offset = location["offset"]
+        length = location["length"]
+        capacity = struct.unpack_from("<Q", self.shared_memory, SHM_CAPACITY_OFFSET)[0]
+        start = SHM_HEADER_SIZE + offset % capacity
+        data = self.shared_memory[start:start + length]
+        struct.pack_into("<Q", self.shared_memory, SHM_READ_OFFSET, offset + length)
+        return data
+
+    def _send_message(self, message: Dict[str, Any]):
+        """Send a request using the framing this client is configured for."""
+        data = json.dumps(message).encode('utf-8')
+        if UNREAL_LENGTH_PREFIXED:
+            data = struct.pack(">I", len(data)) + data
+        self.socket.sendall(data)
+    
+    def _receive_exactly(self, count: int) -> bytes:
+        """Read exactly count bytes from the socket."""
+        chunks = []
+        while count > 0:
+            chunk = self.socket.recv(min(count, 65536))
+            if not chunk:
+                raise Exception("Connection closed before receiving data")
+            chunks.append(chunk)
+            count -= len(chunk)
+        return b''.join(chunks)
+    
+    def _receive_message(self) -> Dict[str, Any]:
+        """Receive and decode one response."""
+        if UNREAL_LENGTH_PREFIXED:
+            self.socket.settimeout(5)  # 5 second timeout
+            length = struct.unpack(">I", self._receive_exactly(4))[0]
+            data = self._receive_exactly(length)
+            logger.info(f"Received complete response ({len(data)} bytes)")
+        else:
+            data = self.receive_full_response(self.socket)
+        return self._decode_payload(data)
+    
+    def _decode_payload(self, data: bytes) -> Dict[str, Any]:
+        """Decode a response; the first byte tells zlib (0x78), JSON ('{') and MessagePack apart."""
+        if data[:1] == b'\x78':
+            data = zlib.decompress(data)
+        if data[:1] == b'{':
+            return json.loads(data.decode('utf-8'))
+        import msgpack
+        return msgpack.unpackb(data, raw=False)
+
     def receive_full_response(self, sock, buffer_size=4096) -> bytes:
         """Receive a complete response from Unreal, handling chunked data."""
         chunks = []
@@ -125,19 +256,12 @@ class UnrealConnection:
     
     def send_command(self, command: str, params: Dict[str, Any] = None) -> Optional[Dict[str, Any]]:
         """Send a command to Unreal Engine and get the response."""
-        # Always reconnect for each command, since Unreal closes the connection after each command
-        # This is different from Unity which keeps connections alive
-        if self.socket:
-            try:
-                self.socket.close()
-            except:
-                pass
-            self.socket = None
-            self.connected = False
-        
-        if not self.connect():
-            logger.error("Failed to connect to Unreal Engine for command")
-            return None
+        # Keep the connection, and with it any shared memory ring and edit session, across commands.
+        # Only reconnect if the editor closed it or an earlier command failed
+        if not self.is_alive():
+            if not self.connect():
+                logger.error("Failed to connect to Unreal Engine for command")
+                return None
         
         try:
             # Match Unity's command format exactly
@@ -146,14 +270,21 @@ class UnrealConnection:
                 "params": params or {}  # Use Unity's params or {} pattern
             }
             
+            # Ask for a compact response encoding if one is configured
+            if UNREAL_LENGTH_PREFIXED:
+                command_obj["encoding"] = UNREAL_ENCODING
+                command_obj["compression"] = UNREAL_COMPRESSION
+            
             # Send without newline, exactly like Unity
-            command_json = json.dumps(command_obj)
-            logger.info(f"Sending command: {command_json}")
-            self.socket.sendall(command_json.encode('utf-8'))
+            logger.info(f"Sending command: {json.dumps(command_obj)}")
+            self._send_message(command_obj)
             
             # Read response using improved handler
-            response_data = self.receive_full_response(self.socket)
-            response = json.loads(response_data.decode('utf-8'))
+            response = self._receive_message()
+            
+            # Large responses may have been written to shared memory instead
+            if "shm" in response and self.shared_memory:
+                response = self._decode_payload(self._read_shared_memory(response["shm"]))
             
             # Log complete response for debugging
             logger.info(f"Complete response from Unreal: {response}")
@@ -175,26 +306,12 @@ class UnrealConnection:
                     "error": error_message
                 }
             
-            # Always close the connection after command is complete
-            # since Unreal will close it on its side anyway
-            try:
-                self.socket.close()
-            except:
-                pass
-            self.socket = None
-            self.connected = False
-            
             return response
             
         except Exception as e:
             logger.error(f"Error sending command: {e}")
-            # Always reset connection state on any error
-            self.connected = False
-            try:
-                self.socket.close()
-            except:
-                pass
-            self.socket = None
+            # The stream may be out of step after an error, so start over on the next command
+            self.disconnect()
             return {
                 "status": "error",
                 "error": str(e)
@@ -213,13 +330,11 @@ def get_unreal_connection() -> Optional[UnrealConnection]:
                 logger.warning("Could not connect to Unreal Engine")
                 _unreal_connection = None
         else:
-            # Verify connection is still valid with a ping-like test
-            try:
-                # Simple test by sending an empty buffer to check if socket is still connected
-                _unreal_connection.socket.sendall(b'\x00')
-                logger.debug("Connection verified with ping test")
-            except Exception as e:
-                logger.warning(f"Existing connection failed: {e}")
+            # Verify the connection is still open; writing a probe byte would corrupt the request stream
+            if _unreal_connection.is_alive():
+                logger.debug("Connection verified")
+            else:
+                logger.warning("Existing connection was closed")
                 _unreal_connection.disconnect()
                 _unreal_connection = None
                 # Try to reconnect
@@ -0,0 +1,304 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "Project_TOKISpatialGrid.h"
+#include "GameFramework/Actor.h"
+#include "Engine/World.h"
+
+void UProject_TOKISpatialGrid::RegisterActor(AActor* Actor)
+{
+	if (!IsValid(Actor) || EntryIndices.Contains(Actor))
+	{
+		return;
+	}
+
+	// create the entry
+	FEntry& Entry = Entries.AddDefaulted_GetRef();
+	Entry.Actor = Actor;
+	Entry.Location = Actor->GetActorLocation();
+	Entry.Radius = Actor->GetSimpleCollisionRadius();
+	Entry.Cell = GetCell(Entry.Location);
+
+	const int32 Index = Entries.Num() - 1;
+	EntryIndices.Add(Actor, Index);
+
+	// file it under its cell
+	Cells.FindOrAdd(Entry.Cell).Add(Index);
+
+	MaxEntryRadius = FMath::Max(MaxEntryRadius, Entry.Radius);
+}
+
+void UProject_TOKISpatialGrid::UnregisterActor(AActor* Actor)
+{
+	if (const int32* Index = EntryIndices.Find(Actor))
+	{
+		RemoveEntry(*Index);
+	}
+}
+
+void UProject_TOKISpatialGrid::UpdateActor(AActor* Actor)
+{
+	if (const int32* Index = EntryIndices.Find(Actor))
+	{
+		RefreshEntry(*Index);
+	}
+}
+
+void UProject_TOKISpatialGrid::QueryRadius(const FVector& Center, float Radius, TSubclassOf<AActor> ActorClass, TArray<AActor*>& OutActors) const
+{
+	// widen the cell range so we catch actors whose radius pokes into the circle
+	const float SearchRadius = Radius + MaxEntryRadius;
+	const FIntPoint MinCell = GetCell(Center - FVector(SearchRadius, SearchRadius, 0.0f));
+	const FIntPoint MaxCell = GetCell(Center + FVector(SearchRadius, SearchRadius, 0.0f));
+
+	ForEachEntryInCells(MinCell, MaxCell, [&](const FEntry& Entry)
+	{
+		AActor* Actor = Entry.Actor.Get();
+
+		if (!Actor || (ActorClass && !Actor->IsA(ActorClass)))
+		{
+			return;
+		}
+
+		// test the distance including the actor's radius
+		if (FVector::DistSquared2D(Center, Entry.Location) <= FMath::Square(Radius + Entry.Radius))
+		{
+			OutActors.Add(Actor);
+		}
+	});
+}
+
+void UProject_TOKISpatialGrid::QueryBox(const FBox2D& Box, TSubclassOf<AActor> ActorClass, TArray<AActor*>& OutActors) const
+{
+	const FIntPoint MinCell = GetCell(FVector(Box.Min.X - MaxEntryRadius, Box.Min.Y - MaxEntryRadius, 0.0f));
+	const FIntPoint MaxCell = GetCell(FVector(Box.Max.X + MaxEntryRadius, Box.Max.Y + MaxEntryRadius, 0.0f));
+
+	ForEachEntryInCells(MinCell, MaxCell, [&](const FEntry& Entry)
+	{
+		AActor* Actor = Entry.Actor.Get();
+
+		if (!Actor || (ActorClass && !Actor->IsA(ActorClass)))
+		{
+			return;
+		}
+
+		// test the actor's circle against the box
+		const FVector2D Location(Entry.Location);
+
+		if (Box.ComputeSquaredDistanceToPoint(Location) <= FMath::Square(Entry.Radius))
+		{
+			OutActors.Add(Actor);
+		}
+	});
+}
+
+void UProject_TOKISpatialGrid::QueryNearest(const FVector& Center, int32 Count, float MaxDistance, TSubclassOf<AActor> ActorClass, TArray<AActor*>& OutActors) const
+{
+	if (Count <= 0 || Entries.Num() == 0)
+	{
+		return;
+	}
+
+	const FIntPoint CenterCell = GetCell(Center);
+
+	// candidates sorted by squared distance
+	TArray<TPair<float, AActor*>> Candidates;
+	int32 Visited = 0;
+
+	// gathers the matching entries of a single cell
+	auto VisitCell = [&](const FIntPoint& Cell)
+	{
+		const TArray<int32>* CellEntries = Cells.Find(Cell);
+
+		if (!CellEntries)
+		{
+			return;
+		}
+
+		for (int32 Index : *CellEntries)
+		{
+			++Visited;
+
+			const FEntry& Entry = Entries[Index];
+			AActor* Actor = Entry.Actor.Get();
+
+			if (!Actor || (ActorClass && !Actor->IsA(ActorClass)))
+			{
+				continue;
+			}
+
+			// accept the actor if its radius reaches into the search distance
+			const float DistanceSquared = FVector::DistSquared2D(Center, Entry.Location);
+
+			if (DistanceSquared <= FMath::Square(MaxDistance + Entry.Radius))
+			{
+				Candidates.Emplace(DistanceSquared, Actor);
+			}
+		}
+	};
+
+	// search outwards one ring of cells at a time
+	for (int32 Ring = 0; ; ++Ring)
+	{
+		// anything in this ring or further out is at least this far away
+		const float RingDistance = FMath::Max(0, Ring - 1) * CellSize;
+
+		if (RingDistance > MaxDistance + MaxEntryRadius)
+		{
+			break;
+		}
+
+		// can the remaining rings still beat the candidates we have?
+		if (Candidates.Num() >= Count && FMath::Square(RingDistance) > Candidates[Count - 1].Key)
+		{
+			break;
+		}
+
+		// have we already looked at every entry?
+		if (Visited >= Entries.Num())
+		{
+			break;
+		}
+
+		// visit only the cells on the edge of this ring: the top and bottom rows, then the sides between them
+		if (Ring == 0)
+		{
+			VisitCell(CenterCell);
+
+		} else {
+
+			for (int32 X = -Ring; X <= Ring; ++X)
+			{
+				VisitCell(CenterCell + FIntPoint(X, -Ring));
+				VisitCell(CenterCell + FIntPoint(X, Ring));
+			}
+
+			for (int32 Y = -Ring + 1; Y < Ring; ++Y)
+			{
+				VisitCell(CenterCell + FIntPoint(-Ring, Y));
+				VisitCell(CenterCell + FIntPoint(Ring, Y));
+			}
+		}
+
+		// keep the candidates sorted so we can check the Kth distance
+		Candidates.Sort([](const TPair<float, AActor*>& A, const TPair<float, AActor*>& B) { return A.Key < B.Key; });
+	}
+
+	// copy out the closest actors
+	const int32 NumResults = FMath::Min(Count, Candidates.Num());
+
+	for (int32 Index = 0; Index < NumResults; ++Index)
+	{
+		OutActors.Add(Candidates[Index].Value);
+	}
+}
+
+void UProject_TOKISpatialGrid::Tick(float DeltaTime)
+{
+	// walk backwards so removals don't skip entries
+	for (int32 Index = Entries.Num() - 1; Index >= 0; --Index)
+	{
+		// drop any actors that were destroyed without unregistering
+		if (!Entries[Index].Actor.IsValid())
+		{
+			RemoveEntry(Index);
+			continue;
+		}
+
+		RefreshEntry(Index);
+	}
+}
+
+TStatId UProject_TOKISpatialGrid::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UProject_TOKISpatialGrid, STATGROUP_Tickables);
+}
+
+bool UProject_TOKISpatialGrid::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+FIntPoint UProject_TOKISpatialGrid::GetCell(const FVector& Location) const
+{
+	return FIntPoint(FMath::FloorToInt(Location.X / CellSize), FMath::FloorToInt(Location.Y / CellSize));
+}
+
+void UProject_TOKISpatialGrid::RefreshEntry(int32 Index)
+{
+	FEntry& Entry = Entries[Index];
+
+	AActor* Actor = Entry.Actor.Get();
+
+	if (!Actor)
+	{
+		return;
+	}
+
+	Entry.Location = Actor->GetActorLocation();
+
+	// only touch the cell map if the actor crossed into a new cell
+	const FIntPoint NewCell = GetCell(Entry.Location);
+
+	if (NewCell != Entry.Cell)
+	{
+		if (TArray<int32>* OldCellEntries = Cells.Find(Entry.Cell))
+		{
+			OldCellEntries->RemoveSingleSwap(Index, EAllowShrinking::No);
+		}
+
+		Cells.FindOrAdd(NewCell).Add(Index);
+		Entry.Cell = NewCell;
+	}
+}
+
+void UProject_TOKISpatialGrid::RemoveEntry(int32 Index)
+{
+	// remove the entry from its cell
+	if (TArray<int32>* CellEntries = Cells.Find(Entries[Index].Cell))
+	{
+		CellEntries->RemoveSingleSwap(Index, EAllowShrinking::No);
+	}
+
+	EntryIndices.Remove(Entries[Index].Actor.GetEvenIfUnreachable());
+
+	// move the last entry into the freed slot
+	const int32 LastIndex = Entries.Num() - 1;
+
+	if (Index != LastIndex)
+	{
+		FEntry& Moved = Entries[LastIndex];
+
+		if (TArray<int32>* MovedCellEntries = Cells.Find(Moved.Cell))
+		{
+			const int32 CellSlot = MovedCellEntries->Find(LastIndex);
+
+			if (CellSlot != INDEX_NONE)
+			{
+				(*MovedCellEntries)[CellSlot] = Index;
+			}
+		}
+
+		EntryIndices.Add(Moved.Actor.GetEvenIfUnreachable(), Index);
+		Entries[Index] = MoveTemp(Moved);
+	}
+
+	Entries.Pop(EAllowShrinking::No);
+}
+
+void UProject_TOKISpatialGrid::ForEachEntryInCells(const FIntPoint& MinCell, const FIntPoint& MaxCell, TFunctionRef<void(const FEntry&)> Visitor) const
+{
+	for (int32 Y = MinCell.Y; Y <= MaxCell.Y; ++Y)
+	{
+		for (int32 X = MinCell.X; X <= MaxCell.X; ++X)
+		{
+			if (const TArray<int32>* CellEntries = Cells.Find(FIntPoint(X, Y)))
+			{
+				for (int32 Index : *CellEntries)
+				{
+					Visitor(Entries[Index]);
+				}
+			}
+		}
+	}
+}
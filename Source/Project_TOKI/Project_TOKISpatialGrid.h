@@ -0,0 +1,139 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Templates/SubclassOf.h"
+#include "Project_TOKISpatialGrid.generated.h"
+
+/**
+ *  Uniform 2D spatial hash of gameplay actors such as NPCs and units.
+ *  Actors register on BeginPlay and unregister on EndPlay.
+ *  Their cells are refreshed once per frame, so radius, box and nearest
+ *  queries don't need to go through the physics scene.
+ */
+UCLASS(config=Game)
+class UProject_TOKISpatialGrid : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+	/** Grid entry for a registered actor */
+	struct FEntry
+	{
+		/** Registered actor */
+		TWeakObjectPtr<AActor> Actor;
+
+		/** Actor location as of the last refresh */
+		FVector Location;
+
+		/** Actor collision radius, added to radius and box queries */
+		float Radius = 0.0f;
+
+		/** Cell the actor is currently filed under */
+		FIntPoint Cell;
+	};
+
+protected:
+
+	/** Size of each grid cell */
+	UPROPERTY(config)
+	float CellSize = 500.0f;
+
+	/** Registered actors */
+	TArray<FEntry> Entries;
+
+	/** Maps registered actors to their entry index */
+	TMap<TObjectKey<AActor>, int32> EntryIndices;
+
+	/** Maps cell coordinates to the entries inside them */
+	TMap<FIntPoint, TArray<int32>> Cells;
+
+	/** Largest collision radius of any registered actor. Queries are widened by this much */
+	float MaxEntryRadius = 0.0f;
+
+public:
+
+	/** Adds an actor to the grid */
+	void RegisterActor(AActor* Actor);
+
+	/** Removes an actor from the grid */
+	void UnregisterActor(AActor* Actor);
+
+	/** Updates the cell for a single actor immediately, instead of waiting for the next refresh */
+	void UpdateActor(AActor* Actor);
+
+	/** Finds all actors of the given class whose collision radius overlaps the circle */
+	void QueryRadius(const FVector& Center, float Radius, TSubclassOf<AActor> ActorClass, TArray<AActor*>& OutActors) const;
+
+	/** Finds all actors of the given class whose collision radius overlaps the box */
+	void QueryBox(const FBox2D& Box, TSubclassOf<AActor> ActorClass, TArray<AActor*>& OutActors) const;
+
+	/** Finds up to Count actors of the given class whose collision radius is within MaxDistance of the location. Results are sorted by distance */
+	void QueryNearest(const FVector& Center, int32 Count, float MaxDistance, TSubclassOf<AActor> ActorClass, TArray<AActor*>& OutActors) const;
+
+	/** Typed convenience wrapper for QueryRadius */
+	template<class T>
+	void QueryRadius(const FVector& Center, float Radius, TArray<T*>& OutActors) const
+	{
+		TArray<AActor*> Found;
+		QueryRadius(Center, Radius, T::StaticClass(), Found);
+		CastResults(Found, OutActors);
+	}
+
+	/** Typed convenience wrapper for QueryBox */
+	template<class T>
+	void QueryBox(const FBox2D& Box, TArray<T*>& OutActors) const
+	{
+		TArray<AActor*> Found;
+		QueryBox(Box, T::StaticClass(), Found);
+		CastResults(Found, OutActors);
+	}
+
+	/** Typed convenience wrapper for QueryNearest */
+	template<class T>
+	void QueryNearest(const FVector& Center, int32 Count, float MaxDistance, TArray<T*>& OutActors) const
+	{
+		TArray<AActor*> Found;
+		QueryNearest(Center, Count, MaxDistance, T::StaticClass(), Found);
+		CastResults(Found, OutActors);
+	}
+
+	/** Returns the number of registered actors */
+	int32 GetNumActors() const { return Entries.Num(); }
+
+	/** Refreshes the cells of every registered actor */
+	virtual void Tick(float DeltaTime) override;
+
+	/** Stat ID for the tickable object */
+	virtual TStatId GetStatId() const override;
+
+protected:
+
+	/** Only create the grid for game worlds */
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	/** Returns the cell containing the location */
+	FIntPoint GetCell(const FVector& Location) const;
+
+	/** Refreshes the location and cell of an entry */
+	void RefreshEntry(int32 Index);
+
+	/** Removes an entry by swapping in the last one */
+	void RemoveEntry(int32 Index);
+
+	/** Calls the visitor for every entry in the inclusive cell range */
+	void ForEachEntryInCells(const FIntPoint& MinCell, const FIntPoint& MaxCell, TFunctionRef<void(const FEntry&)> Visitor) const;
+
+	/** Downcasts query results */
+	template<class T>
+	static void CastResults(const TArray<AActor*>& Found, TArray<T*>& OutActors)
+	{
+		OutActors.Reserve(OutActors.Num() + Found.Num());
+
+		for (AActor* Current : Found)
+		{
+			OutActors.Add(static_cast<T*>(Current));
+		}
+	}
+};
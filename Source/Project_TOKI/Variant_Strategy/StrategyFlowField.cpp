@@ -0,0 +1,193 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "StrategyFlowField.h"
+
+namespace StrategyFlowField
+{
+	/** Neighbor offsets. The first four are orthogonal, the last four diagonal */
+	static const FIntPoint NeighborOffsets[8] = {
+		FIntPoint(1, 0), FIntPoint(-1, 0), FIntPoint(0, 1), FIntPoint(0, -1),
+		FIntPoint(1, 1), FIntPoint(-1, 1), FIntPoint(1, -1), FIntPoint(-1, -1)
+	};
+
+	/** Relative cost of moving to each neighbor */
+	static const float NeighborCosts[8] = {
+		1.0f, 1.0f, 1.0f, 1.0f,
+		UE_SQRT_2, UE_SQRT_2, UE_SQRT_2, UE_SQRT_2
+	};
+}
+
+void FStrategyFlowField::Init(const FBox2D& Bounds, float InCellSize)
+{
+	CellSize = FMath::Max(InCellSize, 1.0f);
+	Origin = Bounds.Min;
+
+	const FVector2D Size = Bounds.GetSize();
+	SizeX = FMath::Max(1, FMath::CeilToInt(Size.X / CellSize));
+	SizeY = FMath::Max(1, FMath::CeilToInt(Size.Y / CellSize));
+
+	Blocked.Init(0, SizeX * SizeY);
+	Costs.Reset();
+	Directions.Reset();
+}
+
+bool FStrategyFlowField::GetCell(const FVector& Location, int32& OutX, int32& OutY) const
+{
+	OutX = FMath::FloorToInt((Location.X - Origin.X) / CellSize);
+	OutY = FMath::FloorToInt((Location.Y - Origin.Y) / CellSize);
+
+	return OutX >= 0 && OutY >= 0 && OutX < SizeX && OutY < SizeY;
+}
+
+FVector2D FStrategyFlowField::GetCellCenter(int32 X, int32 Y) const
+{
+	return Origin + FVector2D((X + 0.5f) * CellSize, (Y + 0.5f) * CellSize);
+}
+
+void FStrategyFlowField::Build(const FVector& InGoal)
+{
+	Goal = InGoal;
+
+	const int32 NumCells = SizeX * SizeY;
+
+	Costs.Init(MAX_flt, NumCells);
+	Directions.Init(FVector2D::ZeroVector, NumCells);
+
+	int32 GoalX, GoalY;
+
+	if (!GetCell(Goal, GoalX, GoalY))
+	{
+		return;
+	}
+
+	// Dijkstra outwards from the goal cell. The goal is always treated as passable
+	typedef TPair<float, int32> FOpenCell;
+	TArray<FOpenCell> Open;
+
+	auto OpenPredicate = [](const FOpenCell& A, const FOpenCell& B) { return A.Key < B.Key; };
+
+	const int32 GoalIndex = GetIndex(GoalX, GoalY);
+	Costs[GoalIndex] = 0.0f;
+	Open.HeapPush(FOpenCell(0.0f, GoalIndex), OpenPredicate);
+
+	while (Open.Num() > 0)
+	{
+		FOpenCell Current;
+		Open.HeapPop(Current, OpenPredicate, EAllowShrinking::No);
+
+		// skip stale heap entries
+		if (Current.Key > Costs[Current.Value])
+		{
+			continue;
+		}
+
+		const int32 X = Current.Value % SizeX;
+		const int32 Y = Current.Value / SizeX;
+
+		for (int32 Neighbor = 0; Neighbor < 8; ++Neighbor)
+		{
+			const int32 NX = X + StrategyFlowField::NeighborOffsets[Neighbor].X;
+			const int32 NY = Y + StrategyFlowField::NeighborOffsets[Neighbor].Y;
+
+			if (NX < 0 || NY < 0 || NX >= SizeX || NY >= SizeY)
+			{
+				continue;
+			}
+
+			const int32 NeighborIndex = GetIndex(NX, NY);
+
+			if (Blocked[NeighborIndex])
+			{
+				continue;
+			}
+
+			// don't cut corners past blocked cells
+			if (Neighbor >= 4 && (Blocked[GetIndex(NX, Y)] || Blocked[GetIndex(X, NY)]))
+			{
+				continue;
+			}
+
+			const float NewCost = Current.Key + StrategyFlowField::NeighborCosts[Neighbor];
+
+			if (NewCost < Costs[NeighborIndex])
+			{
+				Costs[NeighborIndex] = NewCost;
+				Open.HeapPush(FOpenCell(NewCost, NeighborIndex), OpenPredicate);
+			}
+		}
+	}
+
+	// point every reachable cell at its cheapest neighbor
+	for (int32 Y = 0; Y < SizeY; ++Y)
+	{
+		for (int32 X = 0; X < SizeX; ++X)
+		{
+			const int32 Index = GetIndex(X, Y);
+
+			if (Index == GoalIndex || Costs[Index] == MAX_flt)
+			{
+				continue;
+			}
+
+			float BestCost = Costs[Index];
+			int32 BestNeighbor = INDEX_NONE;
+
+			for (int32 Neighbor = 0; Neighbor < 8; ++Neighbor)
+			{
+				const int32 NX = X + StrategyFlowField::NeighborOffsets[Neighbor].X;
+				const int32 NY = Y + StrategyFlowField::NeighborOffsets[Neighbor].Y;
+
+				if (NX < 0 || NY < 0 || NX >= SizeX || NY >= SizeY)
+				{
+					continue;
+				}
+
+				if (Neighbor >= 4 && (Blocked[GetIndex(NX, Y)] || Blocked[GetIndex(X, NY)]))
+				{
+					continue;
+				}
+
+				const float NeighborCost = Costs[GetIndex(NX, NY)];
+
+				if (NeighborCost < BestCost)
+				{
+					BestCost = NeighborCost;
+					BestNeighbor = Neighbor;
+				}
+			}
+
+			if (BestNeighbor != INDEX_NONE)
+			{
+				Directions[Index] = FVector2D(StrategyFlowField::NeighborOffsets[BestNeighbor]).GetSafeNormal();
+			}
+		}
+	}
+}
+
+bool FStrategyFlowField::Sample(const FVector& Location, FVector2D& OutDirection) const
+{
+	int32 X, Y;
+
+	if (Costs.Num() == 0 || !GetCell(Location, X, Y))
+	{
+		return false;
+	}
+
+	const int32 Index = GetIndex(X, Y);
+
+	if (Costs[Index] == MAX_flt)
+	{
+		return false;
+	}
+
+	// head straight for the goal once we're in its cell
+	if (Costs[Index] == 0.0f)
+	{
+		OutDirection = FVector2D(Goal - Location).GetSafeNormal();
+		return true;
+	}
+
+	OutDirection = Directions[Index];
+	return true;
+}
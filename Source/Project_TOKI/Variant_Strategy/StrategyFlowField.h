@@ -0,0 +1,56 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ *  Flow field for steering large unit groups toward a shared goal.
+ *  Holds a 2D grid of passable cells, an integration field of path costs to the goal
+ *  and a steering direction per cell. Building the field doesn't touch the world,
+ *  so it's safe to do on a worker thread.
+ */
+struct FStrategyFlowField
+{
+	/** World location of the minimum corner of the grid */
+	FVector2D Origin = FVector2D::ZeroVector;
+
+	/** Size of each grid cell */
+	float CellSize = 100.0f;
+
+	/** Number of cells along X */
+	int32 SizeX = 0;
+
+	/** Number of cells along Y */
+	int32 SizeY = 0;
+
+	/** Non-zero for cells units can't walk through */
+	TArray<uint8> Blocked;
+
+	/** Path cost from each cell to the goal. Unreachable cells hold MAX_flt */
+	TArray<float> Costs;
+
+	/** Normalized steering direction for each cell */
+	TArray<FVector2D> Directions;
+
+	/** World location of the goal */
+	FVector Goal = FVector::ZeroVector;
+
+	/** Sets up an empty grid over the given bounds, with every cell passable */
+	void Init(const FBox2D& Bounds, float InCellSize);
+
+	/** Returns true if the location maps to a cell inside the grid */
+	bool GetCell(const FVector& Location, int32& OutX, int32& OutY) const;
+
+	/** Returns the world location of a cell's center */
+	FVector2D GetCellCenter(int32 X, int32 Y) const;
+
+	/** Returns the flat index for a cell */
+	int32 GetIndex(int32 X, int32 Y) const { return Y * SizeX + X; }
+
+	/** Builds the integration and direction fields toward the goal. Safe to call off the game thread */
+	void Build(const FVector& InGoal);
+
+	/** Samples the steering direction at the location. Returns false if the location is outside the grid or can't reach the goal */
+	bool Sample(const FVector& Location, FVector2D& OutDirection) const;
+};
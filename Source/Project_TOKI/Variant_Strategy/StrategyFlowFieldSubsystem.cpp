@@ -0,0 +1,250 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "StrategyFlowFieldSubsystem.h"
+#include "NavigationSystem.h"
+#include "NavigationData.h"
+#include "Engine/World.h"
+#include "Async/Async.h"
+#include "HAL/PlatformTime.h"
+
+void UStrategyFlowFieldSubsystem::RequestFlowField(const FVector& Goal, const FNavAgentProperties& AgentProps, FOnStrategyFlowFieldReady OnReady)
+{
+	UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
+	const ANavigationData* NavData = NavSys ? NavSys->GetNavDataForProps(AgentProps) : nullptr;
+
+	if (!NavData)
+	{
+		OnReady.ExecuteIfBound(nullptr);
+		return;
+	}
+
+	// each navigation data gets its own grid, so agents of different sizes don't share passability
+	FPassability* Entry = Passability.Find(NavData);
+
+	if (!Entry)
+	{
+		FPassability NewEntry;
+		NewEntry.NavData = NavData;
+
+		if (!StartPassability(NewEntry))
+		{
+			OnReady.ExecuteIfBound(nullptr);
+			return;
+		}
+
+		Entry = &Passability.Add(NavData, MoveTemp(NewEntry));
+	}
+
+	// wait for the grid if it's still being sampled
+	if (Entry->IsReady())
+	{
+		BuildFlowField(*Entry->Template, Goal, MoveTemp(OnReady));
+
+	} else {
+
+		Entry->Pending.Add({ Goal, MoveTemp(OnReady) });
+	}
+}
+
+void UStrategyFlowFieldSubsystem::InvalidatePassability()
+{
+	TArray<TObjectKey<ANavigationData>> Keys;
+	Passability.GetKeys(Keys);
+
+	for (const TObjectKey<ANavigationData>& Key : Keys)
+	{
+		ResetPassability(Key);
+	}
+}
+
+void UStrategyFlowFieldSubsystem::Tick(float DeltaTime)
+{
+	const double EndTime = FPlatformTime::Seconds() + PassabilityBudgetMs * 0.001;
+
+	// callbacks for grids that can't be finished, run once we're done with the map
+	TArray<FPendingRequest> Failed;
+
+	for (auto It = Passability.CreateIterator(); It; ++It)
+	{
+		FPassability& Entry = It->Value;
+
+		if (Entry.IsReady())
+		{
+			continue;
+		}
+
+		if (!Entry.NavData.IsValid())
+		{
+			Failed.Append(MoveTemp(Entry.Pending));
+			It.RemoveCurrent();
+			continue;
+		}
+
+		SamplePassability(Entry, EndTime);
+
+		// hand the finished grid to everyone waiting on it
+		if (Entry.IsReady())
+		{
+			for (FPendingRequest& Request : Entry.Pending)
+			{
+				BuildFlowField(*Entry.Template, Request.Goal, MoveTemp(Request.OnReady));
+			}
+
+			Entry.Pending.Empty();
+		}
+	}
+
+	for (FPendingRequest& Request : Failed)
+	{
+		Request.OnReady.ExecuteIfBound(nullptr);
+	}
+}
+
+TStatId UStrategyFlowFieldSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UStrategyFlowFieldSubsystem, STATGROUP_Tickables);
+}
+
+bool UStrategyFlowFieldSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UStrategyFlowFieldSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	// cached grids go stale whenever the navmesh is rebuilt, e.g. around dynamic obstacles
+	if (UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(&InWorld))
+	{
+		NavSys->OnNavigationGenerationFinishedDelegate.AddUniqueDynamic(this, &UStrategyFlowFieldSubsystem::OnNavigationGenerationFinished);
+	}
+}
+
+void UStrategyFlowFieldSubsystem::Deinitialize()
+{
+	if (UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld()))
+	{
+		NavSys->OnNavigationGenerationFinishedDelegate.RemoveDynamic(this, &UStrategyFlowFieldSubsystem::OnNavigationGenerationFinished);
+	}
+
+	Passability.Empty();
+
+	Super::Deinitialize();
+}
+
+void UStrategyFlowFieldSubsystem::OnNavigationGenerationFinished(ANavigationData* NavData)
+{
+	ResetPassability(NavData);
+}
+
+void UStrategyFlowFieldSubsystem::ResetPassability(TObjectKey<ANavigationData> Key)
+{
+	FPassability* Entry = Passability.Find(Key);
+
+	if (!Entry)
+	{
+		return;
+	}
+
+	// requests still waiting carry over to a grid sampled from the rebuilt navmesh
+	if (Entry->Pending.Num() > 0 && StartPassability(*Entry))
+	{
+		return;
+	}
+
+	TArray<FPendingRequest> Failed = MoveTemp(Entry->Pending);
+	Passability.Remove(Key);
+
+	for (FPendingRequest& Request : Failed)
+	{
+		Request.OnReady.ExecuteIfBound(nullptr);
+	}
+}
+
+bool UStrategyFlowFieldSubsystem::StartPassability(FPassability& Entry)
+{
+	const ANavigationData* NavData = Entry.NavData.Get();
+
+	if (!NavData)
+	{
+		return false;
+	}
+
+	// cover the navmesh bounds, growing the cells if the area is too large
+	const FBox NavBounds = NavData->GetBounds();
+
+	if (!NavBounds.IsValid)
+	{
+		return false;
+	}
+
+	const FBox2D Bounds(FVector2D(NavBounds.Min), FVector2D(NavBounds.Max));
+	const float LargestSide = FMath::Max(Bounds.GetSize().X, Bounds.GetSize().Y);
+	const float GridCellSize = FMath::Max(CellSize, LargestSide / FMath::Max(MaxCellsPerSide, 1));
+
+	// start from a fresh grid, so flow fields already copied from the old one are left alone
+	Entry.Template = MakeShared<FStrategyFlowField>();
+	Entry.Template->Init(Bounds, GridCellSize);
+	Entry.NextRow = 0;
+
+	Entry.ProbeZ = (NavBounds.Min.Z + NavBounds.Max.Z) * 0.5f;
+	Entry.Extent = FVector(GridCellSize * 0.5f, GridCellSize * 0.5f, NavBounds.GetExtent().Z + 100.0f);
+
+	return true;
+}
+
+void UStrategyFlowFieldSubsystem::SamplePassability(FPassability& Entry, double EndTime)
+{
+	const ANavigationData* NavData = Entry.NavData.Get();
+	FStrategyFlowField& Template = *Entry.Template;
+
+	TArray<FNavigationProjectionWork> Workload;
+	Workload.Reserve(Template.SizeX);
+
+	// project one row of cell centers onto the navmesh per batch, always doing at least one
+	do
+	{
+		const int32 Y = Entry.NextRow++;
+
+		Workload.Reset();
+
+		for (int32 X = 0; X < Template.SizeX; ++X)
+		{
+			Workload.Emplace(FVector(Template.GetCellCenter(X, Y), Entry.ProbeZ));
+		}
+
+		NavData->BatchProjectPoints(Workload, Entry.Extent);
+
+		// cells without navmesh are blocked
+		for (int32 X = 0; X < Template.SizeX; ++X)
+		{
+			Template.Blocked[Template.GetIndex(X, Y)] = Workload[X].bResult ? 0 : 1;
+		}
+
+	} while (!Entry.IsReady() && FPlatformTime::Seconds() < EndTime);
+}
+
+void UStrategyFlowFieldSubsystem::BuildFlowField(const FStrategyFlowField& Template, const FVector& Goal, FOnStrategyFlowFieldReady OnReady)
+{
+	// copy the passability grid so the worker owns its own field
+	TSharedPtr<FStrategyFlowField> Field = MakeShared<FStrategyFlowField>(Template);
+
+	TWeakObjectPtr<UStrategyFlowFieldSubsystem> WeakThis(this);
+
+	// build the integration field on a worker thread, then hand it back on the game thread
+	AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [Field, Goal, OnReady, WeakThis]()
+	{
+		Field->Build(Goal);
+
+		AsyncTask(ENamedThreads::GameThread, [Field, OnReady, WeakThis]()
+		{
+			// skip the callback if the world went away while we were building
+			if (WeakThis.IsValid())
+			{
+				OnReady.ExecuteIfBound(Field);
+			}
+		});
+	});
+}
@@ -0,0 +1,121 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "StrategyFlowField.h"
+#include "StrategyFlowFieldSubsystem.generated.h"
+
+class ANavigationData;
+struct FNavAgentProperties;
+
+/** Called on the game thread when a flow field has been built. The field is null if it couldn't be built */
+DECLARE_DELEGATE_OneParam(FOnStrategyFlowFieldReady, TSharedPtr<const FStrategyFlowField>);
+
+/**
+ *  Builds flow fields for strategy game group moves.
+ *  Passability is sampled from the navmesh on the game thread a few rows per tick,
+ *  and cached per navigation data, so each agent type gets its own grid.
+ *  The cache is dropped whenever the navmesh finishes rebuilding.
+ *  Each request copies the grid and builds the integration field on a worker thread.
+ */
+UCLASS(config=Game)
+class UStrategyFlowFieldSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+	/** Flow field request waiting for its passability grid */
+	struct FPendingRequest
+	{
+		/** World location of the goal */
+		FVector Goal;
+
+		/** Called once the field is built */
+		FOnStrategyFlowFieldReady OnReady;
+	};
+
+	/** Passability grid for one navigation data, and how far sampling it has got */
+	struct FPassability
+	{
+		/** Navigation data the grid is sampled from */
+		TWeakObjectPtr<const ANavigationData> NavData;
+
+		/** Passability grid, with no integration field */
+		TSharedPtr<FStrategyFlowField> Template;
+
+		/** Next grid row to sample. The grid is ready once every row is sampled */
+		int32 NextRow = 0;
+
+		/** Height the cell centers are projected from */
+		float ProbeZ = 0.0f;
+
+		/** Projection extent around each cell center */
+		FVector Extent = FVector::ZeroVector;
+
+		/** Requests waiting for the grid to be ready */
+		TArray<FPendingRequest> Pending;
+
+		/** Returns true if every row has been sampled */
+		bool IsReady() const { return NextRow >= Template->SizeY; }
+	};
+
+protected:
+
+	/** Preferred size of each flow field cell */
+	UPROPERTY(config)
+	float CellSize = 100.0f;
+
+	/** Max number of cells along each side. The cell size grows to fit large play areas */
+	UPROPERTY(config)
+	int32 MaxCellsPerSide = 512;
+
+	/** Time to spend sampling passability each tick, in milliseconds. At least one row is sampled per tick */
+	UPROPERTY(config)
+	float PassabilityBudgetMs = 1.0f;
+
+	/** Passability grids, keyed by the navigation data they were sampled from */
+	TMap<TObjectKey<ANavigationData>, FPassability> Passability;
+
+public:
+
+	/** Builds a flow field toward the goal asynchronously. The delegate is called on the game thread */
+	void RequestFlowField(const FVector& Goal, const FNavAgentProperties& AgentProps, FOnStrategyFlowFieldReady OnReady);
+
+	/** Discards every cached passability grid */
+	void InvalidatePassability();
+
+	/** Samples passability rows for grids that are still being built */
+	virtual void Tick(float DeltaTime) override;
+
+	/** Stat ID for the tickable object */
+	virtual TStatId GetStatId() const override;
+
+protected:
+
+	/** Only create the subsystem for game worlds */
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	/** Subscribes to navmesh rebuilds */
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+	/** Unsubscribes from navmesh rebuilds */
+	virtual void Deinitialize() override;
+
+	/** Discards the grid sampled from a navigation data that finished rebuilding */
+	UFUNCTION()
+	void OnNavigationGenerationFinished(ANavigationData* NavData);
+
+	/** Starts the grid over so it's resampled, or drops it if nothing is waiting on it */
+	void ResetPassability(TObjectKey<ANavigationData> Key);
+
+	/** Sets up an unsampled passability grid over the navmesh bounds. Returns false if the navmesh has no bounds */
+	bool StartPassability(FPassability& Entry);
+
+	/** Projects the next rows of cell centers onto the navmesh until the time budget runs out */
+	void SamplePassability(FPassability& Entry, double EndTime);
+
+	/** Copies the passability grid and builds the integration field toward the goal on a worker thread */
+	void BuildFlowField(const FStrategyFlowField& Template, const FVector& Goal, FOnStrategyFlowFieldReady OnReady);
+};
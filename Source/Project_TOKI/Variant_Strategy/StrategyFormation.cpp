@@ -0,0 +1,305 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "StrategyFormation.h"
+#include "NavigationSystem.h"
+#include "NavigationData.h"
+#include "Engine/World.h"
+
+void FStrategyFormation::ComputeSlots(EStrategyFormation Formation, int32 Count, float Spacing, const FVector& Goal, const FVector& Facing, TArray<FVector>& OutSlots)
+{
+	OutSlots.Reset(Count);
+
+	if (Count <= 0)
+	{
+		return;
+	}
+
+	// lay out the slots in local space, with X pointing forward and Y to the right
+	TArray<FVector2D> LocalSlots;
+	LocalSlots.Reserve(Count);
+
+	switch (Formation)
+	{
+		// rows of roughly equal width behind the goal
+		case SF_Grid:
+		{
+			const int32 Columns = FMath::CeilToInt(FMath::Sqrt(static_cast<float>(Count)));
+
+			for (int32 Row = 0; LocalSlots.Num() < Count; ++Row)
+			{
+				// center a partial last row
+				const int32 RowCount = FMath::Min(Columns, Count - LocalSlots.Num());
+
+				for (int32 Column = 0; Column < RowCount; ++Column)
+				{
+					LocalSlots.Emplace(-Row * Spacing, (Column - (RowCount - 1) * 0.5f) * Spacing);
+				}
+			}
+
+			break;
+		}
+
+		// one unit at the tip, each row behind it one unit wider
+		case SF_Wedge:
+		{
+			for (int32 Row = 0; LocalSlots.Num() < Count; ++Row)
+			{
+				const int32 RowCount = FMath::Min(Row + 1, Count - LocalSlots.Num());
+
+				for (int32 Column = 0; Column < RowCount; ++Column)
+				{
+					LocalSlots.Emplace(-Row * Spacing, (Column - (RowCount - 1) * 0.5f) * Spacing);
+				}
+			}
+
+			break;
+		}
+
+		// one unit at the center, then concentric rings spaced evenly
+		case SF_Circle:
+		{
+			LocalSlots.Emplace(0.0f, 0.0f);
+
+			for (int32 Ring = 1; LocalSlots.Num() < Count; ++Ring)
+			{
+				// fit as many units as the ring's circumference allows
+				const int32 RingCapacity = FMath::Max(1, FMath::FloorToInt(UE_TWO_PI * Ring));
+				const int32 RingCount = FMath::Min(RingCapacity, Count - LocalSlots.Num());
+
+				for (int32 Index = 0; Index < RingCount; ++Index)
+				{
+					const float Angle = UE_TWO_PI * Index / RingCount;
+					LocalSlots.Emplace(FMath::Cos(Angle) * Ring * Spacing, FMath::Sin(Angle) * Ring * Spacing);
+				}
+			}
+
+			break;
+		}
+	}
+
+	// transform the slots into world space
+	const FVector Forward = Facing.GetSafeNormal2D(UE_SMALL_NUMBER, FVector::ForwardVector);
+	const FVector Right = FVector::CrossProduct(FVector::UpVector, Forward);
+
+	for (const FVector2D& CurrentSlot : LocalSlots)
+	{
+		OutSlots.Add(Goal + Forward * CurrentSlot.X + Right * CurrentSlot.Y);
+	}
+}
+
+void FStrategyFormation::AssignSlots(const TArray<FVector>& UnitLocations, const TArray<FVector>& Slots, TArray<int32>& OutAssignment)
+{
+	const int32 NumUnits = UnitLocations.Num();
+	const int32 NumSlots = Slots.Num();
+
+	OutAssignment.Init(INDEX_NONE, NumUnits);
+
+	if (NumUnits == 0 || NumSlots < NumUnits)
+	{
+		return;
+	}
+
+	// Hungarian algorithm with row and column potentials. O(Units^2 * Slots).
+	// Arrays are 1-based, with index 0 used as a sentinel column
+	TArray<double> RowPotential;
+	TArray<double> ColumnPotential;
+	TArray<int32> ColumnOwner;
+	TArray<int32> ColumnPrev;
+	TArray<double> MinSlack;
+	TArray<bool> ColumnUsed;
+
+	RowPotential.Init(0.0, NumUnits + 1);
+	ColumnPotential.Init(0.0, NumSlots + 1);
+	ColumnOwner.Init(0, NumSlots + 1);
+	ColumnPrev.Init(0, NumSlots + 1);
+
+	auto Cost = [&](int32 Row, int32 Column)
+	{
+		return static_cast<double>(FVector::Dist2D(UnitLocations[Row - 1], Slots[Column - 1]));
+	};
+
+	for (int32 Row = 1; Row <= NumUnits; ++Row)
+	{
+		// start an augmenting path from the sentinel column
+		ColumnOwner[0] = Row;
+		int32 CurrentColumn = 0;
+
+		MinSlack.Init(TNumericLimits<double>::Max(), NumSlots + 1);
+		ColumnUsed.Init(false, NumSlots + 1);
+
+		// grow the path until we reach a free column
+		do
+		{
+			ColumnUsed[CurrentColumn] = true;
+
+			const int32 CurrentRow = ColumnOwner[CurrentColumn];
+			double Delta = TNumericLimits<double>::Max();
+			int32 NextColumn = 0;
+
+			for (int32 Column = 1; Column <= NumSlots; ++Column)
+			{
+				if (ColumnUsed[Column])
+				{
+					continue;
+				}
+
+				const double Slack = Cost(CurrentRow, Column) - RowPotential[CurrentRow] - ColumnPotential[Column];
+
+				if (Slack < MinSlack[Column])
+				{
+					MinSlack[Column] = Slack;
+					ColumnPrev[Column] = CurrentColumn;
+				}
+
+				// ties go to the lowest column so the result is deterministic
+				if (MinSlack[Column] < Delta)
+				{
+					Delta = MinSlack[Column];
+					NextColumn = Column;
+				}
+			}
+
+			// update the potentials
+			for (int32 Column = 0; Column <= NumSlots; ++Column)
+			{
+				if (ColumnUsed[Column])
+				{
+					RowPotential[ColumnOwner[Column]] += Delta;
+					ColumnPotential[Column] -= Delta;
+
+				} else {
+
+					MinSlack[Column] -= Delta;
+				}
+			}
+
+			CurrentColumn = NextColumn;
+
+		} while (ColumnOwner[CurrentColumn] != 0);
+
+		// flip the augmenting path
+		do
+		{
+			const int32 PrevColumn = ColumnPrev[CurrentColumn];
+			ColumnOwner[CurrentColumn] = ColumnOwner[PrevColumn];
+			CurrentColumn = PrevColumn;
+
+		} while (CurrentColumn != 0);
+	}
+
+	// copy out the assignment
+	for (int32 Column = 1; Column <= NumSlots; ++Column)
+	{
+		if (ColumnOwner[Column] != 0)
+		{
+			OutAssignment[ColumnOwner[Column] - 1] = Column - 1;
+		}
+	}
+}
+
+void FStrategyFormation::AssignSlotsSorted(const TArray<FVector>& UnitLocations, const TArray<FVector>& Slots, const FVector& Facing, TArray<int32>& OutAssignment)
+{
+	const int32 NumUnits = UnitLocations.Num();
+	const int32 NumSlots = Slots.Num();
+
+	OutAssignment.Init(INDEX_NONE, NumUnits);
+
+	if (NumUnits == 0 || NumSlots < NumUnits)
+	{
+		return;
+	}
+
+	const FVector Forward = Facing.GetSafeNormal2D(UE_SMALL_NUMBER, FVector::ForwardVector);
+	const FVector Right = FVector::CrossProduct(FVector::UpVector, Forward);
+
+	// sorts indices front to back, breaking ties left to right so the result is deterministic
+	auto SortFrontToBack = [&Forward, &Right](const TArray<FVector>& Locations, TArray<int32>& OutOrder)
+	{
+		OutOrder.SetNumUninitialized(Locations.Num());
+
+		for (int32 Index = 0; Index < Locations.Num(); ++Index)
+		{
+			OutOrder[Index] = Index;
+		}
+
+		OutOrder.Sort([&Locations, &Forward, &Right](int32 A, int32 B)
+		{
+			const double ForwardA = FVector::DotProduct(Locations[A], Forward);
+			const double ForwardB = FVector::DotProduct(Locations[B], Forward);
+
+			if (ForwardA != ForwardB)
+			{
+				return ForwardA > ForwardB;
+			}
+
+			return FVector::DotProduct(Locations[A], Right) < FVector::DotProduct(Locations[B], Right);
+		});
+	};
+
+	TArray<int32> UnitOrder;
+	TArray<int32> SlotOrder;
+	SortFrontToBack(UnitLocations, UnitOrder);
+	SortFrontToBack(Slots, SlotOrder);
+
+	// only the front slots get used
+	SlotOrder.SetNum(NumUnits);
+
+	// pair the bands left to right. Roughly square bands match the grid formation's rows
+	const int32 BandSize = FMath::CeilToInt(FMath::Sqrt(static_cast<float>(NumUnits)));
+
+	auto SortLeftToRight = [&Right](const TArray<FVector>& Locations, TArrayView<int32> Band)
+	{
+		Band.Sort([&Locations, &Right](int32 A, int32 B)
+		{
+			return FVector::DotProduct(Locations[A], Right) < FVector::DotProduct(Locations[B], Right);
+		});
+	};
+
+	for (int32 BandStart = 0; BandStart < NumUnits; BandStart += BandSize)
+	{
+		const int32 BandCount = FMath::Min(BandSize, NumUnits - BandStart);
+
+		SortLeftToRight(UnitLocations, TArrayView<int32>(UnitOrder).Slice(BandStart, BandCount));
+		SortLeftToRight(Slots, TArrayView<int32>(SlotOrder).Slice(BandStart, BandCount));
+
+		for (int32 Index = BandStart; Index < BandStart + BandCount; ++Index)
+		{
+			OutAssignment[UnitOrder[Index]] = SlotOrder[Index];
+		}
+	}
+}
+
+void FStrategyFormation::ProjectSlotsToNavigation(UWorld* World, const FNavAgentProperties& AgentProps, const FVector& Fallback, TArray<FVector>& Slots)
+{
+	UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(World);
+
+	if (!NavSys)
+	{
+		return;
+	}
+
+	const ANavigationData* NavData = NavSys->GetNavDataForProps(AgentProps, Fallback);
+
+	if (!NavData)
+	{
+		return;
+	}
+
+	// project every slot in a single batch
+	TArray<FNavigationProjectionWork> Workload;
+	Workload.Reserve(Slots.Num());
+
+	for (const FVector& CurrentSlot : Slots)
+	{
+		Workload.Emplace(CurrentSlot);
+	}
+
+	NavData->BatchProjectPoints(Workload, NavData->GetDefaultQueryExtent());
+
+	// copy back the results
+	for (int32 Index = 0; Index < Slots.Num(); ++Index)
+	{
+		Slots[Index] = Workload[Index].bResult ? Workload[Index].OutLocation.Location : Fallback;
+	}
+}
@@ -0,0 +1,45 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "StrategyFormation.generated.h"
+
+class UWorld;
+struct FNavAgentProperties;
+
+/** Enum to determine the slot layout for group move orders */
+UENUM(BlueprintType)
+enum EStrategyFormation : uint8
+{
+	SF_Grid		UMETA(DisplayName = "Grid"),
+	SF_Wedge	UMETA(DisplayName = "Wedge"),
+	SF_Circle	UMETA(DisplayName = "Circle")
+};
+
+/**
+ *  Formation solver for strategy game group move orders.
+ *  Lays out one slot per unit around the move goal and assigns units to slots
+ *  so the total travel distance is minimal, which keeps their paths from crossing.
+ *  Large groups use a sort based assignment instead, which is close to minimal and much cheaper.
+ *  Slot layout and assignment don't touch the world and are fully deterministic.
+ */
+struct FStrategyFormation
+{
+	/** Builds Count slot locations around the goal, with the front of the formation at the goal facing the given direction */
+	static void ComputeSlots(EStrategyFormation Formation, int32 Count, float Spacing, const FVector& Goal, const FVector& Facing, TArray<FVector>& OutSlots);
+
+	/** Assigns each unit location to a slot, minimizing the total distance travelled. OutAssignment[UnitIndex] is the slot index */
+	static void AssignSlots(const TArray<FVector>& UnitLocations, const TArray<FVector>& Slots, TArray<int32>& OutAssignment);
+
+	/**
+	 *  Assigns each unit location to a slot by rank instead of solving exactly. O(N log N).
+	 *  Units and slots are sorted front to back along the facing direction, cut into matching bands,
+	 *  and paired left to right within each band, so paths mostly stay parallel.
+	 *  Spare slots at the back are left empty. OutAssignment[UnitIndex] is the slot index
+	 */
+	static void AssignSlotsSorted(const TArray<FVector>& UnitLocations, const TArray<FVector>& Slots, const FVector& Facing, TArray<int32>& OutAssignment);
+
+	/** Projects all slots onto the navmesh in one batch. Slots that can't be projected are moved to the fallback location */
+	static void ProjectSlotsToNavigation(UWorld* World, const FNavAgentProperties& AgentProps, const FVector& Fallback, TArray<FVector>& Slots);
+};
@@ -37,3 +37,43 @@ void AStrategyPawn::SetZoomModifier(float Value)
 	// set the ortho width on the camera
 	Camera->SetOrthoWidth(Value);
 }
+
+FBox2D AStrategyPawn::GetCameraGroundBounds(float PlaneHeight, float AspectRatio) const
+{
+	const FTransform CameraTransform = Camera->GetComponentTransform();
+	const FVector Forward = CameraTransform.GetUnitAxis(EAxis::X);
+
+	FBox2D Bounds(ForceInit);
+
+	// the ortho view is a box, so we only need to slide its four edges along the view direction
+	if (FMath::IsNearlyZero(Forward.Z))
+	{
+		return Bounds;
+	}
+
+	const float HalfWidth = Camera->OrthoWidth * 0.5f;
+	const float HalfHeight = HalfWidth / FMath::Max(AspectRatio, UE_KINDA_SMALL_NUMBER);
+
+	for (int32 Corner = 0; Corner < 4; ++Corner)
+	{
+		const FVector LocalCorner(0.0f, (Corner & 1) ? HalfWidth : -HalfWidth, (Corner & 2) ? HalfHeight : -HalfHeight);
+		const FVector RayOrigin = CameraTransform.TransformPositionNoScale(LocalCorner);
+
+		// intersect the corner ray with the ground plane
+		const float RayDistance = (PlaneHeight - RayOrigin.Z) / Forward.Z;
+		Bounds += FVector2D(RayOrigin + Forward * RayDistance);
+	}
+
+	return Bounds;
+}
+
+bool AStrategyPawn::IsInCameraView(const FVector& Location, float AspectRatio) const
+{
+	// convert to camera space. Y is right and Z is up on the view plane
+	const FVector LocalLocation = Camera->GetComponentTransform().InverseTransformPositionNoScale(Location);
+
+	const float HalfWidth = Camera->OrthoWidth * 0.5f;
+	const float HalfHeight = HalfWidth / FMath::Max(AspectRatio, UE_KINDA_SMALL_NUMBER);
+
+	return LocalLocation.X >= 0.0f && FMath::Abs(LocalLocation.Y) <= HalfWidth && FMath::Abs(LocalLocation.Z) <= HalfHeight;
+}
@@ -38,4 +38,10 @@ public:
 
 	/** Returns the camera component */
 	UCameraComponent* GetCamera() const { return Camera; }
+
+	/** Returns the 2D bounds of the area the ortho camera sees on a horizontal plane at the given height */
+	FBox2D GetCameraGroundBounds(float PlaneHeight, float AspectRatio) const;
+
+	/** Returns true if the location is inside the ortho camera's view volume. Doesn't depend on rendering */
+	bool IsInCameraView(const FVector& Location, float AspectRatio) const;
 };
@@ -16,6 +16,8 @@
 #include "StrategyUnit.h"
 #include "NavigationSystem.h"
 #include "Engine/OverlapResult.h"
+#include "Project_TOKISpatialGrid.h"
+#include "StrategyFlowFieldSubsystem.h"
 
 AStrategyPlayerController::AStrategyPlayerController()
 {
@@ -112,26 +114,53 @@ void AStrategyPlayerController::DragSelectUnits(const TArray<AStrategyUnit*>& Un
 	// do we have units in the list?
 	if (Units.Num() > 0)
 	{
-		// ensure any previous units are deselected
-		DoDeselectAllCommand();
+		// hash the boxed units so we can diff them against the current selection
+		TSet<AStrategyUnit*> BoxedUnits(Units);
+
+		// find the units that left the box
+		TArray<AStrategyUnit*> RemovedUnits;
+
+		for (AStrategyUnit* CurrentUnit : ControlledUnits)
+		{
+			if (!BoxedUnits.Contains(CurrentUnit))
+			{
+				RemovedUnits.Add(CurrentUnit);
+			}
+		}
+
+		// find the units that entered the box
+		TArray<AStrategyUnit*> AddedUnits;
 
-		// select each new unit
 		for (AStrategyUnit* CurrentUnit : Units)
 		{
-			// add the unit to the selection list
-			ControlledUnits.Add(CurrentUnit);
+			if (IsValid(CurrentUnit) && !ControlledUnits.Contains(CurrentUnit))
+			{
+				AddedUnits.Add(CurrentUnit);
+			}
+		}
+
+		// skip the update if nothing changed since the last frame
+		if (RemovedUnits.Num() == 0 && AddedUnits.Num() == 0)
+		{
+			return;
+		}
+
+		// update the selection in one go
+		ControlledUnits.Apply(AddedUnits, RemovedUnits);
+
+		// only notify the units whose selection state actually changed
+		for (AStrategyUnit* CurrentUnit : RemovedUnits)
+		{
+			CurrentUnit->UnitDeselected();
+		}
 
-			// select the unit
+		for (AStrategyUnit* CurrentUnit : AddedUnits)
+		{
 			CurrentUnit->UnitSelected();
 		}
 	}
 }
 
-const TArray<AStrategyUnit*>& AStrategyPlayerController::GetSelectedUnits()
-{
-	return ControlledUnits;
-}
-
 void AStrategyPlayerController::MoveCamera(const FInputActionValue& Value)
 {
 	FVector2D InputVector = Value.Get<FVector2D>();
@@ -345,24 +374,44 @@ void AStrategyPlayerController::TouchDoubleTap(const FInputActionValue& Value)
 void AStrategyPlayerController::DoSelectionCommand()
 {
 
-	// do a sphere sweep to look for actors to select
-	FHitResult OutHit;
+	// look for an actor to select
+	AActor* SelectedActor = nullptr;
 
-	const FVector Start = CachedSelection;
-	const FVector End = Start + FVector::UpVector * 350.0f;
+	if (UProject_TOKISpatialGrid* Grid = GetWorld()->GetSubsystem<UProject_TOKISpatialGrid>())
+	{
+		// ask the spatial grid for the closest unit
+		TArray<AStrategyUnit*> NearbyUnits;
+		Grid->QueryNearest(CachedSelection, 1, InteractionRadius, NearbyUnits);
 
-	FCollisionShape InteractionSphere;
-	InteractionSphere.SetSphere(InteractionRadius);
+		if (NearbyUnits.Num() > 0)
+		{
+			SelectedActor = NearbyUnits[0];
+		}
 
-	FCollisionObjectQueryParams ObjectParams;
-	ObjectParams.AddObjectTypesToQuery(ECC_Pawn);
+	} else {
+
+		// no grid, so do a sphere sweep instead
+		FHitResult OutHit;
+
+		const FVector Start = CachedSelection;
+		const FVector End = Start + FVector::UpVector * 350.0f;
+
+		FCollisionShape InteractionSphere;
+		InteractionSphere.SetSphere(InteractionRadius);
 
-	FCollisionQueryParams QueryParams;
-	QueryParams.AddIgnoredActor(this);
-	QueryParams.AddIgnoredActor(GetPawn());
-	QueryParams.bTraceComplex = true;
+		FCollisionObjectQueryParams ObjectParams;
+		ObjectParams.AddObjectTypesToQuery(ECC_Pawn);
 
-	GetWorld()->SweepSingleByObjectType(OutHit, Start, End, FQuat::Identity, ObjectParams, InteractionSphere, QueryParams);
+		FCollisionQueryParams QueryParams;
+		QueryParams.AddIgnoredActor(this);
+		QueryParams.AddIgnoredActor(GetPawn());
+		QueryParams.bTraceComplex = true;
+
+		if (GetWorld()->SweepSingleByObjectType(OutHit, Start, End, FQuat::Identity, ObjectParams, InteractionSphere, QueryParams))
+		{
+			SelectedActor = OutHit.GetActor();
+		}
+	}
 
 	// if we're using the mouse and are not holding the selection modifier key, deselect any units first
 	if (InputMode == SIM_Mouse && !bSelectionModifier)
@@ -372,11 +421,11 @@ void AStrategyPlayerController::DoSelectionCommand()
 	}
 
 	// did we hit a unit?
-	if (OutHit.bBlockingHit)
+	if (SelectedActor)
 	{
 
 		// update the target unit
-		TargetUnit = Cast<AStrategyUnit>(OutHit.GetActor());
+		TargetUnit = Cast<AStrategyUnit>(SelectedActor);
 
 		if (TargetUnit)
 		{
@@ -429,31 +478,84 @@ void AStrategyPlayerController::DoSelectionCommand()
 void AStrategyPlayerController::DoSelectAllOnScreenCommand()
 {
 
-	// find all NPCs currently on screen
-	TArray<AActor*> FoundActors;
-	UGameplayStatics::GetAllActorsOfClass(GetWorld(), AStrategyUnit::StaticClass(), FoundActors);
+	// gather the units that aren't selected yet
+	TArray<AStrategyUnit*> NewUnits;
 
-	// process each actor found
-	for (AActor* CurrentActor : FoundActors)
+	UProject_TOKISpatialGrid* Grid = GetWorld()->GetSubsystem<UProject_TOKISpatialGrid>();
+
+	if (Grid && ControlledPawn && StrategyHUD)
 	{
-		// cast back to our unit class
-		if (AStrategyUnit* CurrentUnit = Cast<AStrategyUnit>(CurrentActor))
+		// use the viewport aspect ratio if we have one, otherwise fall back to the camera's so this also works headless
+		int32 ViewportX, ViewportY;
+		GetViewportSize(ViewportX, ViewportY);
+
+		const float AspectRatio = (ViewportX > 0 && ViewportY > 0) ? static_cast<float>(ViewportX) / ViewportY : ControlledPawn->GetCamera()->AspectRatio;
+
+		// query the registered units under the camera's footprint, on the same ground plane the drag box uses
+		const FBox2D ViewBounds = ControlledPawn->GetCameraGroundBounds(StrategyHUD->GetSelectionPlaneHeight(), AspectRatio);
+
+		TArray<AStrategyUnit*> Candidates;
+
+		if (ViewBounds.bIsValid)
 		{
-			// has the actor been recently rendered?
-			if (CurrentActor->WasRecentlyRendered(0.2f))
+			Grid->QueryBox(ViewBounds.ExpandBy(StrategyHUD->GetSelectionQueryMargin()), Candidates);
+
+		} else {
+
+			// the camera looks along the ground, so its footprint is unbounded. Test every unit against the view instead
+			TArray<AActor*> FoundActors;
+			UGameplayStatics::GetAllActorsOfClass(GetWorld(), AStrategyUnit::StaticClass(), FoundActors);
+
+			Candidates.Reserve(FoundActors.Num());
+
+			for (AActor* CurrentActor : FoundActors)
 			{
+				Candidates.Add(CastChecked<AStrategyUnit>(CurrentActor));
+			}
+		}
+
+		// keep the units inside the ortho view volume
+		for (AStrategyUnit* CurrentUnit : Candidates)
+		{
+			if (!ControlledUnits.Contains(CurrentUnit) && ControlledPawn->IsInCameraView(CurrentUnit->GetActorLocation(), AspectRatio))
+			{
+				NewUnits.Add(CurrentUnit);
+			}
+		}
+
+	} else {
 
-				// is the actor not on our controlled units list?
-				if (!ControlledUnits.Contains(CurrentUnit))
+		// find all NPCs currently on screen
+		TArray<AActor*> FoundActors;
+		UGameplayStatics::GetAllActorsOfClass(GetWorld(), AStrategyUnit::StaticClass(), FoundActors);
+
+		// process each actor found
+		for (AActor* CurrentActor : FoundActors)
+		{
+			// cast back to our unit class
+			if (AStrategyUnit* CurrentUnit = Cast<AStrategyUnit>(CurrentActor))
+			{
+				// has the actor been recently rendered?
+				if (CurrentActor->WasRecentlyRendered(0.2f))
 				{
-					// add it to the controlled units list
-					ControlledUnits.Add(CurrentUnit);
 
-					// notify it of selection
-					CurrentUnit->UnitSelected();
+					// is the actor not on our controlled units list?
+					if (!ControlledUnits.Contains(CurrentUnit))
+					{
+						NewUnits.Add(CurrentUnit);
+					}
 				}
 			}
-		}		
+		}
+	}
+
+	// add them to the controlled units in one go
+	ControlledUnits.Apply(NewUnits, {});
+
+	// notify them of selection
+	for (AStrategyUnit* CurrentUnit : NewUnits)
+	{
+		CurrentUnit->UnitSelected();
 	}
 
 }
@@ -473,7 +575,7 @@ void AStrategyPlayerController::DoDeselectAllCommand()
 	}
 
 	// clear the controlled units list
-	ControlledUnits.Empty();
+	ControlledUnits.Reset();
 }
 
 void AStrategyPlayerController::DoDragScrollCommand()
@@ -531,43 +633,301 @@ void AStrategyPlayerController::DoMoveUnitsCommand()
 	// get the closest selected unit to the move goal. This will be our lead unit
 	AStrategyUnit* Closest = GetClosestSelectedUnitToLocation(CurrentMoveGoal);
 
-	// this will be set to true if any of the move requests fail
-	bool bInteractionFailed = false;
+	// start a new move batch. Any path results still in flight for the previous order will be ignored
+	++MoveBatchID;
+
+	MoveBatch = FStrategyMoveBatch();
+	MoveBatch.FeedbackLocation = CachedInteraction;
+
+	// the lead unit goes first
+	if (IsValid(Closest))
+	{
+		MoveBatch.Units.Add(Closest);
+	}
 
-	// process each unit in the controlled list
 	for (AStrategyUnit* CurrentUnit : ControlledUnits)
 	{
-		if (IsValid(CurrentUnit))
+		if (IsValid(CurrentUnit) && CurrentUnit != Closest)
+		{
+			MoveBatch.Units.Add(CurrentUnit);
+		}
+	}
+
+	// gather the unit locations and find the center of the group
+	TArray<FVector> UnitLocations;
+	UnitLocations.Reserve(MoveBatch.Units.Num());
+
+	FVector GroupCenter = FVector::ZeroVector;
+
+	for (const TWeakObjectPtr<AStrategyUnit>& CurrentUnit : MoveBatch.Units)
+	{
+		UnitLocations.Add(CurrentUnit->GetActorLocation());
+		GroupCenter += UnitLocations.Last();
+	}
+
+	if (UnitLocations.Num() > 0)
+	{
+		GroupCenter /= UnitLocations.Num();
+
+		// lay out the formation facing away from the group, project it onto the navmesh and give each unit a slot
+		TArray<FVector> Slots;
+		FStrategyFormation::ComputeSlots(Formation, UnitLocations.Num(), FormationSpacing, CurrentMoveGoal, CurrentMoveGoal - GroupCenter, Slots);
+		FStrategyFormation::ProjectSlotsToNavigation(GetWorld(), MoveBatch.Units[0]->GetNavAgentPropertiesRef(), CurrentMoveGoal, Slots);
+
+		// the exact solve is cubic, so large groups use the sorted assignment to keep the click frame flat
+		TArray<int32> Assignment;
+
+		if (UnitLocations.Num() <= MaxExactAssignmentUnits)
 		{
+			FStrategyFormation::AssignSlots(UnitLocations, Slots, Assignment);
+
+		} else {
+
+			FStrategyFormation::AssignSlotsSorted(UnitLocations, Slots, CurrentMoveGoal - GroupCenter, Assignment);
+		}
+
+		for (int32 UnitIndex = 0; UnitIndex < Assignment.Num(); ++UnitIndex)
+		{
+			MoveBatch.Goals.Add(Slots.IsValidIndex(Assignment[UnitIndex]) ? Slots[Assignment[UnitIndex]] : CurrentMoveGoal);
+		}
+	}
+
+	// large groups share a single flow field instead of planning individual paths
+	UStrategyFlowFieldSubsystem* FlowFields = GetWorld()->GetSubsystem<UStrategyFlowFieldSubsystem>();
 
-			// stop the unit
+	if (bUseFlowField && FlowFields && MoveBatch.Units.Num() >= FlowFieldMinUnits)
+	{
+		for (const TWeakObjectPtr<AStrategyUnit>& CurrentUnit : MoveBatch.Units)
+		{
 			CurrentUnit->StopMoving();
+		}
+
+		++MoveBatch.PendingQueries;
 
-			// move the lead unit to the goal, all other units to random navigable points around it
-			FVector MoveGoal = CurrentMoveGoal;
+		FlowFields->RequestFlowField(CurrentMoveGoal, MoveBatch.Units[0]->GetNavAgentPropertiesRef(), FOnStrategyFlowFieldReady::CreateUObject(this, &AStrategyPlayerController::OnBatchFlowFieldReady, MoveBatchID));
 
-			if (CurrentUnit != Closest)
+	} else {
+
+		// stop the followers and queue their path queries
+		for (int32 UnitIndex = 1; UnitIndex < MoveBatch.Units.Num(); ++UnitIndex)
+		{
+			AStrategyUnit* CurrentUnit = MoveBatch.Units[UnitIndex].Get();
+
+			CurrentUnit->StopMoving();
+
+			// followers close to the lead unit wait to reuse its path
+			if (CorridorShareRadius > 0.0f && FVector::Dist2D(CurrentUnit->GetActorLocation(), MoveBatch.Units[0]->GetActorLocation()) <= CorridorShareRadius)
 			{
+				MoveBatch.CorridorFollowers.Add(UnitIndex);
+
+			} else {
 
-				UNavigationSystemV1::K2_GetRandomLocationInNavigableRadius(GetWorld(), CurrentMoveGoal, MoveGoal, InteractionRadius * 0.66f);
+				RequestBatchPath(UnitIndex);
 			}
+		}
 
-			// subscribe to the unit's move completed delegate
-			CurrentUnit->OnMoveCompleted.AddDynamic(this, &AStrategyPlayerController::OnMoveCompleted);
+		// stop the lead unit and queue its path query last, so it can release the followers if it fails right away
+		if (MoveBatch.Units.Num() > 0)
+		{
+			MoveBatch.Units[0]->StopMoving();
+
+			RequestBatchPath(0);
+		}
+	}
 
-			// set up movement to the goal location
-			if (!CurrentUnit->MoveToLocation(MoveGoal, InteractionRadius * 0.66f))
+	// we may already be done if no queries were started
+	TryResolveMoveBatch();
+
+}
+
+void AStrategyPlayerController::RequestBatchPath(int32 UnitIndex)
+{
+	AStrategyUnit* CurrentUnit = MoveBatch.Units[UnitIndex].Get();
+
+	if (!IsValid(CurrentUnit))
+	{
+		return;
+	}
+
+	// queue the async path query, tagging it with the batch and unit it belongs to
+	const uint32 QueryID = CurrentUnit->RequestPathAsync(MoveBatch.Goals[UnitIndex], FNavPathQueryDelegate::CreateUObject(this, &AStrategyPlayerController::OnBatchPathFound, MoveBatchID, UnitIndex));
+
+	if (QueryID == INVALID_NAVQUERYID)
+	{
+		// the query couldn't be started, so flag it
+		MoveBatch.bFailed = true;
+
+		// release the followers if this was the lead unit
+		if (UnitIndex == 0)
+		{
+			ReleaseCorridorFollowers(nullptr);
+		}
+
+		return;
+	}
+
+	++MoveBatch.PendingQueries;
+}
+
+void AStrategyPlayerController::OnBatchPathFound(uint32 QueryID, ENavigationQueryResult::Type Result, FNavPathSharedPtr Path, uint32 BatchID, int32 UnitIndex)
+{
+	// ignore results from older move orders
+	if (BatchID != MoveBatchID)
+	{
+		return;
+	}
+
+	--MoveBatch.PendingQueries;
+
+	const bool bFoundPath = Result == ENavigationQueryResult::Success && Path.IsValid();
+
+	if (bFoundPath)
+	{
+		FollowBatchPath(UnitIndex, Path);
+
+	} else {
+
+		// the path query failed, so flag it
+		MoveBatch.bFailed = true;
+	}
+
+	// the lead unit's path is ready, so release the followers
+	if (UnitIndex == 0)
+	{
+		ReleaseCorridorFollowers(bFoundPath ? Path : nullptr);
+	}
+
+	TryResolveMoveBatch();
+}
+
+void AStrategyPlayerController::FollowBatchPath(int32 UnitIndex, FNavPathSharedPtr Path)
+{
+	AStrategyUnit* CurrentUnit = MoveBatch.Units[UnitIndex].Get();
+
+	if (!IsValid(CurrentUnit))
+	{
+		return;
+	}
+
+	// subscribe to the unit's move completed delegate
+	CurrentUnit->OnMoveCompleted.AddUniqueDynamic(this, &AStrategyPlayerController::OnMoveCompleted);
+
+	// set up movement along the path. Keep the acceptance radius tight enough that units settle into their own slots
+	const float AcceptanceRadius = FMath::Min(InteractionRadius * 0.66f, FormationSpacing * 0.5f);
+
+	if (!CurrentUnit->FollowPath(Path, AcceptanceRadius))
+	{
+		// the move request failed, so flag it
+		MoveBatch.bFailed = true;
+	}
+}
+
+void AStrategyPlayerController::ReleaseCorridorFollowers(FNavPathSharedPtr LeadPath)
+{
+	// copy the list out, since queries may be started while we iterate
+	const TArray<int32> Followers = MoveTemp(MoveBatch.CorridorFollowers);
+	MoveBatch.CorridorFollowers.Reset();
+
+	for (int32 UnitIndex : Followers)
+	{
+		AStrategyUnit* CurrentUnit = MoveBatch.Units[UnitIndex].Get();
+
+		if (!IsValid(CurrentUnit))
+		{
+			continue;
+		}
+
+		// did the lead unit get a path?
+		const ANavigationData* NavData = LeadPath.IsValid() ? LeadPath->GetNavigationDataUsed() : nullptr;
+
+		if (NavData && LeadPath->GetPathPoints().Num() >= 2)
+		{
+			// reuse the lead path, swapping in our own start and end points
+			TArray<FVector> CorridorPoints;
+			CorridorPoints.Reserve(LeadPath->GetPathPoints().Num());
+
+			for (const FNavPathPoint& CurrentPoint : LeadPath->GetPathPoints())
+			{
+				CorridorPoints.Add(CurrentPoint.Location);
+			}
+
+			CorridorPoints[0] = CurrentUnit->GetNavAgentLocation();
+			CorridorPoints.Last() = MoveBatch.Goals[UnitIndex];
+
+			// our own first and last legs may cross something the lead unit's didn't, so check them on the navmesh
+			const FSharedConstNavQueryFilter Filter = LeadPath->GetFilter().IsValid() ? LeadPath->GetFilter() : NavData->GetDefaultQueryFilter();
+			FVector HitLocation;
+
+			const bool bFirstBlocked = NavData->Raycast(CorridorPoints[0], CorridorPoints[1], HitLocation, Filter, CurrentUnit);
+			const bool bLastBlocked = !bFirstBlocked && CorridorPoints.Num() > 2 && NavData->Raycast(CorridorPoints.Last(1), CorridorPoints.Last(), HitLocation, Filter, CurrentUnit);
+
+			if (!bFirstBlocked && !bLastBlocked)
 			{
-				// the move request failed, so flag it
-				bInteractionFailed = true;
+				FNavPathSharedPtr CorridorPath = MakeShared<FNavigationPath, ESPMode::ThreadSafe>(CorridorPoints);
+				CorridorPath->SetNavigationDataUsed(LeadPath->GetNavigationDataUsed());
+				CorridorPath->SetFilter(Filter);
+
+				FollowBatchPath(UnitIndex, CorridorPath);
+				continue;
 			}
 		}
 
+		// no usable corridor, so fall back to a query of our own
+		RequestBatchPath(UnitIndex);
 	}
+}
 
-	// play the cursor feedback depending on whether our move succeeded or not
-	BP_CursorFeedback(CachedInteraction, !bInteractionFailed);
+void AStrategyPlayerController::OnBatchFlowFieldReady(TSharedPtr<const FStrategyFlowField> Field, uint32 BatchID)
+{
+	// ignore fields built for older move orders
+	if (BatchID != MoveBatchID)
+	{
+		return;
+	}
+
+	--MoveBatch.PendingQueries;
+
+	if (Field.IsValid())
+	{
+		const float AcceptanceRadius = FMath::Min(InteractionRadius * 0.66f, FormationSpacing * 0.5f);
+
+		// steer every unit along the shared field toward its own slot
+		for (int32 UnitIndex = 0; UnitIndex < MoveBatch.Units.Num(); ++UnitIndex)
+		{
+			AStrategyUnit* CurrentUnit = MoveBatch.Units[UnitIndex].Get();
+
+			if (!IsValid(CurrentUnit))
+			{
+				continue;
+			}
+
+			// subscribe to the unit's move completed delegate
+			CurrentUnit->OnMoveCompleted.AddUniqueDynamic(this, &AStrategyPlayerController::OnMoveCompleted);
+
+			CurrentUnit->FollowFlowField(Field, MoveBatch.Goals[UnitIndex], AcceptanceRadius);
+		}
+
+	} else {
 
+		// the field couldn't be built, so flag it
+		MoveBatch.bFailed = true;
+	}
+
+	TryResolveMoveBatch();
+}
+
+void AStrategyPlayerController::TryResolveMoveBatch()
+{
+	// are we still waiting on paths?
+	if (MoveBatch.bResolved || MoveBatch.PendingQueries > 0 || MoveBatch.CorridorFollowers.Num() > 0)
+	{
+		return;
+	}
+
+	MoveBatch.bResolved = true;
+
+	// play the cursor feedback depending on whether our move succeeded or not
+	BP_CursorFeedback(MoveBatch.FeedbackLocation, !MoveBatch.bFailed);
 }
 
 void AStrategyPlayerController::OnMoveCompleted(AStrategyUnit* MovedUnit)
@@ -591,31 +951,49 @@ void AStrategyPlayerController::OnMoveCompleted(AStrategyUnit* MovedUnit)
 		if(FVector::Dist2D(CachedInteraction, MovedUnit->GetActorLocation()) < InteractionRadius)
 		{
 
-			// do an overlap test to find nearby interactive objects
-			TArray<FOverlapResult> OutOverlaps;
+			if (UProject_TOKISpatialGrid* Grid = GetWorld()->GetSubsystem<UProject_TOKISpatialGrid>())
+			{
+				// query the spatial grid for nearby units
+				TArray<AStrategyUnit*> NearbyUnits;
+				Grid->QueryRadius(CachedInteraction, InteractionRadius, NearbyUnits);
 
-			FCollisionShape CollisionSphere;
-			CollisionSphere.SetSphere(InteractionRadius);
+				for (AStrategyUnit* CurrentUnit : NearbyUnits)
+				{
+					// skip the moved unit and the rest of the selection
+					if (CurrentUnit != MovedUnit && !ControlledUnits.Contains(CurrentUnit))
+					{
+						CurrentUnit->Interact(MovedUnit);
+					}
+				}
 
-			FCollisionObjectQueryParams ObjectParams;
-			ObjectParams.AddObjectTypesToQuery(ECC_WorldDynamic);
-			
-			FCollisionQueryParams QueryParams;
+			} else {
 
-			QueryParams.AddIgnoredActor(MovedUnit);
+				// no grid, so do an overlap test to find nearby interactive objects
+				TArray<FOverlapResult> OutOverlaps;
 
-			for(const AStrategyUnit* CurSelected : ControlledUnits)
-			{
-				QueryParams.AddIgnoredActor(CurSelected);
-			}
+				FCollisionShape CollisionSphere;
+				CollisionSphere.SetSphere(InteractionRadius);
 
-			if (GetWorld()->OverlapMultiByObjectType(OutOverlaps, CachedInteraction, FQuat::Identity, ObjectParams, CollisionSphere, QueryParams))
-			{
-				for (const FOverlapResult& CurrentOverlap : OutOverlaps)
+				FCollisionObjectQueryParams ObjectParams;
+				ObjectParams.AddObjectTypesToQuery(ECC_WorldDynamic);
+
+				FCollisionQueryParams QueryParams;
+
+				QueryParams.AddIgnoredActor(MovedUnit);
+
+				for(const AStrategyUnit* CurSelected : ControlledUnits)
+				{
+					QueryParams.AddIgnoredActor(CurSelected);
+				}
+
+				if (GetWorld()->OverlapMultiByObjectType(OutOverlaps, CachedInteraction, FQuat::Identity, ObjectParams, CollisionSphere, QueryParams))
 				{
-					if (AStrategyUnit* CurrentUnit = Cast<AStrategyUnit>(CurrentOverlap.GetActor()))
+					for (const FOverlapResult& CurrentOverlap : OutOverlaps)
 					{
-						CurrentUnit->Interact(MovedUnit);
+						if (AStrategyUnit* CurrentUnit = Cast<AStrategyUnit>(CurrentOverlap.GetActor()))
+						{
+							CurrentUnit->Interact(MovedUnit);
+						}
 					}
 				}
 			}
@@ -4,6 +4,10 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/PlayerController.h"
+#include "NavigationData.h"
+#include "StrategyFormation.h"
+#include "StrategyFlowField.h"
+#include "StrategySelectionSet.h"
 #include "StrategyPlayerController.generated.h"
 
 class AStrategyPawn;
@@ -13,6 +17,7 @@ struct FInputActionValue;
 class AStrategyHUD;
 class AStrategyNPC;
 class UInputAction;
+class AStrategyUnit;
 
 /** Enum to determine the last used input type */
 UENUM(BlueprintType)
@@ -22,6 +27,33 @@ enum EStrategyInputMode : uint8
 	SIM_Touch	UMETA(DisplayName = "Touch")
 };
 
+/**
+ *  Group move order waiting on async path queries
+ */
+struct FStrategyMoveBatch
+{
+	/** Units in the order. The lead unit is always first */
+	TArray<TWeakObjectPtr<AStrategyUnit>> Units;
+
+	/** Move goal for each unit */
+	TArray<FVector> Goals;
+
+	/** Units waiting to reuse the lead unit's path as a corridor */
+	TArray<int32> CorridorFollowers;
+
+	/** Number of path queries still in flight */
+	int32 PendingQueries = 0;
+
+	/** Location to play the cursor feedback at once the batch resolves */
+	FVector FeedbackLocation = FVector::ZeroVector;
+
+	/** Set if any unit failed to get a path */
+	bool bFailed = false;
+
+	/** Set once the cursor feedback has been played */
+	bool bResolved = false;
+};
+
 /**
  *  Player Controller for a top-down strategy game.
  *  Handles unit selection and commands.
@@ -113,6 +145,30 @@ protected:
 	UPROPERTY(EditAnywhere, Category="Input", meta = (ClampMin = 0, ClampMax = 10000, Units = "cm"))
 	float InteractionRadius = 250.0f;
 
+	/** Slot layout used for group move orders */
+	UPROPERTY(EditAnywhere, Category="Formation")
+	TEnumAsByte<EStrategyFormation> Formation = SF_Grid;
+
+	/** Distance between formation slots */
+	UPROPERTY(EditAnywhere, Category="Formation", meta = (ClampMin = 0, ClampMax = 1000, Units = "cm"))
+	float FormationSpacing = 150.0f;
+
+	/** Largest group that gets an exact slot assignment. Its cost grows with the cube of the group size, so larger groups are assigned by sorting */
+	UPROPERTY(EditAnywhere, Category="Formation", meta = (ClampMin = 0, ClampMax = 500))
+	int32 MaxExactAssignmentUnits = 64;
+
+	/** If true, large group moves steer along a shared flow field instead of planning a path per unit */
+	UPROPERTY(EditAnywhere, Category="Flow Field")
+	bool bUseFlowField = false;
+
+	/** Minimum group size to use the flow field for */
+	UPROPERTY(EditAnywhere, Category="Flow Field", meta = (ClampMin = 1, ClampMax = 1000))
+	int32 FlowFieldMinUnits = 50;
+
+	/** Followers starting this close to the lead unit reuse its path instead of running their own query. Set to zero to disable */
+	UPROPERTY(EditAnywhere, Category="Input", meta = (ClampMin = 0, ClampMax = 10000, Units = "cm"))
+	float CorridorShareRadius = 300.0f;
+
 	/** Max distance between the starting and current position of the second touch finger to be considered a box selection */
 	UPROPERTY(EditAnywhere, Category="Input", meta = (ClampMin = 0, ClampMax = 10000))
 	float MinSecondFingerDistanceForBoxSelect = 10.0f;
@@ -167,8 +223,14 @@ protected:
 	/** Currently selected unit */
 	AStrategyUnit* TargetUnit = nullptr;
 
-	/** Currently selected unit list */
-	TArray<AStrategyUnit*> ControlledUnits;
+	/** Currently selected units */
+	FStrategySelectionSet ControlledUnits;
+
+	/** Group move order currently resolving */
+	FStrategyMoveBatch MoveBatch;
+
+	/** Incremented on every move order so late path results from older orders can be ignored */
+	uint32 MoveBatchID = 0;
 
 public:
 
@@ -186,8 +248,11 @@ public:
 	/** Updates selected units from the HUD's drag select box */
 	void DragSelectUnits(const TArray<AStrategyUnit*>& Units);
 
-	/** Passes the list of selected units */
-	const TArray<AStrategyUnit*>& GetSelectedUnits();
+	/** Passes the set of selected units */
+	const FStrategySelectionSet& GetSelectedUnits() const { return ControlledUnits; }
+
+	/** Returns the delegate called whenever the selected units change */
+	FOnStrategySelectionChangedDelegate& OnSelectionChanged() { return ControlledUnits.OnSelectionChanged(); }
 
 protected:
 
@@ -263,6 +328,24 @@ protected:
 	/** Move all selected units */
 	void DoMoveUnitsCommand();
 
+	/** Starts the async path query for a unit in the current move batch */
+	void RequestBatchPath(int32 UnitIndex);
+
+	/** Called when an async path query for the current move batch completes */
+	void OnBatchPathFound(uint32 QueryID, ENavigationQueryResult::Type Result, FNavPathSharedPtr Path, uint32 BatchID, int32 UnitIndex);
+
+	/** Sends a unit in the current move batch along a path */
+	void FollowBatchPath(int32 UnitIndex, FNavPathSharedPtr Path);
+
+	/** Moves the corridor followers along the lead unit's path, or queries their own paths if the lead failed or their own first or last leg is blocked */
+	void ReleaseCorridorFollowers(FNavPathSharedPtr LeadPath);
+
+	/** Called when the flow field for the current move batch has been built */
+	void OnBatchFlowFieldReady(TSharedPtr<const FStrategyFlowField> Field, uint32 BatchID);
+
+	/** Plays the cursor feedback once every unit in the move batch has a path */
+	void TryResolveMoveBatch();
+
 	/** Called when a unit move is completed */
 	UFUNCTION()
 	void OnMoveCompleted(AStrategyUnit* MovedUnit);
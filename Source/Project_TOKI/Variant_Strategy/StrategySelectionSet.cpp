@@ -0,0 +1,161 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "StrategySelectionSet.h"
+#include "StrategyUnit.h"
+
+FStrategySelectionSet::~FStrategySelectionSet()
+{
+	for (const TWeakObjectPtr<AStrategyUnit>& CurrentUnit : Units)
+	{
+		if (AStrategyUnit* Unit = CurrentUnit.Get())
+		{
+			Unit->OnUnitEndPlay.RemoveAll(this);
+		}
+	}
+}
+
+bool FStrategySelectionSet::Contains(const AStrategyUnit* Unit) const
+{
+	return Unit && Indices.Contains(const_cast<AStrategyUnit*>(Unit));
+}
+
+bool FStrategySelectionSet::Add(AStrategyUnit* Unit)
+{
+	if (!AddInternal(Unit))
+	{
+		return false;
+	}
+
+	NotifyChanged();
+	return true;
+}
+
+bool FStrategySelectionSet::Remove(AStrategyUnit* Unit)
+{
+	if (!RemoveInternal(Unit))
+	{
+		return false;
+	}
+
+	CompactIfNeeded();
+	NotifyChanged();
+	return true;
+}
+
+void FStrategySelectionSet::Apply(TConstArrayView<AStrategyUnit*> Added, TConstArrayView<AStrategyUnit*> Removed)
+{
+	bool bChanged = false;
+
+	for (AStrategyUnit* CurrentUnit : Removed)
+	{
+		bChanged |= RemoveInternal(CurrentUnit);
+	}
+
+	for (AStrategyUnit* CurrentUnit : Added)
+	{
+		bChanged |= AddInternal(CurrentUnit);
+	}
+
+	// only notify once for the whole batch
+	if (bChanged)
+	{
+		CompactIfNeeded();
+		NotifyChanged();
+	}
+}
+
+void FStrategySelectionSet::Reset()
+{
+	if (Indices.Num() == 0 && Units.Num() == 0)
+	{
+		return;
+	}
+
+	for (const TWeakObjectPtr<AStrategyUnit>& CurrentUnit : Units)
+	{
+		if (AStrategyUnit* Unit = CurrentUnit.Get())
+		{
+			Unit->OnUnitEndPlay.RemoveAll(this);
+		}
+	}
+
+	Units.Reset();
+	Indices.Reset();
+	NumHoles = 0;
+
+	NotifyChanged();
+}
+
+bool FStrategySelectionSet::AddInternal(AStrategyUnit* Unit)
+{
+	if (!IsValid(Unit) || Indices.Contains(Unit))
+	{
+		return false;
+	}
+
+	Indices.Add(Unit, Units.Add(Unit));
+
+	// drop the unit as soon as it's destroyed, so Num doesn't count it
+	Unit->OnUnitEndPlay.AddRaw(this, &FStrategySelectionSet::OnUnitEndPlay);
+
+	return true;
+}
+
+bool FStrategySelectionSet::RemoveInternal(AStrategyUnit* Unit)
+{
+	int32 Index;
+
+	if (!Unit || !Indices.RemoveAndCopyValue(Unit, Index))
+	{
+		return false;
+	}
+
+	Unit->OnUnitEndPlay.RemoveAll(this);
+
+	// leave a hole so the rest of the list keeps its order and indices
+	Units[Index].Reset();
+	++NumHoles;
+
+	return true;
+}
+
+void FStrategySelectionSet::OnUnitEndPlay(AStrategyUnit* Unit)
+{
+	Remove(Unit);
+}
+
+void FStrategySelectionSet::CompactIfNeeded()
+{
+	if (NumHoles == 0 || NumHoles * 2 < Units.Num())
+	{
+		return;
+	}
+
+	// squeeze out the holes, keeping selection order, and rebuild the index map
+	int32 WriteIndex = 0;
+
+	for (int32 ReadIndex = 0; ReadIndex < Units.Num(); ++ReadIndex)
+	{
+		if (Units[ReadIndex].IsValid())
+		{
+			Units[WriteIndex] = Units[ReadIndex];
+			Indices.Add(Units[WriteIndex], WriteIndex);
+			++WriteIndex;
+
+		} else {
+
+			// destroyed units leave their slot behind too. Drop them from the index map
+			Indices.Remove(Units[ReadIndex]);
+		}
+	}
+
+	Units.SetNum(WriteIndex, EAllowShrinking::No);
+	NumHoles = 0;
+}
+
+void FStrategySelectionSet::NotifyChanged()
+{
+	++Revision;
+	OnChanged.Broadcast(*this);
+}
@@ -0,0 +1,126 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class AStrategyUnit;
+class FStrategySelectionSet;
+
+/** Delegate to report that the selection set has changed */
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnStrategySelectionChangedDelegate, const FStrategySelectionSet&);
+
+/**
+ *  Set of selected strategy units.
+ *  Membership is hashed, units are held by weak reference and iteration follows selection order.
+ *  Removed units leave a hole that's compacted lazily, so removing doesn't shift the whole list.
+ *  Units that leave play are removed as they go, so the count only covers live units.
+ */
+class FStrategySelectionSet
+{
+	/** Selected units in selection order. Removed entries are left null until the next compaction */
+	TArray<TWeakObjectPtr<AStrategyUnit>> Units;
+
+	/** Maps each selected unit to its slot in the list. Weak keys keep hashing the same after a unit is destroyed */
+	TMap<TWeakObjectPtr<AStrategyUnit>, int32> Indices;
+
+	/** Number of null slots waiting to be compacted */
+	int32 NumHoles = 0;
+
+	/** Incremented every time the selection changes */
+	uint32 Revision = 0;
+
+	/** Change notification */
+	FOnStrategySelectionChangedDelegate OnChanged;
+
+public:
+
+	FStrategySelectionSet() = default;
+
+	/** Units hold a pointer back to the set, so it can't be copied */
+	FStrategySelectionSet(const FStrategySelectionSet&) = delete;
+	FStrategySelectionSet& operator=(const FStrategySelectionSet&) = delete;
+
+	/** Unsubscribes from the units still selected */
+	~FStrategySelectionSet();
+
+	/** Iterates the selected units in selection order, skipping removed or destroyed ones */
+	class FIterator
+	{
+		const TArray<TWeakObjectPtr<AStrategyUnit>>& Units;
+		int32 Index;
+
+		void SkipInvalid()
+		{
+			while (Index < Units.Num() && !Units[Index].IsValid())
+			{
+				++Index;
+			}
+		}
+
+	public:
+
+		FIterator(const TArray<TWeakObjectPtr<AStrategyUnit>>& InUnits, int32 InIndex)
+			: Units(InUnits)
+			, Index(InIndex)
+		{
+			SkipInvalid();
+		}
+
+		AStrategyUnit* operator*() const { return Units[Index].Get(); }
+
+		FIterator& operator++()
+		{
+			++Index;
+			SkipInvalid();
+			return *this;
+		}
+
+		bool operator!=(const FIterator& Other) const { return Index != Other.Index; }
+	};
+
+	/** Returns true if the unit is selected */
+	bool Contains(const AStrategyUnit* Unit) const;
+
+	/** Adds a unit. Returns true if it wasn't already selected */
+	bool Add(AStrategyUnit* Unit);
+
+	/** Removes a unit. Returns true if it was selected */
+	bool Remove(AStrategyUnit* Unit);
+
+	/** Adds and removes several units, broadcasting a single change notification */
+	void Apply(TConstArrayView<AStrategyUnit*> Added, TConstArrayView<AStrategyUnit*> Removed);
+
+	/** Removes all units */
+	void Reset();
+
+	/** Returns the number of selected units still in play */
+	int32 Num() const { return Indices.Num(); }
+
+	/** Returns a counter that changes every time the selection does */
+	uint32 GetRevision() const { return Revision; }
+
+	/** Returns the change notification delegate */
+	FOnStrategySelectionChangedDelegate& OnSelectionChanged() { return OnChanged; }
+
+	/** Ranged-for support */
+	FIterator begin() const { return FIterator(Units, 0); }
+	FIterator end() const { return FIterator(Units, Units.Num()); }
+
+protected:
+
+	/** Adds a unit without broadcasting */
+	bool AddInternal(AStrategyUnit* Unit);
+
+	/** Removes a unit without broadcasting */
+	bool RemoveInternal(AStrategyUnit* Unit);
+
+	/** Removes a unit that's leaving play */
+	void OnUnitEndPlay(AStrategyUnit* Unit);
+
+	/** Squeezes out removed entries once they make up half the list */
+	void CompactIfNeeded();
+
+	/** Bumps the revision and broadcasts the change */
+	void NotifyChanged();
+};
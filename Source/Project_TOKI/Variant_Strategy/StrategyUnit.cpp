@@ -7,6 +7,11 @@
 #include "Kismet/KismetMathLibrary.h"
 #include "Components/SphereComponent.h"
 #include "Navigation/PathFollowingComponent.h"
+#include "NavigationSystem.h"
+#include "NavFilters/NavigationQueryFilter.h"
+#include "Engine/World.h"
+#include "Project_TOKISpatialGrid.h"
+#include "StrategyFlowField.h"
 
 AStrategyUnit::AStrategyUnit()
 {
@@ -39,6 +44,43 @@ AStrategyUnit::AStrategyUnit()
 	GetCharacterMovement()->SetFixedBrakingDistance(true);
 }
 
+void AStrategyUnit::BeginPlay()
+{
+	Super::BeginPlay();
+
+	// add ourselves to the spatial grid so selection and interaction queries can find us
+	if (UProject_TOKISpatialGrid* Grid = GetWorld()->GetSubsystem<UProject_TOKISpatialGrid>())
+	{
+		Grid->RegisterActor(this);
+	}
+}
+
+void AStrategyUnit::EndPlay(EEndPlayReason::Type EndPlayReason)
+{
+	// let selections drop us before we go
+	OnUnitEndPlay.Broadcast(this);
+	OnUnitEndPlay.Clear();
+
+	Super::EndPlay(EndPlayReason);
+
+	// remove ourselves from the spatial grid
+	if (UProject_TOKISpatialGrid* Grid = GetWorld()->GetSubsystem<UProject_TOKISpatialGrid>())
+	{
+		Grid->UnregisterActor(this);
+	}
+}
+
+void AStrategyUnit::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	// steer along the flow field if we're following one
+	if (FlowField.IsValid())
+	{
+		UpdateFlowFieldMovement(DeltaTime);
+	}
+}
+
 void AStrategyUnit::NotifyControllerChanged()
 {
 	// validate and save a copy of the AI controller reference
@@ -57,6 +99,9 @@ void AStrategyUnit::NotifyControllerChanged()
 
 void AStrategyUnit::StopMoving()
 {
+	// drop any flow field we were steering along
+	FlowField.Reset();
+
 	// use the character movement component to stop movement
 	GetCharacterMovement()->StopMovementImmediately();
 }
@@ -95,6 +140,9 @@ bool AStrategyUnit::MoveToLocation(const FVector& Location, float AcceptanceRadi
 	// ensure we have a valid AI Controller
 	if (AIController)
 	{
+		// path following takes over from any flow field
+		FlowField.Reset();
+
 		// set up the AI Move Request
 		FAIMoveRequest MoveReq;
 
@@ -139,8 +187,148 @@ bool AStrategyUnit::MoveToLocation(const FVector& Location, float AcceptanceRadi
 	return false;
 }
 
+uint32 AStrategyUnit::RequestPathAsync(const FVector& Goal, const FNavPathQueryDelegate& OnPathFound)
+{
+	// ensure we have a valid AI Controller and navigation system
+	UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
+
+	if (!AIController || !NavSys)
+	{
+		return 0;
+	}
+
+	// find the nav data for our agent
+	const FNavAgentProperties& AgentProps = GetNavAgentPropertiesRef();
+	const ANavigationData* NavData = NavSys->GetNavDataForProps(AgentProps, GetNavAgentLocation());
+
+	if (!NavData)
+	{
+		return 0;
+	}
+
+	// project the goal onto the navmesh, same as a regular move request
+	FNavLocation ProjectedGoal;
+
+	if (!NavSys->ProjectPointToNavigation(Goal, ProjectedGoal, INVALID_NAVEXTENT, NavData))
+	{
+		return 0;
+	}
+
+	// set up the path query using the controller's navigation filter
+	FSharedConstNavQueryFilter Filter = UNavigationQueryFilter::GetQueryFilter(*NavData, this, AIController->GetDefaultNavigationFilterClass());
+
+	FPathFindingQuery Query(this, *NavData, GetNavAgentLocation(), ProjectedGoal.Location, Filter);
+	Query.SetAllowPartialPaths(true);
+
+	// queue the query. The delegate will be called on the game thread once it's done
+	return NavSys->FindPathAsync(AgentProps, Query, OnPathFound);
+}
+
+bool AStrategyUnit::FollowPath(FNavPathSharedPtr Path, float AcceptanceRadius)
+{
+	// ensure we have a valid AI Controller and path
+	if (!AIController || !Path.IsValid() || !Path->IsValid())
+	{
+		return false;
+	}
+
+	// path following takes over from any flow field
+	FlowField.Reset();
+
+	// set up the AI Move Request
+	FAIMoveRequest MoveReq;
+
+	MoveReq.SetGoalLocation(Path->GetEndLocation());
+	MoveReq.SetAcceptanceRadius(AcceptanceRadius);
+	MoveReq.SetAllowPartialPath(true);
+	MoveReq.SetUsePathfinding(true);
+	MoveReq.SetNavigationFilter(AIController->GetDefaultNavigationFilterClass());
+	MoveReq.SetCanStrafe(false);
+
+	// hand the path to the AI Controller
+	return AIController->RequestMove(MoveReq, Path).IsValid();
+}
+
 void AStrategyUnit::OnMoveFinished(FAIRequestID RequestID, const FPathFollowingResult& Result)
 {
 	// call the delegate
 	OnMoveCompleted.Broadcast(this);
 }
+
+bool AStrategyUnit::FollowFlowField(TSharedPtr<const FStrategyFlowField> Field, const FVector& Goal, float AcceptanceRadius)
+{
+	if (!Field.IsValid())
+	{
+		return false;
+	}
+
+	// stop any path following move so it doesn't fight the flow field
+	if (AIController)
+	{
+		AIController->StopMovement();
+	}
+
+	FlowField = Field;
+	FlowFieldGoal = Goal;
+	FlowFieldAcceptanceRadius = AcceptanceRadius;
+	FlowFieldStuckTime = 0.0f;
+
+	// check if we're already there
+	if (FVector::Dist2D(GetActorLocation(), Goal) <= AcceptanceRadius)
+	{
+		FinishFlowFieldMove();
+	}
+
+	return true;
+}
+
+void AStrategyUnit::UpdateFlowFieldMovement(float DeltaTime)
+{
+	const FVector Location = GetActorLocation();
+
+	// have we arrived?
+	const float DistanceToGoal = FVector::Dist2D(Location, FlowFieldGoal);
+
+	if (DistanceToGoal <= FlowFieldAcceptanceRadius)
+	{
+		FinishFlowFieldMove();
+		return;
+	}
+
+	// give up if we've been stuck for too long, e.g. crowded out of our slot
+	if (GetVelocity().SizeSquared2D() < FMath::Square(10.0f))
+	{
+		FlowFieldStuckTime += DeltaTime;
+
+		if (FlowFieldStuckTime >= FlowFieldStuckTimeout)
+		{
+			FinishFlowFieldMove();
+			return;
+		}
+
+	} else {
+
+		FlowFieldStuckTime = 0.0f;
+	}
+
+	// the field steers toward the shared goal. Once we're about as close to it as our own goal is, head straight for our goal
+	const float GoalOffset = FVector::Dist2D(FlowField->Goal, FlowFieldGoal);
+	const float DistanceToFieldGoal = FVector::Dist2D(Location, FlowField->Goal);
+
+	FVector2D Direction;
+
+	if (DistanceToFieldGoal <= GoalOffset + FlowField->CellSize || !FlowField->Sample(Location, Direction))
+	{
+		Direction = FVector2D(FlowFieldGoal - Location).GetSafeNormal();
+	}
+
+	AddMovementInput(FVector(Direction, 0.0f));
+}
+
+void AStrategyUnit::FinishFlowFieldMove()
+{
+	FlowField.Reset();
+
+	// report the move as completed, same as a path following move
+	OnMoveCompleted.Broadcast(this);
+}
@@ -5,13 +5,18 @@
 #include "CoreMinimal.h"
 #include "GameFramework/Character.h"
 #include "AIController.h"
+#include "NavigationData.h"
 #include "StrategyUnit.generated.h"
 
 class USphereComponent;
+struct FStrategyFlowField;
 
 /** Delegate to report that this unit has finished moving */
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnUnitMoveCompletedDelegate, AStrategyUnit*, Unit);
 
+/** Delegate to report that this unit is leaving play */
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnUnitEndPlayDelegate, AStrategyUnit*);
+
 /**
  *  A simple strategy game unit
  *  Rather than react to inputs, it's controlled indirectly by the Strategy Player Controller
@@ -32,11 +37,40 @@ protected:
 	/** Cast reference to the AI Controlling this unit */
 	TObjectPtr<AAIController> AIController;
 
+	/** Flow field this unit is currently steering along, if any */
+	TSharedPtr<const FStrategyFlowField> FlowField;
+
+	/** Final goal while steering along a flow field */
+	FVector FlowFieldGoal;
+
+	/** Acceptance radius while steering along a flow field */
+	float FlowFieldAcceptanceRadius = 0.0f;
+
+	/** Time spent without making progress while steering along a flow field */
+	float FlowFieldStuckTime = 0.0f;
+
+	/** Give up on a flow field move after being stuck for this long */
+	UPROPERTY(EditAnywhere, Category="Flow Field", meta = (ClampMin = 0, ClampMax = 10, Units = "s"))
+	float FlowFieldStuckTimeout = 1.5f;
+
 public:
 
 	/** Constructor */
 	AStrategyUnit();
 
+protected:
+
+	/** Gameplay initialization */
+	virtual void BeginPlay() override;
+
+	/** Gameplay cleanup */
+	virtual void EndPlay(EEndPlayReason::Type EndPlayReason) override;
+
+public:
+
+	/** Steers along the flow field, if we have one */
+	virtual void Tick(float DeltaTime) override;
+
 protected:
 
 	virtual void NotifyControllerChanged() override;
@@ -58,11 +92,26 @@ public:
 	/** Attempts to move this unit to its */
 	bool MoveToLocation(const FVector& Location, float AcceptanceRadius);
 
+	/** Starts an async path query from this unit to the goal. Returns the query ID, or 0 if the query couldn't be started */
+	uint32 RequestPathAsync(const FVector& Goal, const FNavPathQueryDelegate& OnPathFound);
+
+	/** Moves this unit along a precomputed path. Returns true if the move was accepted */
+	bool FollowPath(FNavPathSharedPtr Path, float AcceptanceRadius);
+
+	/** Steers this unit along a shared flow field toward its goal. OnMoveCompleted is called when it arrives */
+	bool FollowFlowField(TSharedPtr<const FStrategyFlowField> Field, const FVector& Goal, float AcceptanceRadius);
+
 protected:
 
 	/** called by the AI controller when this unit has finished moving */
 	void OnMoveFinished(FAIRequestID RequestID, const FPathFollowingResult& Result);
 
+	/** Applies flow field steering for this frame and checks for arrival */
+	void UpdateFlowFieldMovement(float DeltaTime);
+
+	/** Ends flow field steering and reports the move as completed */
+	void FinishFlowFieldMove();
+
 protected:
 
 	/** Blueprint handler for strategy game selection */
@@ -80,4 +129,7 @@ protected:
 public:
 
 	FOnUnitMoveCompletedDelegate OnMoveCompleted;
+
+	/** Native notification that this unit is being destroyed or otherwise leaving play */
+	FOnUnitEndPlayDelegate OnUnitEndPlay;
 };
@@ -0,0 +1,260 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "StrategyFormation.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace StrategyFormationTests
+{
+	/** Total 2D distance travelled for an assignment, the cost AssignSlots minimizes */
+	static double AssignmentCost(const TArray<FVector>& Units, const TArray<FVector>& Slots, const TArray<int32>& Assignment)
+	{
+		double Cost = 0.0;
+
+		for (int32 UnitIndex = 0; UnitIndex < Units.Num(); ++UnitIndex)
+		{
+			Cost += FVector::Dist2D(Units[UnitIndex], Slots[Assignment[UnitIndex]]);
+		}
+
+		return Cost;
+	}
+
+	/** Cheapest assignment cost found by trying every way to give the units distinct slots */
+	static double BruteForceCost(const TArray<FVector>& Units, const TArray<FVector>& Slots, TArray<int32>& Assignment, TArray<bool>& SlotUsed, int32 UnitIndex)
+	{
+		if (UnitIndex == Units.Num())
+		{
+			return AssignmentCost(Units, Slots, Assignment);
+		}
+
+		double Best = TNumericLimits<double>::Max();
+
+		for (int32 SlotIndex = 0; SlotIndex < Slots.Num(); ++SlotIndex)
+		{
+			if (!SlotUsed[SlotIndex])
+			{
+				SlotUsed[SlotIndex] = true;
+				Assignment[UnitIndex] = SlotIndex;
+				Best = FMath::Min(Best, BruteForceCost(Units, Slots, Assignment, SlotUsed, UnitIndex + 1));
+				SlotUsed[SlotIndex] = false;
+			}
+		}
+
+		return Best;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FStrategyFormationAssignSlotsTest, "Project_TOKI.Strategy.Formation.AssignSlots", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FStrategyFormationAssignSlotsTest::RunTest(const FString& Parameters)
+{
+	using namespace StrategyFormationTests;
+
+	TArray<int32> Assignment;
+
+	// no units
+	FStrategyFormation::AssignSlots({}, { FVector::ZeroVector }, Assignment);
+	TestEqual(TEXT("No units get no assignment"), Assignment.Num(), 0);
+
+	// more units than slots leaves everyone unassigned
+	FStrategyFormation::AssignSlots({ FVector::ZeroVector, FVector(100.0f, 0.0f, 0.0f) }, { FVector::ZeroVector }, Assignment);
+	TestEqual(TEXT("Every unit has an entry when slots run out"), Assignment.Num(), 2);
+	TestEqual(TEXT("Unit 0 is unassigned when slots run out"), Assignment[0], INDEX_NONE);
+	TestEqual(TEXT("Unit 1 is unassigned when slots run out"), Assignment[1], INDEX_NONE);
+
+	// two units side by side, slots swapped in front of them. Crossing over would cost 2 * sqrt(1000^2 + 100^2)
+	{
+		const TArray<FVector> Units = { FVector(0.0f, 0.0f, 0.0f), FVector(1000.0f, 0.0f, 0.0f) };
+		const TArray<FVector> Slots = { FVector(1000.0f, 100.0f, 0.0f), FVector(0.0f, 100.0f, 0.0f) };
+
+		FStrategyFormation::AssignSlots(Units, Slots, Assignment);
+		TestEqual(TEXT("Unit 0 takes the slot in front of it"), Assignment[0], 1);
+		TestEqual(TEXT("Unit 1 takes the slot in front of it"), Assignment[1], 0);
+		TestEqual(TEXT("Paths don't cross"), AssignmentCost(Units, Slots, Assignment), 200.0, 0.01);
+	}
+
+	// nearest-first would give unit 0 the slot at 100 (cost 100 + 350 = 450), the optimum is 150 + 100 = 250
+	{
+		const TArray<FVector> Units = { FVector(200.0f, 0.0f, 0.0f), FVector(0.0f, 0.0f, 0.0f) };
+		const TArray<FVector> Slots = { FVector(100.0f, 0.0f, 0.0f), FVector(350.0f, 0.0f, 0.0f) };
+
+		FStrategyFormation::AssignSlots(Units, Slots, Assignment);
+		TestEqual(TEXT("Unit 0 gives up the nearest slot"), Assignment[0], 1);
+		TestEqual(TEXT("Unit 1 takes the nearest slot"), Assignment[1], 0);
+		TestEqual(TEXT("Beats the greedy assignment"), AssignmentCost(Units, Slots, Assignment), 250.0, 0.01);
+	}
+
+	// height is ignored, only the 2D distance counts
+	{
+		const TArray<FVector> Units = { FVector(0.0f, 0.0f, 500.0f) };
+		const TArray<FVector> Slots = { FVector(0.0f, 300.0f, 0.0f), FVector(100.0f, 0.0f, 0.0f) };
+
+		FStrategyFormation::AssignSlots(Units, Slots, Assignment);
+		TestEqual(TEXT("The slot that is nearer in 2D wins"), Assignment[0], 1);
+	}
+
+	// spare slots, checked against every possible assignment
+	{
+		FRandomStream Random(1234);
+
+		TArray<FVector> Units;
+		TArray<FVector> Slots;
+
+		for (int32 Index = 0; Index < 5; ++Index)
+		{
+			Units.Emplace(Random.FRandRange(-1000.0f, 1000.0f), Random.FRandRange(-1000.0f, 1000.0f), 0.0f);
+		}
+
+		for (int32 Index = 0; Index < 7; ++Index)
+		{
+			Slots.Emplace(Random.FRandRange(-1000.0f, 1000.0f), Random.FRandRange(-1000.0f, 1000.0f), 0.0f);
+		}
+
+		FStrategyFormation::AssignSlots(Units, Slots, Assignment);
+
+		TArray<int32> Sorted = Assignment;
+		Sorted.Sort();
+
+		for (int32 Index = 0; Index < Sorted.Num(); ++Index)
+		{
+			TestTrue(TEXT("Every unit gets a valid slot"), Slots.IsValidIndex(Sorted[Index]));
+			TestTrue(TEXT("No slot is shared"), Index == 0 || Sorted[Index] != Sorted[Index - 1]);
+		}
+
+		TArray<int32> Scratch;
+		TArray<bool> SlotUsed;
+		Scratch.Init(INDEX_NONE, Units.Num());
+		SlotUsed.Init(false, Slots.Num());
+
+		TestEqual(TEXT("Cost matches the brute force optimum"), AssignmentCost(Units, Slots, Assignment), BruteForceCost(Units, Slots, Scratch, SlotUsed, 0), 0.01);
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FStrategyFormationAssignSlotsSortedTest, "Project_TOKI.Strategy.Formation.AssignSlotsSorted", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FStrategyFormationAssignSlotsSortedTest::RunTest(const FString& Parameters)
+{
+	using namespace StrategyFormationTests;
+
+	TArray<int32> Assignment;
+
+	// degenerate inputs behave like the exact solve
+	FStrategyFormation::AssignSlotsSorted({}, { FVector::ZeroVector }, FVector::ForwardVector, Assignment);
+	TestEqual(TEXT("No units get no assignment"), Assignment.Num(), 0);
+
+	FStrategyFormation::AssignSlotsSorted({ FVector::ZeroVector, FVector(100.0f, 0.0f, 0.0f) }, { FVector::ZeroVector }, FVector::ForwardVector, Assignment);
+	TestEqual(TEXT("Every unit has an entry when slots run out"), Assignment.Num(), 2);
+	TestEqual(TEXT("Unit 0 is unassigned when slots run out"), Assignment[0], INDEX_NONE);
+	TestEqual(TEXT("Unit 1 is unassigned when slots run out"), Assignment[1], INDEX_NONE);
+
+	// a large grid moving straight ahead: every unit keeps its place, which is also the exact optimum
+	{
+		const int32 Count = 400;
+		const float Spacing = 100.0f;
+		const FVector Facing(0.0f, 1.0f, 0.0f);
+
+		TArray<FVector> Units;
+		TArray<FVector> Slots;
+		FStrategyFormation::ComputeSlots(SF_Grid, Count, Spacing, FVector::ZeroVector, Facing, Units);
+		FStrategyFormation::ComputeSlots(SF_Grid, Count, Spacing, FVector(0.0f, 5000.0f, 0.0f), Facing, Slots);
+
+		FStrategyFormation::AssignSlotsSorted(Units, Slots, Facing, Assignment);
+		TestEqual(TEXT("Every unit travels straight ahead"), AssignmentCost(Units, Slots, Assignment), Count * 5000.0, 0.1);
+	}
+
+	// a scattered large group with spare slots gets a valid one to one assignment
+	{
+		FRandomStream Random(4321);
+
+		TArray<FVector> Units;
+
+		for (int32 Index = 0; Index < 1000; ++Index)
+		{
+			Units.Emplace(Random.FRandRange(-5000.0f, 5000.0f), Random.FRandRange(-5000.0f, 5000.0f), 0.0f);
+		}
+
+		TArray<FVector> Slots;
+		FStrategyFormation::ComputeSlots(SF_Circle, 1100, 100.0f, FVector(8000.0f, 0.0f, 0.0f), FVector::ForwardVector, Slots);
+
+		FStrategyFormation::AssignSlotsSorted(Units, Slots, FVector::ForwardVector, Assignment);
+		TestEqual(TEXT("Every unit has an entry"), Assignment.Num(), Units.Num());
+
+		TArray<bool> SlotUsed;
+		SlotUsed.Init(false, Slots.Num());
+
+		for (int32 SlotIndex : Assignment)
+		{
+			if (!Slots.IsValidIndex(SlotIndex) || SlotUsed[SlotIndex])
+			{
+				AddError(FString::Printf(TEXT("Slot %d is invalid or shared"), SlotIndex));
+				break;
+			}
+
+			SlotUsed[SlotIndex] = true;
+		}
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FStrategyFormationComputeSlotsTest, "Project_TOKI.Strategy.Formation.ComputeSlots", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FStrategyFormationComputeSlotsTest::RunTest(const FString& Parameters)
+{
+	const FVector Goal(500.0f, -200.0f, 50.0f);
+	const float Spacing = 100.0f;
+
+	TArray<FVector> Slots;
+
+	for (EStrategyFormation Formation : { SF_Grid, SF_Wedge, SF_Circle })
+	{
+		const FString Name = StaticEnum<EStrategyFormation>()->GetNameStringByValue(Formation);
+
+		// no units, and stale slots from a previous order are cleared
+		Slots = { FVector::OneVector };
+		FStrategyFormation::ComputeSlots(Formation, 0, Spacing, Goal, FVector::ForwardVector, Slots);
+		TestEqual(FString::Printf(TEXT("%s: no slots for no units"), *Name), Slots.Num(), 0);
+
+		// a single unit goes straight to the goal, whatever the facing
+		FStrategyFormation::ComputeSlots(Formation, 1, Spacing, Goal, FVector::ZeroVector, Slots);
+		TestEqual(FString::Printf(TEXT("%s: one slot for one unit"), *Name), Slots.Num(), 1);
+
+		if (Slots.Num() == 1)
+		{
+			TestEqual(FString::Printf(TEXT("%s: the only slot is the goal"), *Name), Slots[0], Goal, 0.01f);
+		}
+
+		// one slot per unit, none of them stacked
+		for (int32 Count : { 2, 7, 50 })
+		{
+			FStrategyFormation::ComputeSlots(Formation, Count, Spacing, Goal, FVector(0.0f, 1.0f, 0.0f), Slots);
+			TestEqual(FString::Printf(TEXT("%s: one slot per unit for %d units"), *Name, Count), Slots.Num(), Count);
+
+			for (int32 First = 0; First < Slots.Num(); ++First)
+			{
+				for (int32 Second = First + 1; Second < Slots.Num(); ++Second)
+				{
+					if (FVector::Dist2D(Slots[First], Slots[Second]) < Spacing * 0.5f)
+					{
+						AddError(FString::Printf(TEXT("%s: slots %d and %d of %d overlap"), *Name, First, Second, Count));
+					}
+				}
+			}
+		}
+	}
+
+	// more units than one row holds: 5 units make a 3 wide grid, with the last 2 centered in the second row
+	FStrategyFormation::ComputeSlots(SF_Grid, 5, Spacing, FVector::ZeroVector, FVector::ForwardVector, Slots);
+	TestEqual(TEXT("Grid: first row, left"), Slots[0], FVector(0.0f, -100.0f, 0.0f), 0.01f);
+	TestEqual(TEXT("Grid: first row, right"), Slots[2], FVector(0.0f, 100.0f, 0.0f), 0.01f);
+	TestEqual(TEXT("Grid: second row, left"), Slots[3], FVector(-100.0f, -50.0f, 0.0f), 0.01f);
+	TestEqual(TEXT("Grid: second row, right"), Slots[4], FVector(-100.0f, 50.0f, 0.0f), 0.01f);
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -5,6 +5,8 @@
 #include "StrategyUnit.h"
 #include "StrategyPlayerController.h"
 #include "StrategyUI.h"
+#include "Camera/PlayerCameraManager.h"
+#include "Project_TOKISpatialGrid.h"
 
 void AStrategyHUD::BeginPlay()
 {
@@ -16,6 +18,14 @@ void AStrategyHUD::BeginPlay()
 
 	// add the UI widget to the screen
 	UIWidget->AddToViewport(0);
+
+	// update the UI only when the selection changes
+	if (AStrategyPlayerController* PC = Cast<AStrategyPlayerController>(GetOwningPlayerController()))
+	{
+		PC->OnSelectionChanged().AddUObject(this, &AStrategyHUD::OnSelectionChanged);
+
+		OnSelectionChanged(PC->GetSelectedUnits());
+	}
 }
 
 void AStrategyHUD::DragSelectUpdate(FVector2D Start, FVector2D WidthAndHeight, FVector2D CurrentPosition, bool bDraw)
@@ -26,6 +36,11 @@ void AStrategyHUD::DragSelectUpdate(FVector2D Start, FVector2D WidthAndHeight, F
 	BoxSize = WidthAndHeight;
 	BoxCurrentPosition = CurrentPosition;
 
+	// drop the cached projections once the drag ends
+	if (!bDraw)
+	{
+		ProjectionCache.Reset();
+	}
 }
 
 void AStrategyHUD::DrawHUD()
@@ -43,20 +58,14 @@ void AStrategyHUD::DrawHUD()
 
 			// get all the units in the selection box
 			TArray<AStrategyUnit*> BoxedUnits;
-			GetActorsInSelectionRectangle(BoxStart, BoxCurrentPosition, BoxedUnits, true);
+			GetUnitsInSelectionBox(PC, BoxedUnits);
 
 			// update the unit selection on the player controller
 			PC->DragSelectUnits(BoxedUnits);
 		}
 
-		// get the currently selected units
-		TArray<AStrategyUnit*> SelectedUnits = PC->GetSelectedUnits();
-
-		// update the selection count on the UI widget
-		UIWidget->SetSelectedUnitsCount(SelectedUnits.Num());
-
-		// process each selected unit
-		for (AStrategyUnit* CurrentUnit : SelectedUnits)
+		// process each selected unit. The set skips any destroyed units
+		for (AStrategyUnit* CurrentUnit : PC->GetSelectedUnits())
 		{
 			if (IsValid(CurrentUnit))
 			{
@@ -75,3 +84,101 @@ void AStrategyHUD::DrawHUD()
 	}
 
 }
+
+void AStrategyHUD::OnSelectionChanged(const FStrategySelectionSet& Selection)
+{
+	// update the selection count on the UI widget
+	UIWidget->SetSelectedUnitsCount(Selection.Num());
+}
+
+void AStrategyHUD::GetUnitsInSelectionBox(AStrategyPlayerController* PC, TArray<AStrategyUnit*>& OutUnits)
+{
+	UProject_TOKISpatialGrid* Grid = GetWorld()->GetSubsystem<UProject_TOKISpatialGrid>();
+
+	if (!Grid)
+	{
+		// no grid, so test every actor instead
+		GetActorsInSelectionRectangle(BoxStart, BoxCurrentPosition, OutUnits, true);
+		return;
+	}
+
+	const FBox2D ScreenBox(FVector2D::Min(BoxStart, BoxCurrentPosition), FVector2D::Max(BoxStart, BoxCurrentPosition));
+
+	// project the box corners onto the ground plane to bound the grid query
+	const FVector2D Corners[4] = {
+		ScreenBox.Min,
+		FVector2D(ScreenBox.Max.X, ScreenBox.Min.Y),
+		ScreenBox.Max,
+		FVector2D(ScreenBox.Min.X, ScreenBox.Max.Y)
+	};
+
+	FBox2D WorldBox(ForceInit);
+
+	for (const FVector2D& CurrentCorner : Corners)
+	{
+		FVector RayOrigin, RayDirection;
+
+		if (!PC->DeprojectScreenPositionToWorld(CurrentCorner.X, CurrentCorner.Y, RayOrigin, RayDirection) || FMath::IsNearlyZero(RayDirection.Z))
+		{
+			// the box can't be projected, so test every actor instead
+			GetActorsInSelectionRectangle(BoxStart, BoxCurrentPosition, OutUnits, true);
+			return;
+		}
+
+		const float RayDistance = (SelectionPlaneHeight - RayOrigin.Z) / RayDirection.Z;
+		WorldBox += FVector2D(RayOrigin + RayDirection * RayDistance);
+	}
+
+	TArray<AStrategyUnit*> Candidates;
+	Grid->QueryBox(WorldBox.ExpandBy(SelectionQueryMargin), Candidates);
+
+	// invalidate the projection cache if the camera moved
+	const FMinimalViewInfo& CameraView = PC->PlayerCameraManager->GetCameraCacheView();
+	const FTransform CameraTransform(CameraView.Rotation, CameraView.Location);
+
+	if (!CameraTransform.Equals(CachedCameraTransform) || CameraView.OrthoWidth != CachedOrthoWidth)
+	{
+		ProjectionCache.Reset();
+		CachedCameraTransform = CameraTransform;
+		CachedOrthoWidth = CameraView.OrthoWidth;
+	}
+
+	// test each candidate's screen bounds against the box, so partly boxed units are selected too
+	for (AStrategyUnit* CurrentUnit : Candidates)
+	{
+		const FVector UnitLocation = CurrentUnit->GetActorLocation();
+
+		FCachedProjection& Projection = ProjectionCache.FindOrAdd(CurrentUnit);
+
+		// only reproject new units or units that moved
+		if (!Projection.bValid || !Projection.WorldLocation.Equals(UnitLocation))
+		{
+			Projection.bValid = true;
+			Projection.WorldLocation = UnitLocation;
+			Projection.ScreenBounds = FBox2D(ForceInit);
+
+			// project the corners of the box around the unit's collision cylinder
+			float Radius, HalfHeight;
+			CurrentUnit->GetSimpleCollisionCylinder(Radius, HalfHeight);
+
+			for (int32 Corner = 0; Corner < 8; ++Corner)
+			{
+				const FVector CornerOffset((Corner & 1) ? Radius : -Radius, (Corner & 2) ? Radius : -Radius, (Corner & 4) ? HalfHeight : -HalfHeight);
+
+				FVector2D ScreenCorner;
+
+				if (PC->ProjectWorldLocationToScreen(UnitLocation + CornerOffset, ScreenCorner, true))
+				{
+					Projection.ScreenBounds += ScreenCorner;
+				}
+			}
+
+			Projection.bOnScreen = Projection.ScreenBounds.bIsValid;
+		}
+
+		if (Projection.bOnScreen && ScreenBox.Intersect(Projection.ScreenBounds))
+		{
+			OutUnits.Add(CurrentUnit);
+		}
+	}
+}
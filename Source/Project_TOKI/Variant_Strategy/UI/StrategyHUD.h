@@ -7,6 +7,9 @@
 #include "StrategyHUD.generated.h"
 
 class UStrategyUI;
+class FStrategySelectionSet;
+class AStrategyUnit;
+class AStrategyPlayerController;
 
 /**
  *  Simple strategy game HUD
@@ -42,6 +45,32 @@ protected:
 	UPROPERTY(EditAnywhere, Category="UI")
 	FLinearColor SelectionBoxColor;
 
+	/** Height of the ground plane the selection box and the camera footprint are projected onto when querying for units */
+	UPROPERTY(EditAnywhere, Category="UI", meta = (Units = "cm"))
+	float SelectionPlaneHeight = 0.0f;
+
+	/** Extra distance added around the projected selection box or camera footprint, to catch units above or below the ground plane */
+	UPROPERTY(EditAnywhere, Category="UI", meta = (ClampMin = 0, ClampMax = 2000, Units = "cm"))
+	float SelectionQueryMargin = 200.0f;
+
+	/** Screen bounds of a unit's collision cylinder, reused while neither the unit nor the camera moves */
+	struct FCachedProjection
+	{
+		FVector WorldLocation = FVector::ZeroVector;
+		FBox2D ScreenBounds = FBox2D(ForceInit);
+		bool bOnScreen = false;
+		bool bValid = false;
+	};
+
+	/** Cached unit screen projections for the active drag box */
+	TMap<TWeakObjectPtr<AStrategyUnit>, FCachedProjection> ProjectionCache;
+
+	/** Camera transform the projection cache was built with */
+	FTransform CachedCameraTransform;
+
+	/** Ortho width the projection cache was built with */
+	float CachedOrthoWidth = 0.0f;
+
 public:
 
 	/** Initialization */
@@ -50,8 +79,20 @@ public:
 	/** Updates the drag selection box */
 	void DragSelectUpdate(FVector2D Start, FVector2D WidthAndHeight, FVector2D CurrentPosition, bool bDraw);
 
+	/** Returns the height of the ground plane used for selection queries */
+	float GetSelectionPlaneHeight() const { return SelectionPlaneHeight; }
+
+	/** Returns the margin added around projected selection areas */
+	float GetSelectionQueryMargin() const { return SelectionQueryMargin; }
+
 protected:
 
 	/** Draws the HUD */
 	virtual void DrawHUD() override;
+
+	/** Finds the units at least partly inside the drag box using the spatial grid and the projection cache */
+	void GetUnitsInSelectionBox(AStrategyPlayerController* PC, TArray<AStrategyUnit*>& OutUnits);
+
+	/** Updates the UI when the player controller's selection changes */
+	void OnSelectionChanged(const FStrategySelectionSet& Selection);
 };
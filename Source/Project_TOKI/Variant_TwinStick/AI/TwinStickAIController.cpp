@@ -16,4 +16,17 @@ ATwinStickAIController::ATwinStickAIController()
 	// ensure we're attached to the possessed character.
 	// this is necessary for EnvQueries to work correctly
 	bAttachToPawn = true;
-}
\ No newline at end of file
+}
+
+void ATwinStickAIController::StopStateTree()
+{
+	// stop movement and the StateTree
+	StopMovement();
+	StateTreeAI->StopLogic(TEXT("Parked"));
+}
+
+void ATwinStickAIController::RestartStateTree()
+{
+	// restart the StateTree so it reads the reset NPC state
+	StateTreeAI->RestartLogic();
+}
@@ -25,4 +25,10 @@ public:
 
 	/** Constructor */
 	ATwinStickAIController();
+
+	/** Stops the StateTree while the possessed NPC is parked in a pool */
+	void StopStateTree();
+
+	/** Restarts the StateTree from its root state when the possessed NPC is reused */
+	void RestartStateTree();
 };
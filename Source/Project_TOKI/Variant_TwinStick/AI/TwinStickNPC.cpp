@@ -11,6 +11,10 @@
 #include "Engine/World.h"
 #include "TwinStickNPCDestruction.h"
 #include "TimerManager.h"
+#include "Project_TOKISpatialGrid.h"
+#include "TwinStickSpawner.h"
+#include "TwinStickAIController.h"
+#include "Project_TOKI.h"
 
 ATwinStickNPC::ATwinStickNPC()
 {
@@ -43,28 +47,34 @@ void ATwinStickNPC::BeginPlay()
 {
 	Super::BeginPlay();
 
-	// increment the NPC counter so we can cap spawning if necessary
-	if (ATwinStickGameMode* GM = Cast<ATwinStickGameMode>(GetWorld()->GetAuthGameMode()))
-	{
-		GM->IncreaseNPCs();
-	}
-
+	// count ourselves as a live NPC
+	RegisterLiveNPC();
 }
 
 void ATwinStickNPC::EndPlay(EEndPlayReason::Type EndPlayReason)
 {
 	Super::EndPlay(EndPlayReason);
 
+	// remove ourselves from the spatial grid
+	if (UProject_TOKISpatialGrid* Grid = GetWorld()->GetSubsystem<UProject_TOKISpatialGrid>())
+	{
+		Grid->UnregisterActor(this);
+	}
+
 	// clear the destruction timer
 	GetWorld()->GetTimerManager().ClearTimer(DestructionTimer);
 }
 
 void ATwinStickNPC::Destroyed()
 {
-	// decrease the NPC counter so we can cap spawning if necessary
-	if (ATwinStickGameMode* GM = Cast<ATwinStickGameMode>(GetWorld()->GetAuthGameMode()))
+	// decrease the NPC counter so we can cap spawning if necessary.
+	// Parked NPCs were already removed from the count
+	if (!bParked)
 	{
-		GM->DecreaseNPCs();
+		if (ATwinStickGameMode* GM = Cast<ATwinStickGameMode>(GetWorld()->GetAuthGameMode()))
+		{
+			GM->DecreaseNPCs();
+		}
 	}
 
 	Super::Destroyed();
@@ -119,8 +129,113 @@ void ATwinStickNPC::ProjectileImpact(const FVector& ForwardVector)
 	GetWorld()->GetTimerManager().SetTimer(DestructionTimer, this, &ATwinStickNPC::DeferredDestroy, DeferredDestructionTime, false);
 }
 
+void ATwinStickNPC::SetOwningSpawner(ATwinStickSpawner* Spawner)
+{
+	OwningSpawner = Spawner;
+}
+
+bool ATwinStickNPC::ActivateNPC(const FTransform& SpawnTransform)
+{
+	// move to the spawn location, adjusting for any encroachment
+	if (!TeleportTo(SpawnTransform.GetLocation(), SpawnTransform.Rotator()))
+	{
+		// the spot is blocked, so stay parked rather than come back to life where we were left
+		UE_LOG(LogProject_TOKI, Warning, TEXT("'%s' could not teleport to %s, leaving it parked"), *GetNameSafe(this), *SpawnTransform.GetLocation().ToString());
+		return false;
+	}
+
+	// clear the hit flag
+	bHit = false;
+	bParked = false;
+
+	// show the actor and re-enable collision
+	SetActorHiddenInGame(false);
+	SetActorEnableCollision(true);
+	SetActorTickEnabled(true);
+
+	// reactivate character movement
+	GetCharacterMovement()->StopMovementImmediately();
+	GetCharacterMovement()->Activate(true);
+	GetCharacterMovement()->SetMovementMode(MOVE_Walking);
+
+	// count ourselves as a live NPC again
+	RegisterLiveNPC();
+
+	// restart the StateTree so it starts from a clean state
+	if (ATwinStickAIController* AIController = Cast<ATwinStickAIController>(GetController()))
+	{
+		AIController->RestartStateTree();
+	}
+
+	return true;
+}
+
+void ATwinStickNPC::ParkNPC()
+{
+	// stop the StateTree and any pending moves
+	if (ATwinStickAIController* AIController = Cast<ATwinStickAIController>(GetController()))
+	{
+		AIController->StopStateTree();
+	}
+
+	// clear the destruction timer in case we were parked early
+	GetWorld()->GetTimerManager().ClearTimer(DestructionTimer);
+
+	// make sure we're out of play
+	GetCharacterMovement()->StopMovementImmediately();
+	GetCharacterMovement()->Deactivate();
+
+	SetActorHiddenInGame(true);
+	SetActorEnableCollision(false);
+	SetActorTickEnabled(false);
+
+	// stop counting as a live NPC
+	UnregisterLiveNPC();
+
+	bParked = true;
+}
+
 void ATwinStickNPC::DeferredDestroy()
 {
+	// return to the spawner's pool if possible
+	if (ATwinStickSpawner* Spawner = OwningSpawner.Get())
+	{
+		if (Spawner->ReleaseNPC(this))
+		{
+			return;
+		}
+	}
+
 	// destroy this actor
 	Destroy();
 }
+
+void ATwinStickNPC::RegisterLiveNPC()
+{
+	// increment the NPC counter so we can cap spawning if necessary
+	if (ATwinStickGameMode* GM = Cast<ATwinStickGameMode>(GetWorld()->GetAuthGameMode()))
+	{
+		GM->IncreaseNPCs();
+	}
+
+	// add ourselves to the spatial grid so AoE attacks can find us
+	if (UProject_TOKISpatialGrid* Grid = GetWorld()->GetSubsystem<UProject_TOKISpatialGrid>())
+	{
+		Grid->RegisterActor(this);
+	}
+}
+
+void ATwinStickNPC::UnregisterLiveNPC()
+{
+	// decrease the NPC counter so we can cap spawning if necessary
+	if (ATwinStickGameMode* GM = Cast<ATwinStickGameMode>(GetWorld()->GetAuthGameMode()))
+	{
+		GM->DecreaseNPCs();
+	}
+
+	// remove ourselves from the spatial grid
+	if (UProject_TOKISpatialGrid* Grid = GetWorld()->GetSubsystem<UProject_TOKISpatialGrid>())
+	{
+		Grid->UnregisterActor(this);
+	}
+}
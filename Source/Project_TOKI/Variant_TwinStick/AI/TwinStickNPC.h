@@ -8,6 +8,7 @@
 
 class ATwinStickPickup;
 class ATwinStickNPCDestruction;
+class ATwinStickSpawner;
 
 /**
  *  A simple enemy NPC for a Twin Stick Shooter game
@@ -44,6 +45,12 @@ protected:
 	/** Deferred destruction timer */
 	FTimerHandle DestructionTimer;
 
+	/** Spawner that will take this NPC back for reuse instead of destroying it */
+	TWeakObjectPtr<ATwinStickSpawner> OwningSpawner;
+
+	/** If true, this NPC is parked in its spawner's pool and isn't counted as live */
+	bool bParked = false;
+
 public:
 
 	/** If true, this NPC has already been hit by a projectile and is being destroyed. Exposed to BP so it can be read by StateTree */
@@ -74,8 +81,26 @@ public:
 	/** Tells the NPC to process a projectile impact */
 	void ProjectileImpact(const FVector& ForwardVector);
 
+	/** Sets the spawner that pools this NPC */
+	void SetOwningSpawner(ATwinStickSpawner* Spawner);
+
+	/** Resets a parked NPC and brings it back into play at the given transform. Returns false and stays parked if it can't be moved there */
+	bool ActivateNPC(const FTransform& SpawnTransform);
+
+	/** Removes this NPC from play so it can be reused later */
+	void ParkNPC();
+
+	/** Returns true if this NPC is parked in a pool */
+	bool IsParked() const { return bParked; }
+
 protected:
 
-	/** Called from timer to complete the destruction process for this NPC */
+	/** Called from timer to complete the destruction process for this NPC. Returns it to its spawner's pool if possible */
 	void DeferredDestroy();
+
+	/** Adds this NPC to the live count and the spatial grid */
+	void RegisterLiveNPC();
+
+	/** Removes this NPC from the live count and the spatial grid */
+	void UnregisterLiveNPC();
 };
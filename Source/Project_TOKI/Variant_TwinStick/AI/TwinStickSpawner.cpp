@@ -47,6 +47,20 @@ void ATwinStickSpawner::EndPlay(EEndPlayReason::Type EndPlayReason)
 	// clear the spawn timers
 	GetWorld()->GetTimerManager().ClearTimer(SpawnGroupTimer);
 	GetWorld()->GetTimerManager().ClearTimer(SpawnNPCTimer);
+
+	// destroy any parked NPCs if we're being removed mid-game
+	if (EndPlayReason == EEndPlayReason::Destroyed)
+	{
+		for (ATwinStickNPC* CurrentNPC : ParkedNPCs)
+		{
+			if (IsValid(CurrentNPC))
+			{
+				CurrentNPC->Destroy();
+			}
+		}
+	}
+
+	ParkedNPCs.Empty();
 }
 
 void ATwinStickSpawner::SpawnNPCGroup()
@@ -74,8 +88,37 @@ void ATwinStickSpawner::SpawnNPC()
 	{
 		SpawnTransform.SetLocation(SpawnLoc);
 
-		// spawn the NPC
-		ATwinStickNPC* NPC = GetWorld()->SpawnActor<ATwinStickNPC>(NPCClass, SpawnTransform);
+		// reuse a parked NPC if we have one
+		ATwinStickNPC* NPC = nullptr;
+
+		while (!NPC && ParkedNPCs.Num() > 0)
+		{
+			NPC = ParkedNPCs.Pop(EAllowShrinking::No);
+
+			if (!IsValid(NPC))
+			{
+				NPC = nullptr;
+			}
+		}
+
+		if (NPC)
+		{
+			// put it back in the pool if it couldn't be placed
+			if (!NPC->ActivateNPC(SpawnTransform))
+			{
+				ParkedNPCs.Push(NPC);
+			}
+
+		} else {
+
+			// spawn a new NPC
+			NPC = GetWorld()->SpawnActor<ATwinStickNPC>(NPCClass, SpawnTransform);
+
+			if (NPC)
+			{
+				NPC->SetOwningSpawner(this);
+			}
+		}
 	}
 
 	// increase the spawn counter
@@ -88,3 +131,18 @@ void ATwinStickSpawner::SpawnNPC()
 	}
 
 }
+
+bool ATwinStickSpawner::ReleaseNPC(ATwinStickNPC* NPC)
+{
+	// is the pool full?
+	if (!IsValid(NPC) || ParkedNPCs.Num() >= NPCPoolSize)
+	{
+		return false;
+	}
+
+	// park the NPC and save it for later
+	NPC->ParkNPC();
+	ParkedNPCs.Add(NPC);
+
+	return true;
+}
@@ -42,6 +42,14 @@ protected:
 	/** Number of NPCs to spawn per group */
 	UPROPERTY(EditAnywhere, Category="NPC Spawner", meta = (ClampMin = 0, ClampMax = 10))
 	int32 SpawnGroupSize = 3;
+
+	/** Max number of dead NPCs to keep parked for reuse. Extra NPCs are destroyed */
+	UPROPERTY(EditAnywhere, Category="NPC Spawner", meta = (ClampMin = 0, ClampMax = 1000))
+	int32 NPCPoolSize = 20;
+
+	/** Dead NPCs waiting to be reused */
+	UPROPERTY()
+	TArray<TObjectPtr<ATwinStickNPC>> ParkedNPCs;
 	
 	/** Number of NPCs spawned in the current group */
 	int32 SpawnCount = 0;
@@ -76,4 +84,9 @@ protected:
 	/** Spawns an individual NPC */
 	void SpawnNPC();
 
+public:
+
+	/** Parks a dead NPC so it can be reused. Returns false if the pool is full and the NPC should be destroyed instead */
+	bool ReleaseNPC(ATwinStickNPC* NPC);
+
 };
@@ -8,6 +8,7 @@
 #include "Engine/World.h"
 #include "TimerManager.h"
 #include "TwinStickNPC.h"
+#include "Project_TOKISpatialGrid.h"
 
 ATwinStickAoEAttack::ATwinStickAoEAttack()
 {
@@ -55,9 +56,19 @@ void ATwinStickAoEAttack::EndPlay(EEndPlayReason::Type EndPlayReason)
 
 void ATwinStickAoEAttack::TickAoE()
 {
-	// find all actors overlapping the NPC
+	// find all NPCs inside the AoE
 	TArray<AActor*> Overlaps;
-	CollisionSphere->GetOverlappingActors(Overlaps, ATwinStickNPC::StaticClass());
+
+	if (UProject_TOKISpatialGrid* Grid = GetWorld()->GetSubsystem<UProject_TOKISpatialGrid>())
+	{
+		// query the spatial grid so we don't have to go through the physics scene
+		Grid->QueryRadius(CollisionSphere->GetComponentLocation(), CollisionSphere->GetScaledSphereRadius(), ATwinStickNPC::StaticClass(), Overlaps);
+
+	} else {
+
+		// no grid, so fall back to the sphere overlaps
+		CollisionSphere->GetOverlappingActors(Overlaps, ATwinStickNPC::StaticClass());
+	}
 
 	// process each overlapping actor
 	for (AActor* Current : Overlaps)
@@ -6,12 +6,13 @@
 #include "GameFramework/ProjectileMovementComponent.h"
 #include "Components/StaticMeshComponent.h"
 #include "TwinStickNPC.h"
+#include "TwinStickProjectilePool.h"
 
 ATwinStickProjectile::ATwinStickProjectile()
 {
  	PrimaryActorTick.bCanEverTick = true;
 
-	// this actor will be destroyed automatically once InitialLifeSpan expires
+	// this actor will be destroyed or returned to its pool once InitialLifeSpan expires
 	InitialLifeSpan = 2.0f;
 
 	// create the collision sphere and set it as the root component
@@ -53,13 +54,82 @@ void ATwinStickProjectile::NotifyHit(class UPrimitiveComponent* MyComp, AActor*
 		// tell the NPC it's been hit
 		NPC->ProjectileImpact(FVector::ZeroVector);
 
-		// destroy this projectile
-		Destroy();
+		// destroy or recycle this projectile
+		FinishProjectile();
 	}
 }
 
+void ATwinStickProjectile::LifeSpanExpired()
+{
+	// pooled projectiles are recycled instead of destroyed
+	FinishProjectile();
+}
+
 void ATwinStickProjectile::OnProjectileStop(const FHitResult& ImpactResult)
 {
-	// destroy this actor immediately
+	// destroy or recycle this projectile immediately
+	FinishProjectile();
+}
+
+void ATwinStickProjectile::FinishProjectile()
+{
+	// ignore repeated requests while parked
+	if (bParked)
+	{
+		return;
+	}
+
+	// return to the pool if we have one
+	if (UTwinStickProjectilePool* Pool = OwningPool.Get())
+	{
+		Pool->ReleaseProjectile(this);
+		return;
+	}
+
+	// destroy this actor
 	Destroy();
 }
+
+void ATwinStickProjectile::SetOwningPool(UTwinStickProjectilePool* Pool)
+{
+	OwningPool = Pool;
+}
+
+void ATwinStickProjectile::ActivateProjectile(const FTransform& LaunchTransform)
+{
+	bParked = false;
+
+	// move to the launch transform
+	SetActorLocationAndRotation(LaunchTransform.GetLocation(), LaunchTransform.GetRotation(), false, nullptr, ETeleportType::ResetPhysics);
+
+	// unhide and reenable collision
+	SetActorHiddenInGame(false);
+	CollisionSphere->SetCollisionEnabled(ECollisionEnabled::QueryOnly);
+
+	// the projectile movement clears its updated component when it stops, so restore it
+	ProjectileMovement->SetUpdatedComponent(CollisionSphere);
+
+	// relaunch at the initial speed along the new facing
+	ProjectileMovement->Velocity = LaunchTransform.GetRotation().GetForwardVector() * ProjectileMovement->InitialSpeed;
+	ProjectileMovement->Activate(true);
+	ProjectileMovement->UpdateComponentVelocity();
+
+	// restart the life span timer
+	SetLifeSpan(InitialLifeSpan);
+}
+
+void ATwinStickProjectile::DeactivateProjectile()
+{
+	bParked = true;
+
+	// stop the life span timer
+	SetLifeSpan(0.0f);
+
+	// stop and deactivate movement
+	ProjectileMovement->StopMovementImmediately();
+	ProjectileMovement->Deactivate();
+
+	// disable collision and hide
+	CollisionSphere->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	SetActorHiddenInGame(true);
+}
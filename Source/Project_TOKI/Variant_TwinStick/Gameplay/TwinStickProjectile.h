@@ -9,6 +9,7 @@
 class USphereComponent;
 class UStaticMeshComponent;
 class UProjectileMovementComponent;
+class UTwinStickProjectilePool;
 
 /**
  *  A simple bouncing projectile for a Twin Stick shooter game
@@ -30,6 +31,14 @@ class ATwinStickProjectile : public AActor
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components", meta = (AllowPrivateAccess = "true"))
 	UProjectileMovementComponent* ProjectileMovement;
 
+protected:
+
+	/** Pool that owns this projectile. If set, the projectile is parked instead of destroyed */
+	TWeakObjectPtr<UTwinStickProjectilePool> OwningPool;
+
+	/** If true, this projectile is parked in the pool */
+	bool bParked = false;
+
 public:	
 
 	/** Constructor */
@@ -39,9 +48,28 @@ public:
 	virtual void NotifyHit(class UPrimitiveComponent* MyComp, AActor* Other, class UPrimitiveComponent* OtherComp, bool bSelfMoved, FVector HitLocation, FVector HitNormal, FVector NormalImpulse, const FHitResult& Hit) override;
 
 protected:
+
+	/** Returns the projectile to its pool when its life span runs out */
+	virtual void LifeSpanExpired() override;
 	
 	/** Handles collisions that stop this projectile from moving */
 	UFUNCTION()
 	void OnProjectileStop(const FHitResult& ImpactResult);
 
+	/** Returns this projectile to its pool, or destroys it if it isn't pooled */
+	void FinishProjectile();
+
+public:
+
+	/** Sets the pool this projectile should be returned to */
+	void SetOwningPool(UTwinStickProjectilePool* Pool);
+
+	/** Reactivates a parked projectile and launches it from the given transform */
+	void ActivateProjectile(const FTransform& LaunchTransform);
+
+	/** Stops, hides and disables collision on this projectile so it can be parked */
+	void DeactivateProjectile();
+
+	/** Returns true if this projectile is parked in the pool */
+	bool IsParked() const { return bParked; }
 };
@@ -0,0 +1,174 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "TwinStickProjectileBatch.h"
+#include "Components/SceneComponent.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "TwinStickNPC.h"
+#include "Project_TOKI.h"
+
+ATwinStickProjectileBatch::ATwinStickProjectileBatch()
+{
+ 	PrimaryActorTick.bCanEverTick = true;
+
+	// step after movement so projectiles see this frame's NPC positions
+	PrimaryActorTick.TickGroup = TG_PostPhysics;
+
+	// create the root component
+	RootComponent = CreateDefaultSubobject<USceneComponent>(TEXT("Root"));
+
+	// create the instanced mesh. Projectiles don't need collision or shadows
+	ProjectileInstances = CreateDefaultSubobject<UInstancedStaticMeshComponent>(TEXT("Projectile Instances"));
+	ProjectileInstances->SetupAttachment(RootComponent);
+
+	ProjectileInstances->SetCollisionProfileName(FName("NoCollision"));
+	ProjectileInstances->SetCastShadow(false);
+}
+
+void ATwinStickProjectileBatch::BeginPlay()
+{
+	Super::BeginPlay();
+
+	// copy the tunables into the simulation
+	Simulation.Radius = Radius;
+	Simulation.Bounciness = Bounciness;
+	Simulation.Friction = Friction;
+	Simulation.CollisionChannel = CollisionChannel;
+	Simulation.bParallel = bParallelSimulation;
+	Simulation.TargetClass = ATwinStickNPC::StaticClass();
+
+	Simulation.Reserve(MaxProjectiles);
+}
+
+void ATwinStickProjectileBatch::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	// step all projectiles
+	StepHits.Reset();
+	Simulation.Step(GetWorld(), DeltaTime, StepHits);
+
+	// process the hits on the game thread
+	for (const TPair<AActor*, FVector>& CurrentHit : StepHits)
+	{
+		if (ATwinStickNPC* NPC = Cast<ATwinStickNPC>(CurrentHit.Key))
+		{
+			// tell the NPC it's been hit
+			NPC->ProjectileImpact(CurrentHit.Value.GetSafeNormal());
+		}
+	}
+
+	// update the visuals
+	UpdateInstances();
+}
+
+void ATwinStickProjectileBatch::FireProjectile(const FTransform& LaunchTransform)
+{
+	// are we at the projectile cap?
+	if (Simulation.Num() >= MaxProjectiles)
+	{
+		return;
+	}
+
+	Simulation.Add(LaunchTransform.GetLocation(), LaunchTransform.GetRotation().GetForwardVector() * InitialSpeed, ProjectileLifeSpan);
+}
+
+void ATwinStickProjectileBatch::SetIgnoredActor(AActor* Actor)
+{
+	Simulation.IgnoredActor = Actor;
+}
+
+void ATwinStickProjectileBatch::UpdateInstances()
+{
+	const int32 Count = Simulation.Num();
+
+	// build the instance transforms, facing the direction of travel
+	InstanceTransforms.Reset(Count);
+
+	for (int32 Index = 0; Index < Count; ++Index)
+	{
+		InstanceTransforms.Emplace(Simulation.Velocities[Index].Rotation(), Simulation.Locations[Index]);
+	}
+
+	// trim any instances for projectiles that were removed
+	const int32 InstanceCount = ProjectileInstances->GetInstanceCount();
+
+	if (InstanceCount > Count)
+	{
+		TArray<int32> RemovedInstances;
+		RemovedInstances.Reserve(InstanceCount - Count);
+
+		for (int32 Index = Count; Index < InstanceCount; ++Index)
+		{
+			RemovedInstances.Add(Index);
+		}
+
+		ProjectileInstances->RemoveInstances(RemovedInstances);
+	}
+
+	// update the existing instances
+	const int32 Updated = FMath::Min(InstanceCount, Count);
+
+	if (Updated > 0)
+	{
+		ProjectileInstances->BatchUpdateInstancesTransforms(0, TArrayView<const FTransform>(InstanceTransforms.GetData(), Updated), true, true, true);
+	}
+
+	// add instances for new projectiles
+	if (Count > InstanceCount)
+	{
+		TArray<FTransform> NewInstances(InstanceTransforms.GetData() + InstanceCount, Count - InstanceCount);
+		ProjectileInstances->AddInstances(NewInstances, false, true, false);
+	}
+}
+
+/** Headless benchmark: steps a large batch of projectiles and reports the cost per frame */
+static FAutoConsoleCommandWithWorldAndArgs GTwinStickProjectileBenchmarkCmd(
+	TEXT("TwinStick.ProjectileBenchmark"),
+	TEXT("Simulates a batch of projectiles and logs ms/frame. Usage: TwinStick.ProjectileBenchmark [Count=10000] [Frames=120] [Parallel=1]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		if (!World)
+		{
+			return;
+		}
+
+		const int32 Count = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 10000;
+		const int32 Frames = Args.Num() > 1 ? FMath::Max(1, FCString::Atoi(*Args[1])) : 120;
+		const bool bParallel = Args.Num() > 2 ? FCString::Atoi(*Args[2]) != 0 : true;
+		const float DeltaTime = 1.0f / 60.0f;
+
+		// set up the simulation with projectiles fanned out in a ring around the origin
+		FTwinStickProjectileSimulation Simulation;
+		Simulation.bParallel = bParallel;
+		Simulation.TargetClass = ATwinStickNPC::StaticClass();
+		Simulation.Reserve(Count);
+
+		FRandomStream Stream(Count);
+
+		for (int32 Index = 0; Index < Count; ++Index)
+		{
+			const FVector Direction = FRotator(0.0f, Stream.FRandRange(0.0f, 360.0f), 0.0f).Vector();
+			Simulation.Add(FVector(0.0f, 0.0f, 100.0f) + Direction * Stream.FRandRange(0.0f, 500.0f), Direction * 2000.0f, Frames * DeltaTime + 1.0f);
+		}
+
+		// step the simulation and time it
+		TArray<TPair<AActor*, FVector>> Hits;
+
+		const double StartTime = FPlatformTime::Seconds();
+
+		for (int32 Frame = 0; Frame < Frames; ++Frame)
+		{
+			Hits.Reset();
+			Simulation.Step(World, DeltaTime, Hits);
+		}
+
+		const double ElapsedMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+		UE_LOG(LogProject_TOKI, Display, TEXT("TwinStick.ProjectileBenchmark: %d projectiles, %d frames, %s: %.3f ms/frame (%d still alive)"),
+			Count, Frames, bParallel ? TEXT("parallel") : TEXT("serial"), ElapsedMs / Frames, Simulation.Num());
+	})
+);
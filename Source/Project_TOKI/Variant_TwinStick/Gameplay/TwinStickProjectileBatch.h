@@ -0,0 +1,98 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "TwinStickProjectileSimulation.h"
+#include "TwinStickProjectileBatch.generated.h"
+
+class UInstancedStaticMeshComponent;
+
+/**
+ *  Batched projectile manager for a Twin Stick Shooter game.
+ *  Simulates all of its projectiles in a single struct-of-arrays step
+ *  and renders them through one instanced static mesh.
+ *  Projectiles that hit NPCs are routed to ATwinStickNPC::ProjectileImpact.
+ */
+UCLASS(abstract)
+class ATwinStickProjectileBatch : public AActor
+{
+	GENERATED_BODY()
+
+	/** Renders every projectile in the batch */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Components", meta = (AllowPrivateAccess = "true"))
+	UInstancedStaticMeshComponent* ProjectileInstances;
+
+protected:
+
+	/** Launch speed for new projectiles */
+	UPROPERTY(EditAnywhere, Category="Projectile", meta = (ClampMin = 0, ClampMax = 15000, Units = "cm/s"))
+	float InitialSpeed = 2000.0f;
+
+	/** Time each projectile is simulated before it's removed */
+	UPROPERTY(EditAnywhere, Category="Projectile", meta = (ClampMin = 0, ClampMax = 10, Units = "s"))
+	float ProjectileLifeSpan = 2.0f;
+
+	/** Collision radius for each projectile */
+	UPROPERTY(EditAnywhere, Category="Projectile", meta = (ClampMin = 0, ClampMax = 200, Units = "cm"))
+	float Radius = 35.0f;
+
+	/** Velocity retained along the hit normal after a bounce */
+	UPROPERTY(EditAnywhere, Category="Projectile", meta = (ClampMin = 0, ClampMax = 1))
+	float Bounciness = 0.6f;
+
+	/** Velocity lost tangent to the hit normal after a bounce */
+	UPROPERTY(EditAnywhere, Category="Projectile", meta = (ClampMin = 0, ClampMax = 1))
+	float Friction = 0.2f;
+
+	/** Trace channel used to sweep projectiles */
+	UPROPERTY(EditAnywhere, Category="Projectile")
+	TEnumAsByte<ECollisionChannel> CollisionChannel = ECC_WorldDynamic;
+
+	/** If true, projectiles are stepped with a ParallelFor */
+	UPROPERTY(EditAnywhere, Category="Projectile")
+	bool bParallelSimulation = true;
+
+	/** Max number of live projectiles. New projectiles are dropped past this */
+	UPROPERTY(EditAnywhere, Category="Projectile", meta = (ClampMin = 0, ClampMax = 100000))
+	int32 MaxProjectiles = 10000;
+
+	/** Projectile simulation state */
+	FTwinStickProjectileSimulation Simulation;
+
+	/** Scratch list of hits gathered during a step */
+	TArray<TPair<AActor*, FVector>> StepHits;
+
+	/** Scratch list of instance transforms */
+	TArray<FTransform> InstanceTransforms;
+
+public:
+
+	/** Constructor */
+	ATwinStickProjectileBatch();
+
+protected:
+
+	/** Gameplay initialization */
+	virtual void BeginPlay() override;
+
+public:
+
+	/** Steps the simulation and updates the instances */
+	virtual void Tick(float DeltaTime) override;
+
+	/** Launches a new projectile from the given transform */
+	void FireProjectile(const FTransform& LaunchTransform);
+
+	/** Sets an actor that projectiles should pass through, usually the shooter */
+	void SetIgnoredActor(AActor* Actor);
+
+	/** Returns the number of live projectiles */
+	int32 GetNumProjectiles() const { return Simulation.Num(); }
+
+protected:
+
+	/** Copies the projectile state into the instanced mesh */
+	void UpdateInstances();
+};
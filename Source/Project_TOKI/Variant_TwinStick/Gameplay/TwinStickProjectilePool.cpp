@@ -0,0 +1,135 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "TwinStickProjectilePool.h"
+#include "TwinStickProjectile.h"
+#include "Engine/World.h"
+
+void UTwinStickProjectilePool::Prewarm(TSubclassOf<ATwinStickProjectile> ProjectileClass, int32 PoolSize)
+{
+	if (!ProjectileClass)
+	{
+		return;
+	}
+
+	FTwinStickProjectilePoolBucket& Bucket = Buckets.FindOrAdd(ProjectileClass);
+
+	// grow the capacity so released projectiles are kept around
+	Bucket.Capacity = FMath::Max(Bucket.Capacity, PoolSize);
+
+	// spawn and park projectiles until we reach the requested size
+	while (Bucket.Inactive.Num() < PoolSize)
+	{
+		ATwinStickProjectile* Projectile = SpawnPooledProjectile(ProjectileClass, FTransform::Identity);
+
+		if (!Projectile)
+		{
+			break;
+		}
+
+		Projectile->DeactivateProjectile();
+		Bucket.Inactive.Add(Projectile);
+	}
+}
+
+ATwinStickProjectile* UTwinStickProjectilePool::AcquireProjectile(TSubclassOf<ATwinStickProjectile> ProjectileClass, const FTransform& SpawnTransform)
+{
+	if (!ProjectileClass)
+	{
+		return nullptr;
+	}
+
+	ATwinStickProjectile* Projectile = nullptr;
+
+	// try to reuse a parked projectile first
+	if (FTwinStickProjectilePoolBucket* Bucket = Buckets.Find(ProjectileClass))
+	{
+		while (!Projectile && Bucket->Inactive.Num() > 0)
+		{
+			// skip over any projectiles that were destroyed externally
+			ATwinStickProjectile* Candidate = Bucket->Inactive.Pop(EAllowShrinking::No);
+
+			if (IsValid(Candidate))
+			{
+				Projectile = Candidate;
+			}
+		}
+	}
+
+	if (Projectile)
+	{
+		++Stats.Hits;
+
+		Projectile->ActivateProjectile(SpawnTransform);
+
+	} else {
+
+		++Stats.Misses;
+
+		// the pool is empty, so spawn a fresh projectile. It starts active
+		Projectile = SpawnPooledProjectile(ProjectileClass, SpawnTransform);
+
+		if (!Projectile)
+		{
+			return nullptr;
+		}
+	}
+
+	// update the usage counters
+	++Stats.Active;
+	Stats.PeakActive = FMath::Max(Stats.PeakActive, Stats.Active);
+
+	return Projectile;
+}
+
+void UTwinStickProjectilePool::ReleaseProjectile(ATwinStickProjectile* Projectile)
+{
+	if (!IsValid(Projectile))
+	{
+		return;
+	}
+
+	Stats.Active = FMath::Max(Stats.Active - 1, 0);
+
+	FTwinStickProjectilePoolBucket& Bucket = Buckets.FindOrAdd(Projectile->GetClass());
+
+	// is the pool already full?
+	if (Bucket.Inactive.Num() >= Bucket.Capacity)
+	{
+		Projectile->Destroy();
+		return;
+	}
+
+	// park the projectile
+	Projectile->DeactivateProjectile();
+	Bucket.Inactive.Add(Projectile);
+}
+
+void UTwinStickProjectilePool::ResetPoolStats()
+{
+	// keep the active count, it reflects projectiles that are still in flight
+	Stats.Hits = 0;
+	Stats.Misses = 0;
+	Stats.PeakActive = Stats.Active;
+}
+
+bool UTwinStickProjectilePool::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+ATwinStickProjectile* UTwinStickProjectilePool::SpawnPooledProjectile(TSubclassOf<ATwinStickProjectile> ProjectileClass, const FTransform& SpawnTransform)
+{
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+	ATwinStickProjectile* Projectile = GetWorld()->SpawnActor<ATwinStickProjectile>(ProjectileClass, SpawnTransform, SpawnParams);
+
+	if (Projectile)
+	{
+		// let the projectile know it should come back to us instead of being destroyed
+		Projectile->SetOwningPool(this);
+	}
+
+	return Projectile;
+}
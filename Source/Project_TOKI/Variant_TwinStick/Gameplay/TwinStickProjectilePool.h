@@ -0,0 +1,97 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Templates/SubclassOf.h"
+#include "TwinStickProjectilePool.generated.h"
+
+class ATwinStickProjectile;
+
+/**
+ *  Usage counters for the projectile pool
+ */
+USTRUCT(BlueprintType)
+struct FTwinStickProjectilePoolStats
+{
+	GENERATED_BODY()
+
+	/** Number of projectile requests served by a parked projectile */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Pool")
+	int32 Hits = 0;
+
+	/** Number of projectile requests that had to spawn a new actor */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Pool")
+	int32 Misses = 0;
+
+	/** Number of projectiles currently in flight */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Pool")
+	int32 Active = 0;
+
+	/** Highest number of projectiles in flight at the same time */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Pool")
+	int32 PeakActive = 0;
+};
+
+/**
+ *  Parked projectiles of a single class
+ */
+USTRUCT()
+struct FTwinStickProjectilePoolBucket
+{
+	GENERATED_BODY()
+
+	/** Inactive projectiles ready to be reused */
+	UPROPERTY()
+	TArray<TObjectPtr<ATwinStickProjectile>> Inactive;
+
+	/** Max number of inactive projectiles to keep around. Projectiles released past this are destroyed */
+	int32 Capacity = 0;
+};
+
+/**
+ *  World subsystem that pre-warms and recycles projectiles for a Twin Stick Shooter game.
+ *  Projectiles are parked with their collision and movement deactivated instead of being destroyed.
+ */
+UCLASS()
+class UTwinStickProjectilePool : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+protected:
+
+	/** Parked projectiles, grouped by class */
+	UPROPERTY()
+	TMap<TSubclassOf<ATwinStickProjectile>, FTwinStickProjectilePoolBucket> Buckets;
+
+	/** Usage counters */
+	FTwinStickProjectilePoolStats Stats;
+
+public:
+
+	/** Spawns and parks projectiles until the pool for the given class holds at least PoolSize of them */
+	void Prewarm(TSubclassOf<ATwinStickProjectile> ProjectileClass, int32 PoolSize);
+
+	/** Launches a projectile at the given transform, reusing a parked one if possible */
+	ATwinStickProjectile* AcquireProjectile(TSubclassOf<ATwinStickProjectile> ProjectileClass, const FTransform& SpawnTransform);
+
+	/** Deactivates and parks a projectile so it can be reused */
+	void ReleaseProjectile(ATwinStickProjectile* Projectile);
+
+	/** Returns the pool usage counters */
+	UFUNCTION(BlueprintPure, Category="Projectile Pool")
+	FTwinStickProjectilePoolStats GetPoolStats() const { return Stats; }
+
+	/** Resets the hit, miss and peak counters */
+	UFUNCTION(BlueprintCallable, Category="Projectile Pool")
+	void ResetPoolStats();
+
+protected:
+
+	/** Only create the pool for game worlds */
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	/** Spawns a new projectile owned by this pool */
+	ATwinStickProjectile* SpawnPooledProjectile(TSubclassOf<ATwinStickProjectile> ProjectileClass, const FTransform& SpawnTransform);
+};
@@ -0,0 +1,125 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "TwinStickProjectileSimulation.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "Async/ParallelFor.h"
+#include "CollisionQueryParams.h"
+
+void FTwinStickProjectileSimulation::Reserve(int32 Count)
+{
+	Locations.Reserve(Count);
+	Velocities.Reserve(Count);
+	LifeTimes.Reserve(Count);
+	StepHitActors.Reserve(Count);
+	StepRemoved.Reserve(Count);
+}
+
+void FTwinStickProjectileSimulation::Add(const FVector& Location, const FVector& Velocity, float LifeTime)
+{
+	Locations.Add(Location);
+	Velocities.Add(Velocity);
+	LifeTimes.Add(LifeTime);
+}
+
+void FTwinStickProjectileSimulation::Reset()
+{
+	Locations.Reset();
+	Velocities.Reset();
+	LifeTimes.Reset();
+}
+
+void FTwinStickProjectileSimulation::Step(UWorld* World, float DeltaTime, TArray<TPair<AActor*, FVector>>& OutHits)
+{
+	const int32 Count = Num();
+
+	if (Count == 0 || !World)
+	{
+		return;
+	}
+
+	// reset the per-step scratch arrays
+	StepHitActors.Reset();
+	StepHitActors.SetNumZeroed(Count);
+	StepRemoved.Reset();
+	StepRemoved.SetNumZeroed(Count);
+
+	// set up the shared query data
+	FCollisionShape Sphere;
+	Sphere.SetSphere(Radius);
+
+	FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(TwinStickProjectileSweep), false, IgnoredActor.Get());
+
+	// move every projectile. Each iteration only touches its own index so this is safe to run in parallel
+	ParallelFor(Count, [&](int32 Index)
+	{
+		// tick down the life time
+		LifeTimes[Index] -= DeltaTime;
+
+		if (LifeTimes[Index] <= 0.0f)
+		{
+			StepRemoved[Index] = 1;
+			return;
+		}
+
+		const FVector Start = Locations[Index];
+		const FVector End = Start + Velocities[Index] * DeltaTime;
+
+		FHitResult Hit;
+		if (!World->SweepSingleByChannel(Hit, Start, End, FQuat::Identity, CollisionChannel, Sphere, QueryParams))
+		{
+			// nothing in the way
+			Locations[Index] = End;
+			return;
+		}
+
+		// have we hit a target?
+		AActor* HitActor = Hit.GetActor();
+
+		if (HitActor && TargetClass && HitActor->IsA(TargetClass))
+		{
+			StepHitActors[Index] = HitActor;
+			StepRemoved[Index] = 1;
+			return;
+		}
+
+		// bounce off the surface
+		const FVector Normal = Hit.ImpactNormal;
+		const FVector NormalVelocity = Normal * FVector::DotProduct(Velocities[Index], Normal);
+		const FVector TangentVelocity = Velocities[Index] - NormalVelocity;
+
+		Locations[Index] = Hit.Location;
+		Velocities[Index] = TangentVelocity * (1.0f - Friction) - NormalVelocity * Bounciness;
+
+		// stop if the bounce took away too much speed
+		if (Velocities[Index].SizeSquared() < FMath::Square(StopSpeed))
+		{
+			StepRemoved[Index] = 1;
+		}
+
+	}, !bParallel);
+
+	// gather hits and remove finished projectiles. Walk backwards so swaps don't skip entries
+	for (int32 Index = Count - 1; Index >= 0; --Index)
+	{
+		if (StepRemoved[Index] == 0)
+		{
+			continue;
+		}
+
+		if (AActor* HitActor = StepHitActors[Index])
+		{
+			OutHits.Emplace(HitActor, Velocities[Index]);
+		}
+
+		RemoveAtSwap(Index);
+	}
+}
+
+void FTwinStickProjectileSimulation::RemoveAtSwap(int32 Index)
+{
+	Locations.RemoveAtSwap(Index, EAllowShrinking::No);
+	Velocities.RemoveAtSwap(Index, EAllowShrinking::No);
+	LifeTimes.RemoveAtSwap(Index, EAllowShrinking::No);
+}
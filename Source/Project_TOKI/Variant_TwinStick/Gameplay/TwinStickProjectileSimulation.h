@@ -0,0 +1,81 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/EngineTypes.h"
+
+class UWorld;
+class UClass;
+class AActor;
+
+/**
+ *  Struct-of-arrays simulation for large numbers of simple bouncing projectiles.
+ *  Each step moves every projectile with a swept sphere query and reports the actors they hit.
+ *  Has no rendering or actor dependencies so it can be driven headless.
+ */
+struct FTwinStickProjectileSimulation
+{
+	/** Current projectile locations */
+	TArray<FVector> Locations;
+
+	/** Current projectile velocities */
+	TArray<FVector> Velocities;
+
+	/** Remaining life time of each projectile */
+	TArray<float> LifeTimes;
+
+	/** Per-step scratch: target actor hit by each projectile this step */
+	TArray<AActor*> StepHitActors;
+
+	/** Per-step scratch: non-zero for projectiles that finished this step */
+	TArray<uint8> StepRemoved;
+
+	/** Collision radius for all projectiles */
+	float Radius = 35.0f;
+
+	/** Velocity retained along the hit normal after a bounce */
+	float Bounciness = 0.6f;
+
+	/** Velocity lost tangent to the hit normal after a bounce */
+	float Friction = 0.2f;
+
+	/** Projectiles slower than this after a bounce are removed */
+	float StopSpeed = 5.0f;
+
+	/** Channel used for the swept sphere queries */
+	ECollisionChannel CollisionChannel = ECC_WorldDynamic;
+
+	/** If true, projectiles are stepped in parallel */
+	bool bParallel = true;
+
+	/** Actors of this class stop projectiles and are reported as hits. Everything else is bounced off */
+	UClass* TargetClass = nullptr;
+
+	/** Actor to ignore in the sweeps */
+	TWeakObjectPtr<AActor> IgnoredActor;
+
+	/** Returns the number of live projectiles */
+	int32 Num() const { return Locations.Num(); }
+
+	/** Reserves memory for the given number of projectiles */
+	void Reserve(int32 Count);
+
+	/** Adds a new projectile */
+	void Add(const FVector& Location, const FVector& Velocity, float LifeTime);
+
+	/** Removes all projectiles */
+	void Reset();
+
+	/**
+	 *  Moves every projectile forward by DeltaTime.
+	 *  Expired or stopped projectiles are removed and actors hit this step are appended to OutHits,
+	 *  paired with the velocity of the projectile that hit them.
+	 */
+	void Step(UWorld* World, float DeltaTime, TArray<TPair<AActor*, FVector>>& OutHits);
+
+protected:
+
+	/** Removes a projectile by swapping in the last one */
+	void RemoveAtSwap(int32 Index);
+};
@@ -11,6 +11,8 @@
 #include "TwinStickAoEAttack.h"
 #include "Kismet/KismetMathLibrary.h"
 #include "TwinStickProjectile.h"
+#include "TwinStickProjectilePool.h"
+#include "TwinStickProjectileBatch.h"
 #include "Engine/World.h"
 #include "TimerManager.h"
 
@@ -52,6 +54,23 @@ void ATwinStickCharacter::BeginPlay()
 	
 	// update the items count
 	UpdateItems();
+
+	// spawn the batched projectile manager if we're using one
+	if (ProjectileBatchClass)
+	{
+		ProjectileBatch = GetWorld()->SpawnActor<ATwinStickProjectileBatch>(ProjectileBatchClass, FTransform::Identity);
+
+		if (ProjectileBatch)
+		{
+			// don't let our own shots hit us
+			ProjectileBatch->SetIgnoredActor(this);
+		}
+
+	} else if (UTwinStickProjectilePool* ProjectilePool = GetWorld()->GetSubsystem<UTwinStickProjectilePool>())
+	{
+		// pre-warm the projectile pool so shooting doesn't spawn actors
+		ProjectilePool->Prewarm(ProjectileClass, ProjectilePoolSize);
+	}
 }
 
 void ATwinStickCharacter::EndPlay(EEndPlayReason::Type EndPlayReason)
@@ -60,6 +79,13 @@ void ATwinStickCharacter::EndPlay(EEndPlayReason::Type EndPlayReason)
 
 	/** Clear the autofire timer */
 	GetWorld()->GetTimerManager().ClearTimer(AutoFireTimer);
+
+	// destroy the batched projectile manager
+	if (IsValid(ProjectileBatch))
+	{
+		ProjectileBatch->Destroy();
+		ProjectileBatch = nullptr;
+	}
 }
 
 void ATwinStickCharacter::NotifyControllerChanged()
@@ -242,7 +268,20 @@ void ATwinStickCharacter::DoShoot()
 	FVector ProjectileLocation = ProjectileTransform.GetLocation() + ProjectileTransform.GetRotation().RotateVector(FVector::ForwardVector * ProjectileOffset);
 	ProjectileTransform.SetLocation(ProjectileLocation);
 
-	ATwinStickProjectile* Projectile = GetWorld()->SpawnActor<ATwinStickProjectile>(ProjectileClass, ProjectileTransform);
+	// are we using the batched projectile manager? It may have been destroyed by level streaming or teardown
+	if (IsValid(ProjectileBatch))
+	{
+		ProjectileBatch->FireProjectile(ProjectileTransform);
+
+	} else if (UTwinStickProjectilePool* ProjectilePool = GetWorld()->GetSubsystem<UTwinStickProjectilePool>())
+	{
+		// launch a pooled projectile
+		ProjectilePool->AcquireProjectile(ProjectileClass, ProjectileTransform);
+
+	} else {
+
+		GetWorld()->SpawnActor<ATwinStickProjectile>(ProjectileClass, ProjectileTransform);
+	}
 }
 
 void ATwinStickCharacter::DoAoEAttack()
@@ -14,6 +14,7 @@ class APlayerController;
 class UInputAction;
 class ATwinStickAoEAttack;
 class ATwinStickProjectile;
+class ATwinStickProjectileBatch;
 
 /**
  *  A player-controlled character for a Twin Stick Shooter game
@@ -75,6 +76,18 @@ protected:
 	UPROPERTY(EditAnywhere, Category="Projectile", meta = (ClampMin = 0, ClampMax = 1000, Units = "cm"))
 	float ProjectileOffset = 100.0f;
 
+	/** Number of projectiles to pre-warm and keep parked in the projectile pool */
+	UPROPERTY(EditAnywhere, Category="Projectile", meta = (ClampMin = 0, ClampMax = 500))
+	int32 ProjectilePoolSize = 32;
+
+	/** If set, shots are simulated by a batched projectile manager of this type instead of individual projectile actors */
+	UPROPERTY(EditAnywhere, Category="Projectile")
+	TSubclassOf<ATwinStickProjectileBatch> ProjectileBatchClass;
+
+	/** Batched projectile manager spawned for this character. Referenced so GC clears it if the batch is destroyed elsewhere */
+	UPROPERTY(Transient)
+	TObjectPtr<ATwinStickProjectileBatch> ProjectileBatch;
+
 	/** Type of AoE attack actor to spawn */
 	UPROPERTY(EditAnywhere, Category="AoE")
 	TSubclassOf<ATwinStickAoEAttack> AoEAttackClass;